@@ -76,6 +76,14 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
 /* USER CODE END MESSAGE_BUFFER_LENGTH_TYPE */
 
+/* Software timer definitions. */
+/* 定时器服务任务同时执行 WF5803F 异步采集状态机 (xTimerPendFunctionCallFromISR)，
+   优先级高于采集任务，保证 I2C 完成中断后及时启动下一步传输 */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 4 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             256
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                    0
 #define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
@@ -87,9 +95,10 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelete                  1
 #define INCLUDE_vTaskCleanUpResources        0
 #define INCLUDE_vTaskSuspend                 1
-#define INCLUDE_vTaskDelayUntil              0
+#define INCLUDE_vTaskDelayUntil              1
 #define INCLUDE_vTaskDelay                   1
 #define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_xTimerPendFunctionCall       1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -134,6 +143,7 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#define INCLUDE_xTaskGetCurrentTaskHandle    1   // i2c_bus.c: 判断是否在定时器服务任务中提交
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
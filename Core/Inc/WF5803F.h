@@ -1,7 +1,11 @@
+#ifndef __WF5803F_H
+#define __WF5803F_H
+
 #include "i2c.h"
 #include "cmsis_os.h"
 #include "FreeRTOS.h"
 #include "math.h"
+#include "wf5803f_conv.h"
 
 
 
@@ -11,11 +15,101 @@
 #define WF5803F_REG_STATUS    0x02        // 状态寄存器
 #define WF5803F_REG_PRESS_MSB 0x06        // 气压数据 MSB
 #define WF5803F_REG_TEMP_MSB  0x09        // 温度数据 MSB
+#define WF5803F_REG_P_CONFIG  0xA6        // 气压配置寄存器 (bit[2:0] 过采样率)
+
+// 异步采集时序
+#define WF5803F_CONV_DELAY_MS 5           // 启动转换后首次查询 DRDY 的延时
+#define WF5803F_POLL_MS       2           // DRDY 未置位时的重查间隔
+#define WF5803F_TIMEOUT_MS    100         // 一次采集 (启动到读出数据) 的超时，覆盖最高过采样率
+#define WF5803F_ODR_MAX       15          // sleep_time 最大编码 (1s)
+#define WF5803F_ODR_STEP_US   62500       // sleep_time 每级 62.5ms
+
+/**
+ * @brief 转换模式
+ */
+typedef enum {
+    WF5803F_MODE_SINGLE = 0,  // 每次采集触发一次转换
+    WF5803F_MODE_CONTINUOUS   // 传感器按 sleep_time 周期转换，采集时只读结果
+} WF5803F_Mode_t;
+
+/**
+ * @brief 气压过采样率 (P_CONFIG bit[2:0] 编码)，越高噪声越低、转换越慢
+ */
+typedef enum {
+    WF5803F_OSR_1024X = 0,
+    WF5803F_OSR_2048X,
+    WF5803F_OSR_4096X,
+    WF5803F_OSR_8192X,
+    WF5803F_OSR_256X,
+    WF5803F_OSR_512X,
+    WF5803F_OSR_16384X,
+    WF5803F_OSR_32768X
+} WF5803F_Osr_t;
+
+/**
+ * @brief 采集配置
+ */
+typedef struct {
+    WF5803F_Mode_t mode;
+    uint8_t odr;            // 连续模式 sleep_time 编码 0~15 (0: 转换完立即开始下一次)
+    WF5803F_Osr_t osr;      // 气压过采样率
+} WF5803F_Config_t;
+
+/**
+ * @brief 采集结果
+ */
+typedef enum {
+    WF5803F_OK = 0,
+    WF5803F_ERR_BUSY,       // 上一次采集尚未结束
+    WF5803F_ERR_BUS,        // I2C 传输出错 (NACK/仲裁丢失/总线错误)
+    WF5803F_ERR_TIMEOUT,    // 超时 (DRDY 未置位或传输无响应)
+    WF5803F_ERR_PARAM       // 配置参数超出范围
+} WF5803F_Result_t;
+
+/**
+ * @brief 一次采集的数据
+ */
+typedef struct {
+    float temperature;      // 温度 (℃)，由 temp_centi 换算
+    float pressure;         // 气压 (kPa)，由 pressure_pa 换算
+    int32_t temp_centi;     // 温度 (0.01℃，定点换算)
+    int32_t pressure_pa;    // 气压 (Pa，定点换算，量程型号见 wf5803f_conv.h)
+    int16_t raw_temp;       // 原始温度
+    int32_t raw_press;      // 原始气压 (24位)
+    uint32_t tick;          // 完成时刻 (ms)
+    uint64_t time;          // 完成时刻 (DwtTime_Now，CPU 周期)
+    uint32_t cycles;        // 启动采集到完成的 CPU 周期数 (I2C 传输 + DRDY 等待)
+    WF5803F_Result_t result;
+} WF5803F_Sample_t;
+
+/**
+ * @brief 采集统计
+ */
+typedef struct {
+    uint32_t started;       // 启动的采集次数
+    uint32_t completed;     // 成功完成次数
+    uint32_t busy;          // 因上一次未结束被拒绝的次数
+    uint32_t bus_errors;    // I2C 错误次数
+    uint32_t timeouts;      // 超时次数
+    uint32_t drdy_retries;  // DRDY 未置位重查次数
+} WF5803F_Stats_t;
+
+/**
+ * @brief 采集完成回调 (在 FreeRTOS 定时器服务任务中调用，不可阻塞)
+ */
+typedef void (*WF5803F_Callback_t)(const WF5803F_Sample_t *sample);
 
 // 函数声明
 // void WF5803F_ReadDate_Temp(int16_t* Temp);
 // void WF5803F_ReadDate_Press(int32_t* Press);
-void WF5803F_ReadDate(int16_t* Temp, int32_t* Press);
-float compute_pressure_WF5803F_2BAR_fromInt(int32_t rawData);
-float compute_temperature_WF5803F_fromInt(int16_t rawData);
-void WF5803F_GetData(float* temperature, float* pressure);
\ No newline at end of file
+WF5803F_Result_t WF5803F_GetData(float* temperature, float* pressure);
+
+void WF5803F_Init(WF5803F_Callback_t callback);
+WF5803F_Result_t WF5803F_Configure(const WF5803F_Config_t *config);
+void WF5803F_GetConfig(WF5803F_Config_t *config);
+WF5803F_Result_t WF5803F_StartConversion(void);
+WF5803F_Result_t WF5803F_WaitSample(WF5803F_Sample_t *sample, uint32_t timeout_ms);
+WF5803F_Result_t WF5803F_PollSample(WF5803F_Sample_t *sample);
+void WF5803F_GetStats(WF5803F_Stats_t *stats);
+
+#endif /* __WF5803F_H */
@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file           : adc_scan.h
+  * @brief          : Header for adc_scan.c file.
+  *                   ADC1 定时器触发扫描 + DMA 循环采样
+  ******************************************************************************
+  * @attention
+  *
+  * TIM2 更新事件 (TRGO) 以 ADC_SCAN_RATE_HZ 触发 ADC1 规则组扫描，每次扫描依次转换
+  * AdcScan_Channel_t 中的各通道 (规则组顺序见 MX_ADC1_Init)，DMA2 Stream0 以循环模式
+  * 写入 ADC_SCAN_DEPTH 次扫描的缓冲区。CPU 不参与采样:
+  * - AdcScan_Latest: 由 DMA 剩余计数定位最近一次完整扫描，读一个半字
+  * - AdcScan_Average: 缓冲区中该通道 ADC_SCAN_DEPTH 个采样的平均值
+  * 两者都只读 DMA 缓冲区，不加锁，可在任意任务中调用 (也可在调度器启动前调用)。
+  *
+  * 过采样: DMA 半传输/传输完成中断把刚写完的半个缓冲区累加到每个通道的累加器 (adc_scan_ovs.c)，
+  * 每 ADC_SCAN_OVS_N 个采样 (boxcar 抽取) 输出一个 12 + ADC_SCAN_OVS_BITS 位的结果:
+  * 和右移 ADC_SCAN_OVS_BITS 位，满量程 ADC_SCAN_OVS_MAX。N = 4^BITS，需要输入噪声
+  * 大于 1 LSB 才能得到有效的额外位。AdcScan_Oversampled 读取最近一次输出 (单字读写，不加锁)。
+  *
+  * 新增通道: 在 AdcScan_Channel_t (adc_scan_ovs.h) 中加一项，并在 MX_ADC1_Init 中按相同顺序加一个 Rank。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __ADC_SCAN_H
+#define __ADC_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "adc.h"
+#include "adc_scan_ovs.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define ADC_SCAN_RATE_HZ        1000    // 扫描频率 (TIM2 触发)
+#define ADC_SCAN_EMPTY          0xFFFFU // 尚未写入的采样 (12 位 ADC 不会出现)
+#define ADC_SCAN_FILL_MS        (ADC_SCAN_DEPTH * 1000U / ADC_SCAN_RATE_HZ + 1U)   // 填满一轮缓冲区的时间
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  配置 TIM2 触发并启动 ADC1 循环 DMA 采样
+ * @retval None
+ * @note   在 MX_ADC1_Init 之后调用；缓冲区填满一轮需要 ADC_SCAN_FILL_MS
+ */
+void AdcScan_Start(void);
+
+/**
+ * @brief  最近一次完整扫描中该通道的采样值
+ * @param  ch: 通道
+ * @retval ADC 值 (0 ~ 4095)，尚无采样时返回 0
+ */
+uint16_t AdcScan_Latest(AdcScan_Channel_t ch);
+
+/**
+ * @brief  缓冲区中该通道采样的平均值 (最近 ADC_SCAN_DEPTH 次扫描)
+ * @param  ch: 通道
+ * @retval ADC 值 (0 ~ 4095)，尚无采样时返回 0
+ */
+uint16_t AdcScan_Average(AdcScan_Channel_t ch);
+
+/**
+ * @brief  最近一次过采样抽取结果
+ * @param  ch: 通道
+ * @param  seq: 输出该结果的序号 (每 ADC_SCAN_OVS_N 个采样加 1，0 表示尚无结果)，可为 NULL
+ * @retval 0 ~ ADC_SCAN_OVS_MAX，尚无结果时为 0
+ * @note   第一个结果在 AdcScan_Start 之后 ADC_SCAN_OVS_N 个扫描周期产生
+ */
+uint32_t AdcScan_Oversampled(AdcScan_Channel_t ch, uint32_t *seq);
+
+/**
+ * @brief  最近一次过采样抽取的时刻
+ * @retval DwtTime_Now 时间戳 (CPU 周期)，尚无结果时为 0
+ * @note   抽取在最后一个扫描完成后的 DMA 中断中进行，各采样的平均时刻比它早约
+ *         ADC_SCAN_OVS_N / 2 个扫描周期
+ */
+uint64_t AdcScan_OversampledTime(void);
+
+/**
+ * @brief  DMA 传输完成的半缓冲区数 (采样是否在运行)
+ * @retval 计数
+ */
+uint32_t AdcScan_GetBlocks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ADC_SCAN_H */
@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file           : adc_scan_ovs.h
+  * @brief          : Header for adc_scan_ovs.c file.
+  *                   ADC 扫描缓冲区布局与过采样累加 (boxcar 抽取)
+  ******************************************************************************
+  * @attention
+  *
+  * 此文件不依赖 HAL，固件 (adc_scan.c 的 DMA 中断) 与上位机 (Host/tools/adc_ovs_bench)
+  * 共用同一份累加代码。
+  *
+  * DMA 缓冲区按 [扫描][通道] 交织存放，每次半传输/传输完成中断交给 AdcScan_OvsAccumulate
+  * 半个缓冲区 (ADC_SCAN_DEPTH / 2 次扫描)，每通道逐个累加；满 ADC_SCAN_OVS_N 个采样时
+  * 输出 和 >> ADC_SCAN_OVS_BITS 并清零。
+  * 不用 CMSIS-DSP 的 arm_mean_q15: 它先除以个数再截断，丢掉了过采样要保留的额外位。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __ADC_SCAN_OVS_H
+#define __ADC_SCAN_OVS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define ADC_SCAN_DEPTH          16      // 缓冲区保存的扫描次数 (平均窗口)
+#define ADC_SCAN_OVS_BITS       4       // 过采样额外位数 (12 位 -> 16 位)
+#define ADC_SCAN_OVS_N          (1U << (2U * ADC_SCAN_OVS_BITS))    // 每个输出的采样数 (256，1kHz 下 256ms)
+#define ADC_SCAN_OVS_MAX        (4095U << ADC_SCAN_OVS_BITS)        // 过采样结果满量程
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 扫描通道 (顺序与 ADC1 规则组 Rank 一致)
+ */
+typedef enum {
+    ADC_SCAN_NTC1 = 0,                  // ADC1_IN0 (PA0)，NTC1 分压
+    ADC_SCAN_NTC2,                      // ADC1_IN1 (PA1)，NTC2 分压
+    ADC_SCAN_NTC3,                      // ADC1_IN2 (PA2)，NTC3 分压
+    ADC_SCAN_NTC4,                      // ADC1_IN3 (PA3)，NTC4 分压
+    ADC_SCAN_VDET,                      // ADC1_IN14 (PC4)，电源电压分压
+    ADC_SCAN_CHANNELS
+} AdcScan_Channel_t;
+
+/**
+ * @brief 过采样累加状态
+ */
+typedef struct {
+    uint32_t acc[ADC_SCAN_CHANNELS];    // 当前抽取周期的累加和
+    uint32_t count;                     // 当前抽取周期已累加的扫描数
+} AdcScan_Ovs_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  清零累加状态
+ * @param  ovs: 累加状态
+ * @retval None
+ */
+void AdcScan_OvsReset(AdcScan_Ovs_t *ovs);
+
+/**
+ * @brief  累加半个缓冲区的扫描，满 ADC_SCAN_OVS_N 个采样时输出抽取结果
+ * @param  ovs: 累加状态
+ * @param  scan: 半个缓冲区 (ADC_SCAN_DEPTH / 2 次扫描 × ADC_SCAN_CHANNELS)
+ * @param  out: 抽取结果，ADC_SCAN_CHANNELS 项 (只在返回 1 时写入)
+ * @retval 1: 本次输出了抽取结果，0: 尚未满 ADC_SCAN_OVS_N
+ */
+int AdcScan_OvsAccumulate(AdcScan_Ovs_t *ovs, const volatile uint16_t *scan, volatile uint32_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ADC_SCAN_OVS_H */
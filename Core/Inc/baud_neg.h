@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file           : baud_neg.h
+  * @brief          : Header for baud_neg.c file.
+  *                   USART2 波特率协商
+  ******************************************************************************
+  * @attention
+  *
+  * 协商流程 (上位机工具 tlm_ingest --negotiate 实现了上位机一侧):
+  *   1. 上位机以当前波特率发送 "baud <新波特率>"
+  *   2. 设备以当前波特率回复应答，待发送缓冲区排空后切换到新波特率
+  *   3. 设备每 BAUDNEG_PROBE_INTERVAL_MS 发送一帧 TLM_FRAME_TYPE_PROBE
+  *   4. 上位机收到校验正确的探测帧后，以新波特率发送 "baud ok"
+  *   5. BAUDNEG_CONFIRM_TIMEOUT_MS 内未收到确认，设备自动恢复原波特率 (通知 status 为 "timeout")；
+ *      发送缓冲区一直排不空时暂停发送强制恢复，可能丢弃正在发送的一段 (status 为 "forced")
+  *
+  * 确认后的波特率保持到复位为止。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __BAUD_NEG_H
+#define __BAUD_NEG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define BAUDNEG_PROBE_INTERVAL_MS     100     // 探测帧发送间隔
+#define BAUDNEG_CONFIRM_TIMEOUT_MS    1000    // 等待上位机确认的超时
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 协商状态
+ */
+typedef enum {
+    BAUDNEG_IDLE = 0,       // 未在协商
+    BAUDNEG_SWITCH,         // 已应答，等待切换
+    BAUDNEG_PROBE           // 已切换，发送探测帧等待确认
+} BaudNeg_State_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  发起协商 (在 "baud <rate>" 命令中调用)
+ * @param  baud: 新波特率
+ * @retval 0: 已受理，-1: 波特率不可用，-2: 正在协商
+ * @note   实际切换在下一次 BaudNeg_Poll 中进行，保证应答先以原波特率发出
+ */
+int BaudNeg_Start(uint32_t baud);
+
+/**
+ * @brief  上位机确认新波特率 (在 "baud ok" 命令中调用)
+ * @retval 0: 已确认，-1: 当前不在等待确认
+ */
+int BaudNeg_Confirm(void);
+
+/**
+ * @brief  推进协商状态机，在 USART 接收任务中周期调用
+ * @retval None
+ */
+void BaudNeg_Poll(void);
+
+/**
+ * @brief  接收任务下一次等待数据的最长时间
+ * @retval 系统节拍数，未在协商时为 portMAX_DELAY
+ */
+uint32_t BaudNeg_WaitTicks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BAUD_NEG_H */
@@ -0,0 +1,163 @@
+/**
+  ******************************************************************************
+  * @file           : cmd_parser.h
+  * @brief          : Header for cmd_parser.c file.
+  *                   行命令协议解析 (表驱动)
+  ******************************************************************************
+  * @attention
+  *
+  * 此文件不依赖 HAL/RTOS，上位机 (Host/) 可直接编译用于模糊测试和性能测试。
+  *
+  * 协议:
+  *   - 一行一条命令，以 '\n' 或 '\r' 结束，空行忽略
+  *   - 命令名与参数之间以空格或制表符分隔，如 "kp 120.5"
+  *   - 行长度超过 CMD_LINE_MAX-1 时整行丢弃，并报告 CMD_ERR_OVERFLOW
+  *
+  * 解析不拷贝数据: 分词直接在行缓冲区内把分隔符改为 '\0'，
+  * argv[] 指向行缓冲区内部，命令表按名称查找后调用处理函数。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __CMD_PARSER_H
+#define __CMD_PARSER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define CMD_LINE_MAX      64      // 行缓冲区大小 (含结尾 '\0')
+#define CMD_ARGC_MAX      4       // 最多参数个数 (不含命令名)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 命令执行结果
+ */
+typedef enum {
+    CMD_OK = 0,
+    CMD_ERR_UNKNOWN,        // 未知命令
+    CMD_ERR_ARGC,           // 参数个数错误
+    CMD_ERR_VALUE,          // 参数格式错误
+    CMD_ERR_RANGE,          // 参数超出范围
+    CMD_ERR_OVERFLOW,       // 行过长
+    CMD_ERR_BUSY            // 当前状态下不能执行
+} Cmd_Status_t;
+
+/**
+ * @brief 应答附加内容 (处理函数写入 JSON 字段片段，如 "\"kp\":120.50")
+ */
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+} Cmd_Reply_t;
+
+/**
+ * @brief 命令处理函数
+ * @param argc: 参数个数 (不含命令名)
+ * @param argv: 参数，指向行缓冲区内部
+ * @param reply: 应答附加内容
+ */
+typedef Cmd_Status_t (*Cmd_Handler_t)(int argc, char *argv[], Cmd_Reply_t *reply);
+
+/**
+ * @brief 命令表项
+ */
+typedef struct {
+    const char *name;       // 命令名
+    uint8_t min_args;       // 最少参数个数
+    uint8_t max_args;       // 最多参数个数
+    Cmd_Handler_t handler;  // 处理函数
+    const char *usage;      // 用法说明 (help 命令输出)
+} Cmd_Entry_t;
+
+/**
+ * @brief 行缓冲区 (按字节组装一行)
+ */
+typedef struct {
+    char buf[CMD_LINE_MAX];
+    uint16_t len;
+    uint8_t overflow;       // 当前行已超长，丢弃到行尾
+} Cmd_Line_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化行缓冲区
+ * @param  line: 行缓冲区
+ * @retval None
+ */
+void Cmd_LineInit(Cmd_Line_t *line);
+
+/**
+ * @brief  输入一个字节
+ * @param  line: 行缓冲区
+ * @param  byte: 收到的字节
+ * @retval 1: 一行完整 (line->buf 以 '\0' 结尾)，-1: 一行结束但超长已丢弃，0: 行未结束
+ * @note   返回 1 或 -1 后下一次调用自动开始新的一行
+ */
+int Cmd_LineFeed(Cmd_Line_t *line, uint8_t byte);
+
+/**
+ * @brief  按空白在原处分词
+ * @param  text: 待分词字符串 (会被修改)
+ * @param  argv: 输出各词起始地址
+ * @param  max: argv 容量
+ * @retval 词的个数，超过 max 时返回 max + 1
+ */
+int Cmd_Tokenize(char *text, char *argv[], int max);
+
+/**
+ * @brief  查表并执行一行命令
+ * @param  table: 命令表
+ * @param  count: 命令表项数
+ * @param  text: 一行命令 (会被修改)
+ * @param  entry: 输出匹配的表项，未匹配时为 NULL
+ * @param  reply: 应答附加内容
+ * @retval 执行结果，空行返回 CMD_OK 且 entry 为 NULL
+ */
+Cmd_Status_t Cmd_Execute(const Cmd_Entry_t *table, size_t count, char *text,
+                         const Cmd_Entry_t **entry, Cmd_Reply_t *reply);
+
+/**
+ * @brief  解析十进制小数 (可带符号，不支持指数)
+ * @param  s: 字符串
+ * @param  value: 输出值
+ * @retval CMD_OK / CMD_ERR_VALUE
+ */
+Cmd_Status_t Cmd_ParseFloat(const char *s, float *value);
+
+/**
+ * @brief  解析十进制无符号整数
+ * @param  s: 字符串
+ * @param  value: 输出值
+ * @retval CMD_OK / CMD_ERR_VALUE (含溢出)
+ */
+Cmd_Status_t Cmd_ParseU32(const char *s, uint32_t *value);
+
+/**
+ * @brief  向应答附加内容追加格式化文本 (超出缓冲区时截断)
+ * @param  reply: 应答附加内容
+ * @param  format: 格式字符串 (同 Fmt_Snprintf)
+ * @retval None
+ */
+void Cmd_ReplyAppend(Cmd_Reply_t *reply, const char *format, ...);
+
+/**
+ * @brief  执行结果对应的短字符串 (用于应答)
+ * @param  status: 执行结果
+ * @retval "ok" / "unknown" / "argc" / "value" / "range" / "overflow" / "busy"
+ */
+const char *Cmd_StatusString(Cmd_Status_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMD_PARSER_H */
@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file           : command.h
+  * @brief          : Header for command.c file.
+  *                   上位机命令处理 (USART2)
+  ******************************************************************************
+  * @attention
+  *
+  * 行命令协议见 cmd_parser.h，支持的命令:
+  *
+  *   help                    列出全部命令
+  *   get                     查询当前状态
+  *   sp <°C> | sp auto       设置目标温度 / 恢复自动切换目标温度
+  *   kp|ki|kd <值>           设置 PID 增益
+  *   db <°C>                 设置温度死区
+  *   lim <最小> <最大>       设置 PID 输出限幅 (0-1000ms)
+  *   rate <ms>               设置上报周期，0 停止上报
+  *   mode json|bin           切换上报模式
+  *   route console|data      采样上报走 USART2 / USART1 数据通道
+  *   stats [data|tlm|wf]     查询串口收发统计 (data: USART1 发送统计，tlm: 上报队列统计，
+  *                           wf: WF5803F 采集统计)
+  *   baud <波特率> | baud ok  协商 USART2 波特率 / 确认新波特率 (见 baud_neg.h)
+  *   wf single|cont [odr] [osr]  WF5803F 单次/连续转换，sleep_time 编码和气压过采样率
+  *   i2c [1|2]               查询 I2C 总线恢复次数和按设备的传输统计 (见 i2c_bus.h)
+  *   flt [预设] [中值窗口]   设置/查询 NTC 滤波级 (见 sensor_filter.h)
+  *   ch [1-4] [on|off]       选择温控通道 / 启用、关闭该通道 (见 temp_pid_ctrl.h)
+  *   kf [on|off] | kf <r_ntc> <r_wf> [q]  通道1 卡尔曼融合开关 / 噪声参数 (见 temp_fusion.h)
+  *   ctl [ms|reset]          查询控制循环周期/抖动统计，修改周期 (1-1000ms) 或清零统计 (见 ctrl_loop.h)
+  *   pid [pos|f32|q31|q15|bench]  选择 PID 后端 / 各后端耗时和轨迹基准测试 (见 pid_ctrl.h)
+  *
+  * get/sp/kp/ki/kd/db/lim/flt/pid 作用于 "ch" 选择的通道 (缺省通道1)。
+  *
+  * 每条命令回复一行 JSON 应答:
+  *   {"type":"ack","cmd":"kp","status":"ok","kp":120.0000}
+  *   {"type":"ack","cmd":"kp","status":"range"}
+  * status 取值见 Cmd_StatusString()。应答不受 LOG_DEFERRED 影响，始终为文本。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __COMMAND_H
+#define __COMMAND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmd_parser.h"
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化命令处理
+ * @retval None
+ */
+void Command_Init(void);
+
+/**
+ * @brief  输入串口收到的数据，每收到完整一行执行一条命令并发送应答
+ * @param  data: 数据
+ * @param  len: 数据长度
+ * @retval None
+ * @note   仅在 USART 接收任务中调用
+ */
+void Command_Feed(const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __COMMAND_H */
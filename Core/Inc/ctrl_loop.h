@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file           : ctrl_loop.h
+  * @brief          : Header for ctrl_loop.c file.
+  *                   固定周期控制循环 (osDelayUntil) 与周期/抖动统计
+  ******************************************************************************
+  * @attention
+  *
+  * 采集任务每周期末尾调用 CtrlLoop_Wait，按绝对节拍 (osDelayUntil -> vTaskDelayUntil)
+  * 阻塞到下一个周期起点，周期与本周期的工作时间 (I2C、ADC、计算) 无关。
+  * 工作时间超过一个周期时记为一次超时 (overrun)，不补跑错过的周期，从当前节拍重新对齐。
+  *
+  * 周期 1 ~ 1000ms (系统节拍 1ms，最高 1kHz)，CtrlLoop_SetPeriod 只记录请求，
+  * 下一次 CtrlLoop_Wait 生效。统计用 DWT 周期计数 (dwt_time.h):
+  * - period: 相邻两次唤醒的实测间隔，jitter 为其与标称周期之差的最大绝对值
+  * - busy:   唤醒到进入等待的工作时间，接近周期时说明该周期已无余量
+  * 周期修改后统计清零，只反映当前周期。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __CTRL_LOOP_H
+#define __CTRL_LOOP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define CTRL_LOOP_PERIOD_MS         500     // 缺省控制周期 (ms)
+#define CTRL_LOOP_PERIOD_MIN_MS     1       // 最短周期 (1kHz，一个系统节拍)
+#define CTRL_LOOP_PERIOD_MAX_MS     1000    // 最长周期
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 周期统计 (时间单位为 CPU 周期)
+ */
+typedef struct {
+    uint32_t period_ms;         // 当前标称周期 (ms)
+    uint32_t count;             // 已完成的周期数
+    uint32_t overruns;          // 工作时间超过周期的次数
+    uint32_t period_last;       // 最近一次实测周期
+    uint32_t period_min;
+    uint32_t period_max;
+    uint32_t jitter_max;        // |实测周期 - 标称周期| 最大值
+    uint32_t busy_last;         // 最近一个周期的工作时间
+    uint32_t busy_max;
+} CtrlLoop_Stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  以当前时刻作为第一个周期的起点
+ * @retval None
+ * @note   在控制任务进入循环前调用一次
+ */
+void CtrlLoop_Start(void);
+
+/**
+ * @brief  结束本周期: 记录工作时间，阻塞到下一个周期起点并记录实测周期
+ * @retval 下一个周期的标称周期 (ms)
+ * @note   只能在控制任务中调用
+ */
+uint32_t CtrlLoop_Wait(void);
+
+/**
+ * @brief  请求修改周期，下一次 CtrlLoop_Wait 生效
+ * @param  period_ms: 周期 (CTRL_LOOP_PERIOD_MIN_MS ~ CTRL_LOOP_PERIOD_MAX_MS)
+ * @retval 0: 已记录，-1: 超出范围
+ */
+int CtrlLoop_SetPeriod(uint32_t period_ms);
+
+/**
+ * @brief  获取请求的周期
+ * @retval 周期 (ms)
+ */
+uint32_t CtrlLoop_GetPeriod(void);
+
+/**
+ * @brief  获取统计快照
+ * @param  stats: 输出
+ * @retval None
+ */
+void CtrlLoop_GetStats(CtrlLoop_Stats_t *stats);
+
+/**
+ * @brief  请求清零统计，下一次 CtrlLoop_Wait 生效
+ * @retval None
+ */
+void CtrlLoop_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CTRL_LOOP_H */
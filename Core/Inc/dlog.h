@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file           : dlog.h
+  * @brief          : Header for dlog.c file.
+  *                   延迟格式化日志 (格式字符串留在 ELF 中，由上位机还原文本)
+  ******************************************************************************
+  * @attention
+  *
+  * 编译时定义 LOG_DEFERRED (CMake 选项 -DLOG_DEFERRED=ON) 后，
+  * send_message(fmt, ...) 变为宏:
+  * - 格式字符串放入 .log_fmt 段，该段在链接脚本中为 (INFO) 类型，不占用 Flash
+  * - 字符串在段内的地址即日志 ID (16位)
+  * - 设备只发送 ID + 二进制参数，封装为 TLM_FRAME_TYPE_LOG 帧
+  * - 上位机 tlm_decode --elf / tlm_ingest --elf 读取 ELF 中的 .log_fmt 段，按格式字符串还原文本
+  *
+  * 参数编码 (小端，按参数的 C 类型决定):
+  * - 整数类型 (含 char)  -> int32, 4 字节
+  * - float / double      -> float, 4 字节
+  * - char * 字符串       -> 以 '\0' 结尾的字节串 (超出帧长度时截断)
+  *
+  * 限制: 格式字符串必须是字符串字面量，最多 8 个参数，不支持 64 位整数。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __DLOG_H
+#define __DLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 参数类型
+ */
+typedef enum {
+    DLOG_ARG_INT = 0,
+    DLOG_ARG_FLOAT,
+    DLOG_ARG_STR
+} DLog_ArgType_t;
+
+/**
+ * @brief 一个日志参数
+ */
+typedef struct {
+    DLog_ArgType_t type;
+    union {
+        int32_t i;
+        float f;
+        const char *s;
+    } v;
+} DLog_Arg_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  发送一条延迟格式化日志
+ * @param  id: 日志 ID (格式字符串在 .log_fmt 段内的地址)
+ * @param  nargs: 参数个数
+ * @param  args: 参数数组
+ * @retval None
+ */
+void DLog_Write(uint16_t id, uint32_t nargs, const DLog_Arg_t *args);
+
+static inline DLog_Arg_t DLog_ArgI(int32_t v) { DLog_Arg_t a = { DLOG_ARG_INT, { .i = v } }; return a; }
+static inline DLog_Arg_t DLog_ArgF(double v) { DLog_Arg_t a = { DLOG_ARG_FLOAT, { .f = (float)v } }; return a; }
+static inline DLog_Arg_t DLog_ArgS(const char *v) { DLog_Arg_t a = { DLOG_ARG_STR, { .s = v } }; return a; }
+
+/* Exported macro ------------------------------------------------------------*/
+
+/* 按参数的 C 类型选择编码方式 */
+#define DLOG_ARG(x) _Generic((x),                                   \
+        float: DLog_ArgF, double: DLog_ArgF,                        \
+        char *: DLog_ArgS, const char *: DLog_ArgS,                 \
+        default: DLog_ArgI)(x)
+
+/* 参数个数 (0-8) */
+#define DLOG_NARGS(...)  DLOG_NARGS_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+/* 对每个参数应用 DLOG_ARG */
+#define DLOG_MAP_1(a)                    DLOG_ARG(a)
+#define DLOG_MAP_2(a, ...)               DLOG_ARG(a), DLOG_MAP_1(__VA_ARGS__)
+#define DLOG_MAP_3(a, ...)               DLOG_ARG(a), DLOG_MAP_2(__VA_ARGS__)
+#define DLOG_MAP_4(a, ...)               DLOG_ARG(a), DLOG_MAP_3(__VA_ARGS__)
+#define DLOG_MAP_5(a, ...)               DLOG_ARG(a), DLOG_MAP_4(__VA_ARGS__)
+#define DLOG_MAP_6(a, ...)               DLOG_ARG(a), DLOG_MAP_5(__VA_ARGS__)
+#define DLOG_MAP_7(a, ...)               DLOG_ARG(a), DLOG_MAP_6(__VA_ARGS__)
+#define DLOG_MAP_8(a, ...)               DLOG_ARG(a), DLOG_MAP_7(__VA_ARGS__)
+
+#define DLOG_ARRAY_0()                   NULL
+#define DLOG_ARRAY_N(n, ...)             ((const DLog_Arg_t[]){ DLOG_MAP_##n(__VA_ARGS__) })
+#define DLOG_ARRAY_1(...)                DLOG_ARRAY_N(1, __VA_ARGS__)
+#define DLOG_ARRAY_2(...)                DLOG_ARRAY_N(2, __VA_ARGS__)
+#define DLOG_ARRAY_3(...)                DLOG_ARRAY_N(3, __VA_ARGS__)
+#define DLOG_ARRAY_4(...)                DLOG_ARRAY_N(4, __VA_ARGS__)
+#define DLOG_ARRAY_5(...)                DLOG_ARRAY_N(5, __VA_ARGS__)
+#define DLOG_ARRAY_6(...)                DLOG_ARRAY_N(6, __VA_ARGS__)
+#define DLOG_ARRAY_7(...)                DLOG_ARRAY_N(7, __VA_ARGS__)
+#define DLOG_ARRAY_8(...)                DLOG_ARRAY_N(8, __VA_ARGS__)
+#define DLOG_ARRAY_(n, ...)              DLOG_ARRAY_##n(__VA_ARGS__)
+#define DLOG_ARRAY(n, ...)               DLOG_ARRAY_(n, ##__VA_ARGS__)
+
+/**
+ * @brief  延迟格式化日志
+ * @param  fmt: 格式字符串 (必须为字面量)
+ */
+#define DLOG(fmt, ...)                                                          \
+    do {                                                                        \
+        static const char dlog_fmt_[] __attribute__((section(".log_fmt"), used)) = fmt; \
+        DLog_Write((uint16_t)(uintptr_t)dlog_fmt_, DLOG_NARGS(__VA_ARGS__),    \
+                   DLOG_ARRAY(DLOG_NARGS(__VA_ARGS__), ##__VA_ARGS__));         \
+    } while (0)
+
+#ifdef LOG_DEFERRED
+/* 现有 send_message 调用点无需修改 */
+#define send_message(fmt, ...)  DLOG(fmt, ##__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DLOG_H */
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file           : dwt_time.h
+  * @brief          : Header for dwt_time.c file.
+  *                   64 位 CPU 周期时间戳 (DWT->CYCCNT 回绕扩展)
+  ******************************************************************************
+  * @attention
+  *
+  * DWT->CYCCNT 为 32 位，72MHz 下约 59.6s 回绕一次。DwtTime_Now 记录上一次读到的值，
+  * 读数变小时高 32 位加 1；HAL 时基 (TIM1, 1kHz) 中断里调用 DwtTime_Update，
+  * 保证两次读取间隔远小于回绕周期。
+  * 时间戳从 DwtTime_Init 开始计，单位为 CPU 周期 (SystemCoreClock)，
+  * 与系统节拍 (HAL_GetTick，ms) 同时记录可以对齐两个时基。
+  *
+  * 可在任务、中断和调度器启动前调用；扩展过程短暂屏蔽中断 (十几个周期)。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __DWT_TIME_H
+#define __DWT_TIME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  开启 DWT 周期计数器并清零时间戳
+ * @retval None
+ * @note   在 SystemClock_Config 之后、其他模块使用 DWT 之前调用
+ */
+void DwtTime_Init(void);
+
+/**
+ * @brief  当前时间戳
+ * @retval 自 DwtTime_Init 起的 CPU 周期数
+ */
+uint64_t DwtTime_Now(void);
+
+/**
+ * @brief  推进回绕扩展 (HAL 时基中断中调用)
+ * @retval None
+ */
+void DwtTime_Update(void);
+
+/**
+ * @brief  CPU 周期数换算为微秒
+ * @param  cycles: 周期数
+ * @retval 微秒
+ */
+uint64_t DwtTime_ToUs(uint64_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DWT_TIME_H */
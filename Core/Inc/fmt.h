@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file           : fmt.h
+  * @brief          : Header for fmt.c file.
+  *                   轻量格式化输出 (替代 newlib vsnprintf)
+  ******************************************************************************
+  * @attention
+  *
+  * - 不分配内存、不调用 _sbrk、无全局状态，可重入
+  * - 无递归、无变长数组，栈占用固定 (一个 24 字节数字缓冲区 + 若干局部变量)
+  * - 浮点数按单精度定点方式格式化，只用 32/64 位整数运算
+  *
+  * 支持的转换说明:
+  *   %d %i %u %x %X %o %c %s %p %f %F %%
+  *   标志 '-' '0' '+' ' '，宽度/精度 (数字或 '*')，长度修饰符 h/l/ll/z
+  *
+  * 与标准 printf 的差异:
+  * - %f 精度最大 9 位，缺省 6 位；参数先转换为 float，输出为该 float 值的精确十进制舍入，
+  *   舍入规则与 printf 相同 (恰为一半时取偶数)，与 printf 输出同一 float 的结果逐字符一致
+  * - 不支持 %e %g %a，遇到时原样输出转换说明
+  *
+  ******************************************************************************
+  */
+
+#ifndef __FMT_H
+#define __FMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stddef.h>
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  格式化到缓冲区 (语义同 vsnprintf)
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小 (含结尾 '\0')
+ * @param  format: 格式字符串
+ * @param  args: 可变参数
+ * @retval 完整输出所需的字符数 (不含 '\0')，>= size 表示被截断
+ */
+int Fmt_Vsnprintf(char *buf, size_t size, const char *format, va_list args);
+
+/**
+ * @brief  格式化到缓冲区 (语义同 snprintf)
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小 (含结尾 '\0')
+ * @param  format: 格式字符串
+ * @retval 完整输出所需的字符数 (不含 '\0')
+ */
+int Fmt_Snprintf(char *buf, size_t size, const char *format, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FMT_H */
@@ -0,0 +1,201 @@
+/**
+  ******************************************************************************
+  * @file           : i2c_bus.h
+  * @brief          : Header for i2c_bus.c file.
+  *                   I2C 总线层 (事务队列、超时、总线恢复、按设备统计)
+  ******************************************************************************
+  * @attention
+  *
+  * 所有对 hi2c1/hi2c2 的访问都经过本层，每条总线一个事务队列和一个执行器:
+  * - 驱动提交描述符 I2cBus_Xfer_t (地址、寄存器、方向、缓冲区、完成回调)，
+  *   I2cBus_Submit 只入队、不阻塞
+  * - 执行器运行在 FreeRTOS 定时器服务任务中: 一个传输完成 (I2C/DMA 中断经
+  *   xTimerPendFunctionCallFromISR 转交) 后立即启动队列中的下一个，总线连续工作；
+  *   读用 DMA (单字节用中断)，写用中断
+  * - 每个传输按长度和总线速度计算超时，由总线看门狗定时器兜底；超时或总线一直忙时
+  *   执行总线恢复: 引脚切换为开漏 GPIO，输出最多 9 个 SCL 脉冲直到 SDA 释放，
+  *   再产生 STOP 并重新初始化外设。每个提交成功 (返回 HAL_OK) 的描述符都保证回调一次
+  * - 阻塞读写 I2cBus_MemRead/MemWrite 同样走事务队列，失败时按 1/2/4ms 退避重试，
+  *   任务之间不需要互斥量
+  *
+  * 统计按 (总线, 7 位地址) 记录: 传输次数、NACK、超时、其他错误、重试次数，
+  * 以及成功传输的耗时直方图 (DWT 周期计数，分箱上界见 I2CBUS_HIST_EDGES_US)。
+  * 通过 "i2c" 命令查询。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __I2C_BUS_H
+#define __I2C_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os.h"
+#include "i2c.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define I2CBUS_DEV_MAX          4       // 每条总线最多统计的设备数
+#define I2CBUS_QUEUE_LEN        8       // 每条总线待执行描述符数
+#define I2CBUS_HIST_BINS        8       // 耗时直方图分箱数
+#define I2CBUS_HIST_EDGES_US    { 100, 200, 500, 1000, 2000, 5000, 10000 }   // 最后一箱为 >= 10ms
+#define I2CBUS_RETRY_MAX        3       // 阻塞读写最多重试次数
+#define I2CBUS_BACKOFF_MS       1       // 首次重试前的退避时间，之后每次加倍
+#define I2CBUS_TIMEOUT_BASE_MS  2       // 超时 = 基础时间 + 2 倍理论传输时间
+#define I2CBUS_KICK_WAIT_MS     10      // 提交时定时器命令队列满的最长等待
+#define I2CBUS_WAIT_MS          100     // 阻塞读写等待完成 (含排队) 的上限，超时后撤回未启动的描述符
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct I2cBus_Xfer I2cBus_Xfer_t;
+
+/**
+ * @brief 传输完成回调 (在 FreeRTOS 定时器服务任务中调用，不可阻塞，可再次提交)
+ */
+typedef void (*I2cBus_Callback_t)(I2cBus_Xfer_t *xfer);
+
+/**
+ * @brief 传输描述符 (提交后到回调返回前由总线层持有，调用者不能修改或释放)
+ */
+struct I2cBus_Xfer {
+    uint16_t addr;                      // 设备地址 (HAL 格式，7 位地址左移 1 位)
+    uint8_t reg;                        // 寄存器地址 (8 位)
+    uint8_t read;                       // 1: 读，0: 写
+    uint8_t *data;                      // 数据缓冲区
+    uint16_t len;                       // 数据长度
+    I2cBus_Callback_t callback;         // 完成回调，可为 NULL
+    void *ctx;                          // 调用者上下文
+
+    HAL_StatusTypeDef status;           // 完成时填写: HAL_OK / HAL_ERROR / HAL_BUSY / HAL_TIMEOUT
+    uint32_t error;                     // 完成时填写: hi2c->ErrorCode
+};
+
+/**
+ * @brief 单个设备的传输统计
+ */
+typedef struct {
+    uint8_t addr;                       // 7 位地址，0 表示空槽
+    uint32_t xfers;                     // 传输次数 (含失败，不含重试)
+    uint32_t nacks;                     // 地址或数据未应答
+    uint32_t timeouts;                  // 超时
+    uint32_t errors;                    // 总线错误/仲裁丢失/忙等其他错误
+    uint32_t retries;                   // 重试次数
+    uint32_t hist[I2CBUS_HIST_BINS];    // 成功传输耗时分布
+} I2cBus_DevStats_t;
+
+/**
+ * @brief I2C 总线
+ */
+typedef struct {
+    I2C_HandleTypeDef *hi2c;            // HAL 句柄
+    uint8_t id;                         // 总线编号 (1/2)
+    GPIO_TypeDef *scl_port;             // 总线恢复用引脚
+    uint16_t scl_pin;
+    GPIO_TypeDef *sda_port;
+    uint16_t sda_pin;
+
+    QueueHandle_t queue;                // 待执行描述符 (指针)
+    StaticQueue_t queue_struct;
+    uint8_t queue_storage[I2CBUS_QUEUE_LEN * sizeof(I2cBus_Xfer_t *)];
+    TimerHandle_t timer;                // 当前传输看门狗
+    StaticTimer_t timer_struct;
+
+    I2cBus_Xfer_t *volatile active;     // 正在执行的描述符
+    volatile uint8_t kick_pending;      // 已投递启动请求，尚未执行
+    volatile uint32_t seq;              // 传输序号，用于丢弃超时后迟到的完成事件
+    uint32_t start_tick;                // 当前传输启动时刻 (ms)
+    uint32_t start_cycles;              // 当前传输启动时刻 (DWT 周期)
+    uint32_t timeout_ms;                // 当前传输超时
+
+    uint32_t recoveries;                // 执行总线恢复次数
+    uint32_t recover_fail;              // 恢复后 SDA 仍为低的次数
+    uint32_t queue_full;                // 队列满拒绝提交次数
+    uint32_t kick_fail;                 // 启动请求投递失败 (描述符已撤回) 次数
+    uint32_t queue_high;                // 队列最大深度
+    I2cBus_DevStats_t dev[I2CBUS_DEV_MAX];
+} I2cBus_t;
+
+/* Exported variables --------------------------------------------------------*/
+extern I2cBus_t i2c_bus1;               // I2C1 (PB8/PB9)
+extern I2cBus_t i2c_bus2;               // I2C2 (PB10/PB11)
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化总线层 (事务队列、看门狗定时器)，DWT 周期计数器由 DwtTime_Init 开启
+ * @retval None
+ * @note   在 MX_FREERTOS_Init 中、任务创建前调用
+ */
+void I2cBus_Init(void);
+
+/**
+ * @brief  提交一个传输 (立即返回)
+ * @param  bus: 总线
+ * @param  xfer: 描述符，完成时填写 status/error 并调用 callback
+ * @retval HAL_OK: 已入队；HAL_BUSY: 队列满或无法唤醒执行器 (已撤回，不会回调)
+ * @note   在任务或描述符回调中调用，不能在中断中调用。任务中调用时定时器命令队列满
+ *         最多等待 I2CBUS_KICK_WAIT_MS
+ */
+HAL_StatusTypeDef I2cBus_Submit(I2cBus_t *bus, I2cBus_Xfer_t *xfer);
+
+/**
+ * @brief  阻塞读寄存器 (经事务队列，带超时、重试和总线恢复)
+ * @param  bus: 总线
+ * @param  addr: 设备地址 (HAL 格式，7 位地址左移 1 位)
+ * @param  reg: 寄存器地址 (8 位)
+ * @param  data: 输出数据
+ * @param  len: 数据长度
+ * @retval HAL_OK / HAL_ERROR / HAL_BUSY / HAL_TIMEOUT (最后一次尝试的结果)
+ * @note   只能在任务中调用 (不能在定时器服务任务或描述符回调中调用)
+ */
+HAL_StatusTypeDef I2cBus_MemRead(I2cBus_t *bus, uint16_t addr, uint8_t reg, uint8_t *data, uint16_t len);
+
+/**
+ * @brief  阻塞写寄存器 (经事务队列，带超时、重试和总线恢复)
+ * @param  bus: 总线
+ * @param  addr: 设备地址 (HAL 格式)
+ * @param  reg: 寄存器地址 (8 位)
+ * @param  data: 数据
+ * @param  len: 数据长度
+ * @retval HAL_OK / HAL_ERROR / HAL_BUSY / HAL_TIMEOUT
+ * @note   只能在任务中调用 (不能在定时器服务任务或描述符回调中调用)
+ */
+HAL_StatusTypeDef I2cBus_MemWrite(I2cBus_t *bus, uint16_t addr, uint8_t reg, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  总线恢复: 9 个 SCL 脉冲 + STOP，然后重新初始化外设
+ * @param  bus: 总线
+ * @retval HAL_OK: SDA 已释放，HAL_ERROR: SDA 仍被拉低
+ * @note   会中止进行中的传输，由执行器在传输超时时调用
+ */
+HAL_StatusTypeDef I2cBus_Recover(I2cBus_t *bus);
+
+/**
+ * @brief  获取设备统计快照
+ * @param  bus: 总线
+ * @param  dev: 输出 I2CBUS_DEV_MAX 个统计槽 (addr 为 0 的槽未使用)
+ * @retval None
+ */
+void I2cBus_GetStats(const I2cBus_t *bus, I2cBus_DevStats_t *dev);
+
+/**
+ * @brief  当前 CPU 周期计数 (DWT->CYCCNT)，用于测量传输耗时
+ * @retval 周期数
+ */
+uint32_t I2cBus_Cycles(void);
+
+/**
+ * @brief  获取总线当前时钟频率
+ * @param  bus: 总线
+ * @retval 时钟频率 (Hz)
+ */
+uint32_t I2cBus_GetSpeed(const I2cBus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __I2C_BUS_H */
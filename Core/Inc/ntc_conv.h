@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file           : ntc_conv.h
+  * @brief          : Header for ntc_conv.c file.
+  *                   NTC ADC 码 -> 温度换算 (查找表插值 / 公式)
+  ******************************************************************************
+  * @attention
+  *
+  * 此文件不依赖 HAL，固件 (NTC.c、temp_pid_ctrl.c) 与上位机 (Host/tools/ntc_bench)
+  * 共用同一份换算代码。查找表及其参数见 ntc_param.h。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __NTC_CONV_H
+#define __NTC_CONV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "ntc_param.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define V_REF 3.3f            // 参考电压 (3.3V)
+
+/* Exported functions prototypes ---------------------------------------------*/
+float compute_ntc_temperature(uint32_t adcValue);
+float compute_ntc_temperature_ovs(uint32_t adcValue);
+float compute_ntc_temperature_exact(float ratio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NTC_CONV_H */
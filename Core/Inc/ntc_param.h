@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file           : ntc_param.h
+  * @brief          : NTC 热敏电阻参数与查找表定义 (不依赖 HAL，固件与上位机共用)
+  ******************************************************************************
+  * @attention
+  *
+  * 温度查找表 ntc_table[] 由 Host/tools/ntc_table_gen 按本文件的参数生成
+  * (Core/Src/ntc_table.c)，按过采样 ADC 码 (0 ~ NTC_TABLE_CODE_MAX) 等间距取点，
+  * 相邻点之间线性插值。修改参数后重新生成:
+  *
+  *   cmake -S Host -B build/host && cmake --build build/host
+  *   build/host/ntc_table_gen --check Core/Src/ntc_table.c
+  *
+  * ntc_table.c 中记录了生成时的参数，与本文件不一致时编译报错。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __NTC_PARAM_H
+#define __NTC_PARAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// NTC 热敏电阻参数
+#define NTC_BETA 3380.0f      // NTC 热敏电阻的 Beta 常数 (B值 25°C/50°C)
+#define NTC_R0 10000.0f       // NTC 热敏电阻在 T0 温度下的阻值 (10k Ohm @ 25°C)
+#define NTC_T0 298.15f        // 参考温度 T0 (25°C = 298.15K)
+#define NTC_R_SERIES 10000.0f // 串联电阻的阻值 (10k Ohm)
+
+// Steinhart-Hart 模式: 1/T = A + B*ln(R) + C*ln(R)^3
+// 缺省系数与上面的 Beta 模型等价 (C = 0)，换用规格书 R-T 表三点拟合的系数可提高宽温区精度
+#define NTC_USE_STEINHART 0
+#define NTC_SH_A 6.2906366191e-04
+#define NTC_SH_B 2.9585798817e-04
+#define NTC_SH_C 0.0
+
+// 查找表
+#define NTC_TABLE_BITS 10                             // 表点数 2^BITS + 1
+#define NTC_TABLE_SIZE ((1U << NTC_TABLE_BITS) + 1U)
+#define NTC_TABLE_CODE_MAX 65520U                     // 输入满量程 (12 位 ADC 过采样 4 位: 4095 << 4)
+#define NTC_TABLE_SCALE 256                           // 表值单位 1/256 °C
+#define NTC_TABLE_T_MIN (-55)                         // 表值限幅 (°C)，超出量程的码读出限幅值
+#define NTC_TABLE_T_MAX 127
+
+// 查找表 (Core/Src/ntc_table.c)，ntc_table[i] 对应 ADC 码 i << (16 - NTC_TABLE_BITS)
+extern const int16_t ntc_table[NTC_TABLE_SIZE];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NTC_PARAM_H */
@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file           : pid_ctrl.h
+  * @brief          : Header for pid_ctrl.c file.
+  *                   PID 控制器 (位置式浮点 / CMSIS-DSP 增量式 f32、q31、q15)
+  ******************************************************************************
+  * @attention
+  *
+  * 此文件不依赖 HAL，固件与上位机 (Host/tools/pid_bench) 共用。
+  *
+  * 每个 PID_Controller_t 可选一种后端 (PID_Backend_t)，增益、限幅和死区对全部后端相同:
+  * - pos: 原有的位置式浮点算法 u = Kp e + Ki ∫e dt + Kd de/dt
+  * - f32/q31/q15: CMSIS-DSP 增量式 arm_pid_*，y[n] = y[n-1] + A0 x[n] + A1 x[n-1] + A2 x[n-2]，
+  *   A0 = Kp + Ki dt + Kd/dt，A1 = -(Kp + 2 Kd/dt)，A2 = Kd/dt；增益、输出限幅变化或 dt
+  *   偏离超过 PID_DSP_DT_TOL 时用 arm_pid_init_* 重算系数
+  *
+  * 定点后端把误差和输出归一化: x = e / err_fs，y = u / out_fs，
+  * out_fs = 2 × max(|输出上限|, |输出下限|)，要求 |x| <= 0.5、|y[n-1]| <= 0.5；
+  * err_fs 按 |A0| + |A1| + |A2| 选取，使归一化系数之和不超过 PID_Q_HEADROOM，
+  * 保证 arm_pid_q31 的累加 (无饱和) 不溢出。误差超出 ±err_fs/2 或 y 超出 ±out_fs/2 时
+  * (Kp 大、误差大，通常输出已饱和) 该采样按位置式计算，下一次重新预置状态。
+  *
+  * 增量式没有显式的积分项，原有的积分限幅按等价形式保持: 积分贡献 y - Kp e - Kd de/dt
+  * 限制在 [Ki × 积分下限, Ki × 积分上限] 内，写回 y[n-1]，再做输出限幅 (输出限幅不写回)，
+  * 因此 f32 与位置式逐点一致。死区内不计算、输出保持，与位置式相同。
+  * integral 由 y 反算 (Ki = 0 时照常累加)，切换回 pos 时无扰动。
+  *
+  * 运行时切换: PID_SetBackend 只记录请求，下一次 PID_Compute 开始时应用。
+  * 增益、dt、输出限幅变化或切换后端时由 prev_error / integral 预置状态
+  * (x[n-1] = x[n-2] = prev_error，y[n-1] = Kp prev_error + Ki integral)，与位置式同样无扰。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __PID_CTRL_H
+#define __PID_CTRL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "arm_math.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define PID_DSP_DT_TOL          0.01f   // 增量式后端: dt 相对变化超过 1% 时重算系数
+#define PID_Q_HEADROOM          0.9f    // 定点后端归一化系数 |A0|+|A1|+|A2| 的上限
+#define PID_Q_ERR_FS_MAX        256.0f  // 定点后端误差满量程上限 (°C，增益为 0 时使用)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief PID 后端
+ */
+typedef enum {
+    PID_BACKEND_POS = 0,        // 位置式浮点 (原算法)
+    PID_BACKEND_F32,            // CMSIS arm_pid_f32
+    PID_BACKEND_Q31,            // CMSIS arm_pid_q31
+    PID_BACKEND_Q15,            // CMSIS arm_pid_q15
+    PID_BACKENDS
+} PID_Backend_t;
+
+/**
+ * @brief PID控制器参数结构体
+ */
+typedef struct {
+    float Kp;           // 比例增益
+    float Ki;           // 积分增益
+    float Kd;           // 微分增益
+
+    float setpoint;     // 目标温度 (°C)
+    float integral;     // 积分累积值
+    float prev_error;   // 上次误差值
+
+    float output;       // PID输出值 (0-100)
+    float output_limit_max;  // 输出上限
+    float output_limit_min;  // 输出下限
+
+    float integral_limit_max;  // 积分限幅最大值
+    float integral_limit_min;  // 积分限幅最小值
+
+    float deadband;            // 温度死区 (°C)
+
+    uint32_t sample_time_ms;   // 采样周期(ms)
+
+    PID_Backend_t backend;              // 当前后端
+    volatile uint8_t backend_request;   // 请求的后端 (命令任务写入)
+    uint8_t dsp_valid;                  // 0: 下一次计算前重算系数并预置增量式状态
+    union {
+        arm_pid_instance_f32 f32;
+        arm_pid_instance_q31 q31;
+        arm_pid_instance_q15 q15;
+    } dsp;                              // 增量式后端实例
+    float dsp_kp;                       // 当前系数对应的 Kp / Ki / Kd / dt
+    float dsp_ki;
+    float dsp_kd;
+    float dsp_dt;
+    float dsp_out_fs;                   // 定点: 输出满量程
+    float dsp_err_fs;                   // 定点: 误差满量程
+} PID_Controller_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  PID控制器计算
+ * @param  pid: PID控制器结构体指针
+ * @param  measured_value: 当前测量的温度值
+ * @param  dt: 与上一次计算的实测采样间隔 (s)，<= 0 时 (复位后第一次) 按 sample_time_ms
+ * @retval PID输出值 (0-1000ms)
+ */
+float PID_Compute(PID_Controller_t *pid, float measured_value, float dt);
+
+/**
+ * @brief  设置PID目标温度
+ * @param  pid: PID控制器结构体指针
+ * @param  setpoint: 目标温度
+ * @retval None
+ */
+void PID_SetSetpoint(PID_Controller_t *pid, float setpoint);
+
+/**
+ * @brief  重置PID控制器
+ * @param  pid: PID控制器结构体指针
+ * @retval None
+ */
+void PID_Reset(PID_Controller_t *pid);
+
+/**
+ * @brief  请求切换后端，下一次 PID_Compute 时生效 (无扰切换)
+ * @param  pid: PID控制器结构体指针
+ * @param  backend: 后端
+ * @retval 0: 已记录，-1: 后端无效
+ */
+int PID_SetBackend(PID_Controller_t *pid, PID_Backend_t backend);
+
+/**
+ * @brief  后端名称
+ * @param  backend: 后端
+ * @retval "pos" / "f32" / "q31" / "q15"，无效时为 "?"
+ */
+const char *PID_BackendName(PID_Backend_t backend);
+
+/**
+ * @brief  按名称查找后端
+ * @param  name: 名称
+ * @retval 后端，未找到时为 PID_BACKENDS
+ */
+PID_Backend_t PID_FindBackend(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_CTRL_H */
@@ -0,0 +1,105 @@
+/**
+  ******************************************************************************
+  * @file           : sensor_check.h
+  * @brief          : Header for sensor_check.c file.
+  *                   传感器有效性检查 (量程 / 变化率 / 卡死 / 通信错误)
+  ******************************************************************************
+  * @attention
+  *
+  * 每个传感器一个 SensorCheck_t，每个采样调用一次 SensorCheck_Update，O(1)、不阻塞:
+  * - RANGE: 不在 [min, max] 内 (含 NaN)。NTC 开路读数为 NTC_TABLE_T_MIN (-55°C)，
+  *   短路为 NTC_TABLE_T_MAX (127°C)，均落在 -40 ~ 125°C 之外
+  * - RATE:  与上一个有效采样相差超过 rate_max (每采样)
+  * - STUCK: 连续 stuck_n 个采样完全相同 (0 表示不检查)，用于发现停止更新的数据
+  * - IO:    本次采样的读取失败 (I2C 错误/超时)，value 不参与其他检查
+  *
+  * 故障出现后立即置位，连续 recover_n 个无故障采样后才清除，避免在故障边缘反复
+  * 启停加热。调用者根据 SensorCheck_IsValid 决定是否使用该采样。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __SENSOR_CHECK_H
+#define __SENSOR_CHECK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define SENSOR_FAULT_RANGE      0x01U   // 超出量程 / NaN (开路、短路)
+#define SENSOR_FAULT_RATE       0x02U   // 变化率超限
+#define SENSOR_FAULT_STUCK      0x04U   // 数值卡死
+#define SENSOR_FAULT_IO         0x08U   // 读取失败
+#define SENSOR_FAULT_BITS       4       // 每个传感器占用的故障位数 (遥测中按传感器打包)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 检查门限
+ */
+typedef struct {
+    float min;                  // 量程下限
+    float max;                  // 量程上限
+    float rate_max;             // 相邻采样最大变化量
+    uint16_t stuck_n;           // 连续相同采样数达到此值判为卡死，0 不检查
+    uint16_t recover_n;         // 连续无故障采样数达到此值清除故障
+} SensorCheck_Limits_t;
+
+/**
+ * @brief 单个传感器的检查状态
+ */
+typedef struct {
+    const SensorCheck_Limits_t *limits;
+    float last;                 // 上一个采样 (变化率、卡死比较用)
+    uint8_t have_last;
+    uint8_t fault;              // 当前故障 (SENSOR_FAULT_xxx，含恢复计数期间保持的位)
+    uint16_t same;              // 连续相同采样数
+    uint16_t good;              // 连续无故障采样数
+    uint32_t count;             // 检出故障的采样数 (累计)
+} SensorCheck_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化检查状态
+ * @param  check: 检查状态
+ * @param  limits: 门限 (须长期有效)
+ * @retval None
+ */
+void SensorCheck_Init(SensorCheck_t *check, const SensorCheck_Limits_t *limits);
+
+/**
+ * @brief  清除历史和故障 (传感器重新启用时调用)
+ * @param  check: 检查状态
+ * @retval None
+ */
+void SensorCheck_Reset(SensorCheck_t *check);
+
+/**
+ * @brief  检查一个采样
+ * @param  check: 检查状态
+ * @param  value: 采样值
+ * @param  io_ok: 1: 读取成功，0: 读取失败 (value 被忽略)
+ * @retval 当前故障 (SENSOR_FAULT_xxx)，0 表示有效
+ */
+uint8_t SensorCheck_Update(SensorCheck_t *check, float value, uint8_t io_ok);
+
+/**
+ * @brief  当前是否有效
+ * @param  check: 检查状态
+ * @retval 1: 有效，0: 有故障
+ */
+static inline uint8_t SensorCheck_IsValid(const SensorCheck_t *check)
+{
+    return check->fault == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_CHECK_H */
@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file           : sensor_filter.h
+  * @brief          : Header for sensor_filter.c file.
+  *                   传感器滤波级 (中值预滤波 + IIR 双二阶级联)
+  ******************************************************************************
+  * @attention
+  *
+  * 位于传感器换算和 PID_Compute 之间，每个通道一个 SensorFilter_t:
+  *   输入 -> [中值预滤波, 窗口 1/3/5] -> [arm_biquad_cascade_df2T_f32] -> 输出
+  * - 中值预滤波剔除单点尖峰 (窗口 3 剔除 1 个，窗口 5 剔除 2 个)，延迟 (窗口-1)/2 个采样
+  * - IIR 系数离线设计，按预设选择 (SensorFilter_Preset_t)，均为直流增益 1 的
+  *   Butterworth 低通，采样率为 ADC 过采样抽取率 (1000Hz / 256 = 3.90625Hz，SENSOR_FILTER_TS_US)；
+  *   控制周期长于抽取周期时调用方传入经过的抽取周期数，IIR 以保持的输入补足步数，
+  *   截止频率不随控制周期变化
+  * - 首个采样 (以及每次重新配置后) 把中值窗口和 IIR 状态预置为稳态，输出不从 0 爬升
+  *
+  * 运行时配置: SensorFilter_Configure 只记录请求，由处理任务在下一次
+  * SensorFilter_Process 开始时应用，命令任务与处理任务之间不需要锁。
+  * 每次处理的 CPU 周期数 (DWT->CYCCNT，由 DwtTime_Init 使能) 记录在 cycles_last/cycles_max。
+  * 除计时外不依赖 HAL，上位机 (Host/tools/filter_bench) 编译时定义 SENSOR_FILTER_CLOCK
+  * 为计时函数名，替代 DWT->CYCCNT。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __SENSOR_FILTER_H
+#define __SENSOR_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "arm_math.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define SENSOR_FILTER_STAGES_MAX    2       // 最多双二阶级数 (4 阶)
+#define SENSOR_FILTER_MEDIAN_MAX    5       // 中值窗口最大长度 (奇数)
+#define SENSOR_FILTER_TS_US         256000U // 设计采样周期 (µs)，等于 ADC 过采样抽取周期
+#define SENSOR_FILTER_STEPS_MAX     8       // 单次处理最多补足的采样周期数
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief IIR 预设 (fs = 1 / SENSOR_FILTER_TS_US = 3.90625Hz)
+ */
+typedef enum {
+    SENSOR_FILTER_OFF = 0,          // 不滤波
+    SENSOR_FILTER_LP200,            // 2 阶低通 fc = 0.2Hz
+    SENSOR_FILTER_LP100,            // 2 阶低通 fc = 0.1Hz
+    SENSOR_FILTER_LP50,             // 2 阶低通 fc = 0.05Hz
+    SENSOR_FILTER_LP50X4,           // 4 阶低通 fc = 0.05Hz
+    SENSOR_FILTER_PRESETS
+} SensorFilter_Preset_t;
+
+/**
+ * @brief 预设的离线设计结果
+ */
+typedef struct {
+    const char *name;               // 命令中使用的名称
+    uint8_t stages;                 // 双二阶级数
+    const float *coeffs;            // 每级 {b0, b1, b2, a1, a2}，CMSIS 符号约定 (a 取反)
+} SensorFilter_Design_t;
+
+/**
+ * @brief 单通道滤波器
+ */
+typedef struct {
+    arm_biquad_cascade_df2T_instance_f32 iir;
+    float state[2 * SENSOR_FILTER_STAGES_MAX];
+    float median_buf[SENSOR_FILTER_MEDIAN_MAX];
+    uint8_t median_len;             // 中值窗口，1 表示关闭
+    uint8_t median_pos;
+    uint8_t primed;                 // 0: 下一个采样用于预置稳态
+    SensorFilter_Preset_t preset;
+
+    volatile uint32_t request;      // 待应用配置: [31:16] 序号，[15:8] 中值窗口，[7:0] 预设
+    uint32_t applied;               // 已应用的 request
+
+    float output;                   // 最近一次输出
+    uint32_t cycles_last;           // 最近一次处理的 CPU 周期数
+    uint32_t cycles_max;            // 处理的最大 CPU 周期数
+} SensorFilter_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化滤波器
+ * @param  filter: 滤波器
+ * @param  preset: IIR 预设
+ * @param  median: 中值窗口 (1/3/5)
+ * @retval None
+ * @note   在处理任务启动前调用
+ */
+void SensorFilter_Init(SensorFilter_t *filter, SensorFilter_Preset_t preset, uint8_t median);
+
+/**
+ * @brief  请求修改配置，在下一次 SensorFilter_Process 时生效 (滤波器状态重新预置)
+ * @param  filter: 滤波器
+ * @param  preset: IIR 预设
+ * @param  median: 中值窗口 (1/3/5)
+ * @retval 0: 已记录，-1: 参数超出范围
+ * @note   只能在一个任务中调用 (命令处理任务)
+ */
+int SensorFilter_Configure(SensorFilter_t *filter, SensorFilter_Preset_t preset, uint8_t median);
+
+/**
+ * @brief  丢弃滤波历史，下一个采样重新预置稳态
+ * @param  filter: 滤波器
+ * @retval None
+ * @note   在处理任务中调用
+ */
+void SensorFilter_Reset(SensorFilter_t *filter);
+
+/**
+ * @brief  处理一个采样
+ * @param  filter: 滤波器
+ * @param  input: 输入
+ * @param  periods: 与上一个采样相隔的设计采样周期数 (SENSOR_FILTER_TS_US)，0 按 1 处理，
+ *                  超过 SENSOR_FILTER_STEPS_MAX 时按 SENSOR_FILTER_STEPS_MAX
+ * @retval 滤波输出
+ * @note   中值预滤波只写入一次；IIR 以中值输出为保持值运行 periods 步
+ */
+float SensorFilter_Process(SensorFilter_t *filter, float input, uint32_t periods);
+
+/**
+ * @brief  获取预设的设计
+ * @param  preset: IIR 预设
+ * @retval 设计，预设无效时为 NULL
+ */
+const SensorFilter_Design_t *SensorFilter_GetDesign(SensorFilter_Preset_t preset);
+
+/**
+ * @brief  按名称查找预设
+ * @param  name: 预设名称 (off/lp200/lp100/lp50/lp50x4)
+ * @retval 预设，未找到时为 SENSOR_FILTER_PRESETS
+ */
+SensorFilter_Preset_t SensorFilter_FindPreset(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_FILTER_H */
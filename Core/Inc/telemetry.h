@@ -0,0 +1,171 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.h
+  * @brief          : Header for telemetry.c file.
+  *                   传感器数据上报 (JSON 文本 / 二进制帧)
+  ******************************************************************************
+  * @attention
+  *
+  * 默认使用 JSON 文本模式，与《上位机需求文档》中的三条 JSON 消息一致；
+  * 二进制模式下每周期只发送一帧 TLM_FRAME_TYPE_SAMPLE，帧格式见 tlm_frame.h。
+  * 模式和上报周期可通过 USART2 命令在运行时修改。
+  *
+  * 上报通道:
+  *   - TELEMETRY_ROUTE_CONSOLE: 与文本消息、命令应答共用 USART2 (缺省)
+  *   - TELEMETRY_ROUTE_DATA:    采样固定以二进制帧经 USART1 DMA 发送 (921600)，
+  *                              USART2 只保留文本和命令，大量调试输出不会延迟或打断数据流
+  * 编译时定义 TELEMETRY_DATA_UART1 (CMake 选项同名) 时缺省使用数据通道。
+  *
+  * 采集任务与上报任务解耦 (零拷贝):
+  *   1. 采集任务 Telemetry_Alloc() 从预分配缓冲池取一个槽 (不阻塞，池空时本次丢弃)
+  *   2. 直接在槽内填写采样，Telemetry_Post() 把槽指针放入待发队列
+  *   3. 低优先级上报任务 Telemetry_Process() 取出指针，格式化/组帧并写入串口，
+  *      完成后把槽归还缓冲池
+  * 队列中只传递指针，采样数据不拷贝；采集任务不做任何格式化和串口操作。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "tlm_frame.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TELEMETRY_PERIOD_DEFAULT_MS   500     // 缺省上报周期 (与采集任务周期相同)
+#define TELEMETRY_PERIOD_MAX_MS       60000   // 最大上报周期
+#define TELEMETRY_POOL_SIZE           4       // 采样缓冲池槽数 (同时也是待发队列深度)
+
+#ifdef TELEMETRY_DATA_UART1
+#define TELEMETRY_ROUTE_DEFAULT       TELEMETRY_ROUTE_DATA
+#else
+#define TELEMETRY_ROUTE_DEFAULT       TELEMETRY_ROUTE_CONSOLE
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 上报模式
+ */
+typedef enum {
+    TELEMETRY_MODE_JSON = 0,    // 每周期三条 JSON 文本
+    TELEMETRY_MODE_BINARY       // 每周期一帧 COBS 二进制帧
+} Telemetry_Mode_t;
+
+/**
+ * @brief 上报通道
+ */
+typedef enum {
+    TELEMETRY_ROUTE_CONSOLE = 0,    // USART2，按上报模式发送
+    TELEMETRY_ROUTE_DATA            // USART1，始终发送二进制帧
+} Telemetry_Route_t;
+
+/**
+ * @brief 采样缓冲槽
+ */
+typedef struct {
+    TlmSample_t sample;     // 采样记录 (由采集任务填写)
+    TlmThermal_t thermal;   // 多通道温控状态 (由采集任务填写，mask 为 0 时不发送)
+    uint32_t tick;          // 采样时刻 (ms)，Telemetry_Post 时记录
+} Telemetry_Slot_t;
+
+/**
+ * @brief 上报统计
+ */
+typedef struct {
+    uint32_t posted;        // 已提交的采样数
+    uint32_t sent;          // 已发送的采样数
+    uint32_t skipped;       // 未到上报周期而跳过的采样数
+    uint32_t dropped;       // 缓冲池空 (上报任务来不及处理) 而丢弃的采样数
+    uint32_t queued;        // 当前待发队列深度
+    uint32_t queue_high;    // 待发队列最大深度
+} Telemetry_Stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  创建缓冲池和待发队列 (静态分配)
+ * @retval None
+ * @note   在 MX_FREERTOS_Init 中、任务创建前调用
+ */
+void Telemetry_Init(void);
+
+/**
+ * @brief  从缓冲池取一个空闲槽 (不阻塞)
+ * @retval 空闲槽，池空时返回 NULL 并计入丢弃
+ */
+Telemetry_Slot_t *Telemetry_Alloc(void);
+
+/**
+ * @brief  提交已填写的槽，交给上报任务发送
+ * @param  slot: Telemetry_Alloc 取得的槽
+ * @retval None
+ */
+void Telemetry_Post(Telemetry_Slot_t *slot);
+
+/**
+ * @brief  等待并发送一个采样，发送后归还缓冲槽 (上报任务中循环调用)
+ * @param  wait_ticks: 最长等待时间 (系统节拍)
+ * @retval None
+ */
+void Telemetry_Process(uint32_t wait_ticks);
+
+/**
+ * @brief  获取上报统计
+ * @param  stats: 输出统计信息
+ * @retval None
+ */
+void Telemetry_GetStats(Telemetry_Stats_t *stats);
+
+
+/**
+ * @brief  设置上报模式
+ * @param  mode: TELEMETRY_MODE_JSON / TELEMETRY_MODE_BINARY
+ * @retval None
+ */
+void Telemetry_SetMode(Telemetry_Mode_t mode);
+
+/**
+ * @brief  获取当前上报模式
+ * @retval 当前模式
+ */
+Telemetry_Mode_t Telemetry_GetMode(void);
+
+/**
+ * @brief  设置上报通道
+ * @param  route: TELEMETRY_ROUTE_CONSOLE / TELEMETRY_ROUTE_DATA
+ * @retval None
+ */
+void Telemetry_SetRoute(Telemetry_Route_t route);
+
+/**
+ * @brief  获取当前上报通道
+ * @retval 当前通道
+ */
+Telemetry_Route_t Telemetry_GetRoute(void);
+
+/**
+ * @brief  设置上报周期
+ * @param  period_ms: 上报周期 (ms)，0 表示停止上报
+ * @retval None
+ * @note   实际上报间隔不会短于采集任务的采样周期
+ */
+void Telemetry_SetPeriod(uint32_t period_ms);
+
+/**
+ * @brief  获取上报周期
+ * @retval 上报周期 (ms)，0 表示已停止
+ */
+uint32_t Telemetry_GetPeriod(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_H */
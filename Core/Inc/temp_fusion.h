@@ -0,0 +1,133 @@
+/**
+  ******************************************************************************
+  * @file           : temp_fusion.h
+  * @brief          : Header for temp_fusion.c file.
+  *                   NTC 与 WF5803F 温度的卡尔曼融合
+  ******************************************************************************
+  * @attention
+  *
+  * 状态 x = [T, dT/dt] (°C, °C/s)，匀速模型 (白噪声加速度，谱密度 q):
+  *   F = | 1  dt |      Q = q * | dt^3/3  dt^2/2 |
+  *       | 0   1 |              | dt^2/2  dt     |
+  * 观测 z = H x + v，每个有效传感器一行 H = [1 0]:
+  *   NTC:     z = T                      方差 r_ntc
+  *   WF5803F: z = T + wf_offset          方差 r_wf
+  * 每次先按实测间隔 dt 预测再按有效观测 (1 或 2 行) 更新，矩阵运算用 CMSIS-DSP arm_mat_*_f32。
+  * 与低通滤波相比，速度状态使升温/降温斜坡上的估计没有稳态滞后。
+  *
+  * 新息统计: 每个传感器的新息 y = z - H x 的均值和标准差 (指数平均，1/TEMP_FUSION_STAT_N)，
+  * 以及归一化新息平方 NIS = y' S^-1 y / m 的平均值；噪声模型合适时 NIS 约为 1，
+  * 明显大于 1 说明 r/q 偏小，远小于 1 说明偏大；新息均值偏离 0 说明 wf_offset 不对。
+  *
+  * 噪声参数由命令任务经 TempFusion_SetNoise 修改 (临界区内写三个 float)，
+  * 下一次 TempFusion_Update 生效，不重置状态。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __TEMP_FUSION_H
+#define __TEMP_FUSION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "arm_math.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TEMP_FUSION_DT_S            0.5f        // 缺省更新间隔 (s)，没有实测间隔时使用
+#define TEMP_FUSION_Q               1.0e-4f     // 缺省过程噪声 q (°C^2/s^3)
+#define TEMP_FUSION_R_NTC           0.01f       // 缺省 NTC 观测方差 (°C^2，标准差 0.1°C)
+#define TEMP_FUSION_R_WF            0.04f       // 缺省 WF5803F 观测方差 (°C^2，标准差 0.2°C)
+#define TEMP_FUSION_WF_OFFSET       0.0f        // WF5803F 读数相对 NTC 的偏差 (°C)
+#define TEMP_FUSION_P0_RATE         1.0f        // 初始速度方差 ((°C/s)^2)
+#define TEMP_FUSION_STAT_N          64          // 新息统计的指数平均长度
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 观测源
+ */
+typedef enum {
+    TEMP_FUSION_NTC = 0,
+    TEMP_FUSION_WF,
+    TEMP_FUSION_SOURCES
+} TempFusion_Source_t;
+
+/**
+ * @brief 单个观测源的新息统计
+ */
+typedef struct {
+    float last;                 // 最近一次新息 (°C)
+    float mean;                 // 新息均值 (指数平均)
+    float var;                  // 新息方差 (指数平均)
+    uint32_t count;             // 参与更新的观测数
+} TempFusion_Innov_t;
+
+/**
+ * @brief 融合滤波器
+ */
+typedef struct {
+    float x[2];                 // 状态 [T, dT/dt]
+    float P[4];                 // 协方差 (行优先 2x2)
+    arm_matrix_instance_f32 mx;
+    arm_matrix_instance_f32 mP;
+
+    float q;                    // 过程噪声
+    float r[TEMP_FUSION_SOURCES];   // 观测方差
+    float wf_offset;            // WF5803F 偏差
+
+    uint8_t primed;             // 0: 下一个有效观测用于初始化状态
+    TempFusion_Innov_t innov[TEMP_FUSION_SOURCES];
+    float nis;                  // 归一化新息平方 (指数平均)
+
+    uint32_t cycles_last;       // 最近一次更新的 CPU 周期数
+    uint32_t cycles_max;        // 更新的最大 CPU 周期数
+} TempFusion_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化 (缺省噪声参数，状态待第一个有效观测初始化)
+ * @param  kf: 滤波器
+ * @retval None
+ */
+void TempFusion_Init(TempFusion_t *kf);
+
+/**
+ * @brief  丢弃状态，下一个有效观测重新初始化 (统计保留)
+ * @param  kf: 滤波器
+ * @retval None
+ * @note   在处理任务中调用
+ */
+void TempFusion_Reset(TempFusion_t *kf);
+
+/**
+ * @brief  修改噪声参数
+ * @param  kf: 滤波器
+ * @param  q: 过程噪声 (°C^2/s^3)
+ * @param  r_ntc: NTC 观测方差 (°C^2)
+ * @param  r_wf: WF5803F 观测方差 (°C^2)
+ * @retval 0: 成功，-1: 参数不为正
+ */
+int TempFusion_SetNoise(TempFusion_t *kf, float q, float r_ntc, float r_wf);
+
+/**
+ * @brief  一个周期: 预测并用有效观测更新
+ * @param  kf: 滤波器
+ * @param  dt: 与上一次更新的实测间隔 (s)，<= 0 时按 TEMP_FUSION_DT_S
+ * @param  t_ntc: NTC 温度 (°C)
+ * @param  ntc_ok: NTC 是否有效
+ * @param  t_wf: WF5803F 温度 (°C)
+ * @param  wf_ok: WF5803F 是否有效
+ * @retval 温度估计 (°C)；从未有过有效观测时返回 t_ntc
+ */
+float TempFusion_Update(TempFusion_t *kf, float dt, float t_ntc, uint8_t ntc_ok, float t_wf, uint8_t wf_ok);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TEMP_FUSION_H */
@@ -8,6 +8,36 @@
   *
   * 此文件包含温度PID控制相关的配置参数、数据结构和函数声明
   *
+  * 多通道: 通道表 tempctrl_ch[] 的每一项把一路 NTC 输入 (ADC 扫描通道) 经过
+  * 滤波级 (SensorFilter_t) 接到一个 PID_Controller_t，再输出到一路 TIM3 PWM:
+  *
+  *   通道 | NTC 输入      | PWM 输出
+  *   1    | PA0 ADC1_IN0  | PC6 TIM3_CH1 (NMOS1)
+  *   2    | PA1 ADC1_IN1  | PC7 TIM3_CH2 (NMOS2)
+  *   3    | PA2 ADC1_IN2  | PC8 TIM3_CH3 (NMOS3)
+  *   4    | PA3 ADC1_IN3  | PC9 TIM3_CH4 (NMOS4)
+  *
+  * TempCtrl_Update 每个控制周期一次处理全部通道。上电时只启用通道 1，
+  * 其他通道接好 NTC 和加热负载后用 "ch <n> on" 启用 (未接 NTC 的输入读数无意义)。
+  *
+  * 每个启用通道的换算温度先经 SensorCheck_Update (sensor_check.h) 检查，NTC 开路/短路、
+  * 超量程、跳变或卡死时该通道进入安全状态: PWM 置 0、PID 清零、滤波器不更新；
+  * 连续 TEMPCTRL_NTC_RECOVER 个有效采样后滤波器重新预置并恢复控制。
+  *
+  * 卡尔曼融合 (temp_fusion.h): 通道 TEMPCTRL_FUSION_CH 的 NTC 温度与 WF5803F 温度
+  * (TempCtrl_SetReference 提供) 融合为一个估计。融合始终运行，tempctrl_fusion_enabled
+  * 为 1 时 PID 输入用融合估计，为 0 时用滤波级输出 (命令 "kf on|off")。
+  *
+  * 时间戳 (dwt_time.h): t_input 为 ADC 抽取时刻，t_sample 为读取时刻，t_output 为写 PWM
+  * 比较寄存器的时刻；t_output - t_input 即采样到输出的控制延迟。
+  *
+  * PID (pid_ctrl.h): 每个通道可选位置式浮点或 CMSIS-DSP 增量式 f32/q31/q15 后端
+  * (命令 "pid")，pid_cycles_last/max 记录 PID_Compute 的实际耗时。
+  *
+  * 采样间隔: 每个通道只在有新的过采样结果 (t_input 变化) 时处理一次，
+  * PID 和融合使用相邻两次输入的实测抽取间隔 dt，不依赖控制周期 (ctrl_loop.h) 的设定值；
+  * 控制周期短于 ADC 抽取周期时，没有新结果的周期输出保持。
+  *
   ******************************************************************************
   */
 
@@ -22,35 +52,37 @@ extern "C" {
 #include "main.h"  
 #include "cmsis_os.h"
 #include "usart.h"
+#include "adc_scan.h"
+#include "sensor_filter.h"
+#include "sensor_check.h"
+#include "temp_fusion.h"
+#include "pid_ctrl.h"
 #include <math.h>
 #include <stdio.h>
 
-/* Exported variables --------------------------------------------------------*/
-// extern TIM_HandleTypeDef htim3;  // TIM3定时器句柄，用于PWM控制
-
 /* Exported types ------------------------------------------------------------*/
 
 /**
- * @brief PID控制器参数结构体
+ * @brief 温控通道 (NTC 输入 -> 滤波 -> PID -> PWM 输出)
  */
 typedef struct {
-    float Kp;           // 比例增益
-    float Ki;           // 积分增益
-    float Kd;           // 微分增益
-    
-    float setpoint;     // 目标温度 (°C)
-    float integral;     // 积分累积值
-    float prev_error;   // 上次误差值
-    
-    float output;       // PID输出值 (0-100)
-    float output_limit_max;  // 输出上限
-    float output_limit_min;  // 输出下限
-    
-    float integral_limit_max;  // 积分限幅最大值
-    float integral_limit_min;  // 积分限幅最小值
-    
-    uint32_t sample_time_ms;   // 采样周期(ms)
-} PID_Controller_t;
+    AdcScan_Channel_t adc;      // NTC 输入 (ADC 扫描通道)
+    uint32_t tim_channel;       // TIM3 输出通道
+    volatile uint8_t enabled;   // 1: 参与控制，0: 输出保持关断 (命令任务修改)
+    uint8_t active;             // 控制任务已应用的 enabled，变化时复位 PID 和滤波器
+    SensorFilter_t filter;      // 温度滤波 (PID 输入)
+    SensorCheck_t check;        // NTC 有效性检查，有故障时输出关断
+    PID_Controller_t pid;
+    float temp_raw;             // 换算温度 (°C，未滤波)
+    float temp;                 // 滤波后 (或融合) 温度 (°C，PID 输入)
+    uint64_t t_input;           // 本周期所用过采样结果的抽取时刻 (DwtTime_Now)
+    uint64_t t_sample;          // 本周期读取输入的时刻
+    uint64_t t_output;          // 最近一次按 PID 输出更新 PWM 的时刻
+    uint64_t t_pid;             // 上一次 PID 计算所用输入的抽取时刻，0: PID 刚复位
+    float dt;                   // 最近一次 PID 计算的实测采样间隔 (s)
+    uint32_t pid_cycles_last;   // 最近一次 PID_Compute 的 CPU 周期数
+    uint32_t pid_cycles_max;    // PID_Compute 的最大 CPU 周期数
+} TempCtrl_Channel_t;
 
 /* Exported constants --------------------------------------------------------*/
 
@@ -80,8 +112,25 @@ typedef struct {
 //     #define PID_KD              PID_KD_HIGH
 // #endif
 
+/* 通道配置 */
+#define TEMPCTRL_CHANNELS       4                       // 温控通道数 (NTC1~4 / TIM3_CH1~4)
+#define TEMPCTRL_FILTER_PRESET  SENSOR_FILTER_LP200     // 缺省滤波: 2 阶低通 0.2Hz
+#define TEMPCTRL_FILTER_MEDIAN  3                       // 缺省中值窗口
+#define TEMPCTRL_FUSION_CH      0                       // 与 WF5803F 温度融合的通道下标 (CH1)
+#define TEMPCTRL_FUSION_ENABLE  1                       // 缺省用融合估计作为 PID 输入
+#define TEMPCTRL_PID_BACKEND    PID_BACKEND_POS         // 缺省 PID 后端 (pid_ctrl.h)
+
+/* NTC 有效性检查门限 (每个新的过采样结果一个采样，间隔 ADC_SCAN_OVS_N / ADC_SCAN_RATE_HZ = 256ms) */
+#define TEMPCTRL_NTC_MIN        (-40.0f)                // 量程下限 (°C)，开路读数 -55°C
+#define TEMPCTRL_NTC_MAX        125.0f                  // 量程上限 (°C)，短路读数 127°C
+#define TEMPCTRL_NTC_RATE_PER_S 10.0f                   // 最大变化速率 (°C/s)
+#define TEMPCTRL_NTC_STUCK_S    60U                     // 读数完全不变超过此时间判为卡死 (s)
+#define TEMPCTRL_NTC_RATE_MAX   (TEMPCTRL_NTC_RATE_PER_S * ADC_SCAN_OVS_N / ADC_SCAN_RATE_HZ)  // 相邻采样最大变化 (2.56°C)
+#define TEMPCTRL_NTC_STUCK_N    (TEMPCTRL_NTC_STUCK_S * ADC_SCAN_RATE_HZ / ADC_SCAN_OVS_N)     // 卡死采样数 (234)
+#define TEMPCTRL_NTC_RECOVER    4                       // 连续 4 个有效采样 (约 1s) 后恢复控制
+
 /* PID控制器配置 */
-#define PID_SAMPLE_TIME_MS      100     // PID采样周期 (ms)
+#define PID_SAMPLE_TIME_MS      500     // 标称采样周期 (ms)，只在没有实测间隔时使用
 #define PID_OUTPUT_MAX          1000.0f // PID输出上限 (1000ms = 全功率)
 #define PID_OUTPUT_MIN          0.0f    // PID输出下限 (0ms = 关闭)
 #define PID_INTEGRAL_MAX        500.0f  // 积分限幅最大值
@@ -93,10 +142,16 @@ typedef struct {
 #define PWM_MAX_DUTY_MS         1000    // 最大占空比 (1000ms)
 
 /* 温度控制配置 */
-#define TEMP_DEADBAND           0.2f    // 温度死区 (°C)，在目标温度±死区内不调整
+#define TEMP_DEADBAND           0.2f    // 缺省温度死区 (°C)，在目标温度±死区内不调整
 #define TEMP_EMERGENCY_MAX      80.0f   // 紧急最高温度限制 (°C)
 #define TEMP_SAFE_SHUTDOWN      75.0f   // 安全关机温度 (°C)
 
+/* Exported variables --------------------------------------------------------*/
+// extern TIM_HandleTypeDef htim3;  // TIM3定时器句柄，用于PWM控制
+extern TempCtrl_Channel_t tempctrl_ch[TEMPCTRL_CHANNELS];   // 温控通道表
+extern TempFusion_t tempctrl_fusion;                        // 通道 TEMPCTRL_FUSION_CH 的融合滤波器
+extern volatile uint8_t tempctrl_fusion_enabled;            // 1: PID 输入用融合估计 (命令任务修改)
+
 /* Exported macro ------------------------------------------------------------*/
 
 /* Exported functions prototypes ---------------------------------------------*/
@@ -109,47 +164,48 @@ typedef struct {
 void PID_Init(PID_Controller_t *pid);
 
 /**
- * @brief  PID控制器计算
- * @param  pid: PID控制器结构体指针
- * @param  measured_value: 当前测量的温度值
- * @retval PID输出值 (0-1000ms)
+ * @brief  设置加热MOS管硬件PWM占空比
+ * @param  ch: 通道下标 (0 ~ TEMPCTRL_CHANNELS-1)
+ * @param  duty_ms: 1000ms周期内的导通毫秒数 (0-1000ms)
+ * @retval None
+ * @note   使用TIM3硬件PWM输出，无需周期调用
  */
-float PID_Compute(PID_Controller_t *pid, float measured_value);
+void Set_Heating_PWM(uint8_t ch, uint16_t duty_ms);
 
 /**
- * @brief  设置PID目标温度
- * @param  pid: PID控制器结构体指针
- * @param  setpoint: 目标温度
+ * @brief  紧急关闭加热 (全部通道)
  * @retval None
  */
-void PID_SetSetpoint(PID_Controller_t *pid, float setpoint);
+void TempCtrl_EmergencyStop(void);
 
 /**
- * @brief  重置PID控制器
- * @param  pid: PID控制器结构体指针
+ * @brief  初始化温度控制系统 (全部通道的 PID、滤波器和 PWM 输出，启用通道 1)
  * @retval None
  */
-void PID_Reset(PID_Controller_t *pid);
+void TempCtrl_Init(void);
 
 /**
- * @brief  设置加热MOS管硬件PWM占空比
- * @param  duty_ms: 1000ms周期内的导通毫秒数 (0-1000ms)
+ * @brief  提供新的 WF5803F 温度 (融合通道的第二个观测，在下一个 NTC 采样的融合中使用一次)
+ * @param  temp: WF5803F 温度 (°C)
+ * @param  valid: 1: 读取成功且检查通过
  * @retval None
- * @note   使用TIM3硬件PWM输出，无需周期调用
+ * @note   在采集任务中、每次读取 WF5803F 后调用
  */
-void Set_Heating_PWM(uint16_t duty_ms);
+void TempCtrl_SetReference(float temp, uint8_t valid);
 
 /**
- * @brief  紧急关闭加热
+ * @brief  一个控制周期: 全部通道读取 NTC、滤波、PID 计算并更新 PWM
  * @retval None
+ * @note   仅在采集任务中调用；未启用或传感器故障的通道输出保持关断
  */
-void TempCtrl_EmergencyStop(PID_Controller_t *pid);
+void TempCtrl_Update(void);
 
 /**
- * @brief  初始化温度控制系统
- * @retval None
+ * @brief  获取通道
+ * @param  ch: 通道号 (1 ~ TEMPCTRL_CHANNELS)
+ * @retval 通道，通道号无效时为 NULL
  */
-void TempCtrl_Init(PID_Controller_t *pid);
+TempCtrl_Channel_t *TempCtrl_GetChannel(uint32_t ch);
 
 /**
  * @brief  获取PID控制器指针（用于外部调整PID参数）
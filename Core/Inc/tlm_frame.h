@@ -0,0 +1,178 @@
+/**
+  ******************************************************************************
+  * @file           : tlm_frame.h
+  * @brief          : Header for tlm_frame.c file.
+  *                   二进制遥测帧格式定义 (COBS + CRC16)
+  ******************************************************************************
+  * @attention
+  *
+  * 此文件不依赖 HAL，固件与上位机解码库 (Host/) 共用同一份定义。
+  *
+  * 串口上的一帧:
+  *   0x00 | COBS( 帧头 | 负载 | CRC16 ) | 0x00
+  *
+  * - 帧头/负载/CRC 均为小端、紧凑排列
+  * - CRC16 为 CRC-16/CCITT-FALSE (多项式 0x1021，初值 0xFFFF)，覆盖帧头和负载
+  * - COBS 编码后帧内不含 0x00，前后各一个 0x00 作为分隔符，
+  *   因此二进制帧可以与普通文本消息混合在同一串口上传输
+  *
+  * 负载布局变化时 TLM_FRAME_VERSION 加 1，新字段只追加在末尾；上位机按帧头版本解码
+  * TLM_FRAME_VERSION_MIN 以来的各版本:
+  * - 版本 1: 采样记录 16 字节 (wf_temp ~ pid_output)
+  * - 版本 2: 采样记录 20 字节 (增加 fault)
+  * - 版本 3: 采样记录 40 字节 (增加 t_cycles、age_cycles、ctl_cycles、wf_cycles)
+  *
+  ******************************************************************************
+  */
+
+#ifndef __TLM_FRAME_H
+#define __TLM_FRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define TLM_FRAME_VERSION         3       // 帧格式版本
+#define TLM_FRAME_VERSION_MIN     1       // 上位机仍可解码的最早版本
+#define TLM_FRAME_DELIMITER       0x00    // 帧分隔符
+#define TLM_CPU_HZ                72000000U  // 采样记录中周期计数的频率 (SYSCLK)
+
+/* 帧类型 */
+#define TLM_FRAME_TYPE_SAMPLE     0x01    // 传感器采样记录
+#define TLM_FRAME_TYPE_LOG        0x02    // 延迟格式化日志 (见 dlog.h)
+#define TLM_FRAME_TYPE_PROBE      0x03    // 波特率协商探测帧 (见 baud_neg.h)
+#define TLM_FRAME_TYPE_THERMAL    0x04    // 多通道温控状态 (见 temp_pid_ctrl.h)
+
+#define TLM_FRAME_RAW_MAX         64      // 未编码帧最大长度 (帧头+负载+CRC)
+#define TLM_FRAME_PAYLOAD_MAX     (TLM_FRAME_RAW_MAX - 8 - 2)  // 去掉帧头和 CRC
+#define TLM_COBS_MAX(n)           ((n) + ((n) / 254) + 1)
+#define TLM_FRAME_WIRE_MAX        (TLM_COBS_MAX(TLM_FRAME_RAW_MAX) + 2)  // 含前后分隔符
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 帧头
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t  type;          // 帧类型 TLM_FRAME_TYPE_xxx
+    uint8_t  version;       // TLM_FRAME_VERSION
+    uint16_t seq;           // 序号，同一帧类型每帧加1，用于上位机检测丢帧
+    uint32_t timestamp_ms;  // 设备时间戳 (ms，系统节拍)
+} TlmFrameHeader_t;
+
+/**
+ * @brief 传感器采样记录 (对应原先每周期的三条 JSON 消息)
+ */
+typedef struct __attribute__((packed)) {
+    float wf_temp;      // WF5803F 温度 (°C)
+    float wf_press;     // WF5803F 气压 (kPa)
+    float ntc_temp;     // NTC 温度 (°C)
+    float pid_output;   // PID 输出 (0-1000ms)
+    uint32_t fault;     // 传感器故障，每个传感器 4 位 (SENSOR_FAULT_xxx，见 sensor_check.h)，0 表示全部有效
+    uint64_t t_cycles;  // 控制周期读取输入的时刻 (CPU 周期，见 dwt_time.h)，相邻采样之差即采样间隔
+    uint32_t age_cycles;  // 输入数据年龄: t_cycles - NTC 过采样抽取时刻
+    uint32_t ctl_cycles;  // 读取输入到更新 PWM 的周期数 (通道1，本周期未输出时为 0)
+    uint32_t wf_cycles;   // WF5803F 启动采集到完成的周期数 (I2C 延迟，读取失败时为 0)
+} TlmSample_t;
+
+/* 各版本的采样记录长度 (旧版本为 TlmSample_t 的前缀) */
+#define TLM_SAMPLE_SIZE_V1        16U
+#define TLM_SAMPLE_SIZE_V2        20U
+#define TLM_SAMPLE_VERSION_CYCLES 3       // 采样记录自此版本起带周期计数字段 (t_cycles 等)
+
+/* TlmSample_t.fault 中各传感器的位置 */
+#define TLM_FAULT_SHIFT_NTC(n)    (4U * (n))  // NTC1~4 (n = 0~3)，未启用的通道为 0
+#define TLM_FAULT_SHIFT_WF        16U         // WF5803F
+
+#define TLM_THERMAL_CHANNELS      4       // 温控通道数 (与 TEMPCTRL_CHANNELS 一致)
+
+/**
+ * @brief 单个温控通道的状态
+ */
+typedef struct __attribute__((packed)) {
+    float temp;         // 滤波后温度 (°C，PID 输入)
+    float setpoint;     // 目标温度 (°C)
+    float output;       // PID 输出 (0-1000ms)
+} TlmThermalChannel_t;
+
+/**
+ * @brief 多通道温控状态 (有通道 2~4 启用时随采样记录一起发送)
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t mask;       // 启用的通道，bit0 = 通道1；未启用通道的数据无意义
+    TlmThermalChannel_t ch[TLM_THERMAL_CHANNELS];
+} TlmThermal_t;
+
+/**
+ * @brief 波特率协商探测帧负载
+ * @note  pattern 覆盖全 0/全 1/交替位，COBS+CRC 校验通过即说明新波特率下收发无误
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t baud;          // 设备当前波特率
+    uint8_t  pattern[8];    // TLM_PROBE_PATTERN
+} TlmProbe_t;
+
+#define TLM_PROBE_PATTERN         { 0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0, 0x33, 0xCC }
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  计算 CRC-16/CCITT-FALSE
+ * @param  crc: 初值 (首次调用传 0xFFFF)
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval CRC 值
+ */
+uint16_t TlmFrame_Crc16(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief  COBS 编码
+ * @param  src: 原始数据
+ * @param  len: 原始数据长度
+ * @param  dst: 输出缓冲区，至少 TLM_COBS_MAX(len) 字节
+ * @retval 编码后长度 (不含分隔符)
+ */
+size_t TlmFrame_CobsEncode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/**
+ * @brief  COBS 解码
+ * @param  src: 编码数据 (不含分隔符)
+ * @param  len: 编码数据长度
+ * @param  dst: 输出缓冲区，至少 len 字节
+ * @retval 解码后长度，数据非法时返回 0
+ */
+size_t TlmFrame_CobsDecode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/**
+ * @brief  组装完整的线上帧 (含 CRC、COBS 编码及前后分隔符)
+ * @param  type: 帧类型
+ * @param  seq: 序号
+ * @param  timestamp_ms: 设备时间戳
+ * @param  payload: 负载
+ * @param  payload_len: 负载长度
+ * @param  out: 输出缓冲区，至少 TLM_FRAME_WIRE_MAX 字节
+ * @retval 帧总长度，负载过长时返回 0
+ */
+size_t TlmFrame_Build(uint8_t type, uint16_t seq, uint32_t timestamp_ms,
+                      const void *payload, size_t payload_len, uint8_t *out);
+
+/**
+ * @brief  解析一帧 (输入为两个分隔符之间的 COBS 数据)
+ * @param  src: 编码数据
+ * @param  len: 编码数据长度
+ * @param  header: 输出帧头
+ * @param  payload: 输出负载缓冲区，至少 TLM_FRAME_RAW_MAX 字节
+ * @retval 负载长度，COBS 非法或 CRC 错误时返回 -1
+ */
+int TlmFrame_Parse(const uint8_t *src, size_t len, TlmFrameHeader_t *header, uint8_t *payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TLM_FRAME_H */
@@ -0,0 +1,150 @@
+/**
+  ******************************************************************************
+  * @file           : uart_tx.h
+  * @brief          : Header for uart_tx.c file.
+  *                   串口 DMA 发送环形缓冲区（多生产者、无锁）
+  ******************************************************************************
+  * @attention
+  *
+  * 发送流程:
+  * - 任意任务调用 UartTx_Write() 把数据拷贝进环形缓冲区后立即返回
+  * - 缓冲区中已提交的数据由 DMA 连续发送，发送完成 (TC) 中断里继续启动下一段
+  * - 缓冲区满时整条消息丢弃，并累计溢出次数和丢弃字节数
+  * - DMA 发送出错时 HAL 中止发送，错误回调里丢弃正在发送的一段并继续发送后面的数据
+ * - UartTx_Pause/UartTx_Resume 暂停发送 (如强制切换波特率)，暂停期间写入的数据留在缓冲区
+  *
+  * 生产者之间不加锁：通过原子 CAS 预留空间，拷贝完成后再原子累加提交计数。
+  * 只有当全部预留都已提交时才启动 DMA，因此 DMA 永远不会发送未写完的数据。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __UART_TX_H
+#define __UART_TX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 发送统计信息
+ */
+typedef struct {
+    uint32_t sent_bytes;      // 已由 DMA 发送完成的字节数
+    uint32_t overflow_count;  // 因缓冲区满被丢弃的消息条数
+    uint32_t dropped_bytes;   // 因缓冲区满或 DMA 错误被丢弃的字节数
+    uint32_t error_count;     // DMA 发送错误次数
+    uint32_t high_water;      // 缓冲区最高占用 (字节)
+} UartTx_Stats_t;
+
+/**
+ * @brief 串口 DMA 发送环形缓冲区
+ * @note  reserve/commit/tail 均为单调递增的字节计数，取模后才是缓冲区下标
+ */
+typedef struct {
+    UART_HandleTypeDef *huart;  // 绑定的串口句柄 (需已配置 hdmatx)
+    uint8_t *buf;               // 环形缓冲区
+    uint32_t size;              // 缓冲区大小，必须为2的幂
+
+    atomic_uint reserve;        // 生产者已预留到的位置
+    atomic_uint commit;         // 生产者已写完的字节总数
+    atomic_uint tail;           // DMA 已发送到的位置
+    atomic_flag busy;           // DMA 正在发送 (或正在启动)，暂停后由暂停者持有
+    atomic_bool paused;         // 已暂停: 写入只进缓冲区，不启动 DMA
+    volatile uint32_t dma_len;  // 当前 DMA 传输长度
+
+    atomic_uint sent_bytes;
+    atomic_uint overflow_count;
+    atomic_uint dropped_bytes;
+    atomic_uint error_count;
+    volatile uint32_t high_water;
+} UartTx_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化发送环形缓冲区
+ * @param  tx: 发送结构体指针
+ * @param  huart: 串口句柄
+ * @param  buf: 缓冲区
+ * @param  size: 缓冲区大小 (2的幂)
+ * @retval None
+ */
+void UartTx_Init(UartTx_t *tx, UART_HandleTypeDef *huart, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief  写入一条消息（不阻塞）
+ * @param  tx: 发送结构体指针
+ * @param  data: 数据
+ * @param  len: 数据长度
+ * @retval 实际写入字节数，缓冲区不足时返回0（整条丢弃）
+ * @note   可在任意任务中并发调用，不可在优先级高于 DMA/串口中断的 ISR 中调用
+ */
+uint32_t UartTx_Write(UartTx_t *tx, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief  DMA 发送完成处理，在 HAL_UART_TxCpltCallback 中调用
+ * @param  tx: 发送结构体指针
+ * @retval None
+ */
+void UartTx_TxCpltHandler(UartTx_t *tx);
+
+/**
+ * @brief  DMA 发送出错处理，在 HAL_UART_ErrorCallback 中调用
+ * @param  tx: 发送结构体指针
+ * @retval None
+ * @note   只在发送 DMA 报告错误、发送已被 HAL 中止时生效: 丢弃当前一段并续发
+ */
+void UartTx_ErrorHandler(UartTx_t *tx);
+
+/**
+ * @brief  缓冲区中的数据是否已全部交给 DMA 发送完成
+ * @param  tx: 发送结构体指针
+ * @retval 1: 空闲，0: 仍有数据待发送或正在发送
+ * @note   只说明 DMA 已完成，移位寄存器中的最后一个字节需另查 UART_FLAG_TC
+ */
+int UartTx_IsIdle(UartTx_t *tx);
+
+/**
+ * @brief  暂停发送: 之后写入的数据只进缓冲区，不再启动新的 DMA
+ * @param  tx: 发送结构体指针
+ * @retval 1: 已暂停 (没有进行中的 DMA)，0: 当前一段仍在发送，稍后再调用
+ * @note   返回 1 后不要再调用，直到 UartTx_Resume；当前一段一直发不完时可用 UartTx_Abort 中止
+ */
+int UartTx_Pause(UartTx_t *tx);
+
+/**
+ * @brief  中止正在发送的一段并丢弃 (计入丢弃字节数)
+ * @param  tx: 发送结构体指针
+ * @retval None
+ * @note   只在 UartTx_Pause 返回 0 后调用，之后视为已暂停；调用 HAL_UART_AbortTransmit，只能在任务中调用
+ */
+void UartTx_Abort(UartTx_t *tx);
+
+/**
+ * @brief  恢复发送，暂停期间写入的数据随即发出
+ * @param  tx: 发送结构体指针
+ * @retval None
+ */
+void UartTx_Resume(UartTx_t *tx);
+
+/**
+ * @brief  获取发送统计信息
+ * @param  tx: 发送结构体指针
+ * @param  stats: 输出统计信息
+ * @retval None
+ */
+void UartTx_GetStats(UartTx_t *tx, UartTx_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_TX_H */
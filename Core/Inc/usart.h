@@ -34,17 +34,35 @@ extern "C" {
 #include <stdio.h>
 #include <string.h>
 #include "cmsis_os.h"
+#include "stream_buffer.h"
+#include "uart_tx.h"
+#include "dlog.h"
 /* USER CODE END Includes */
 
 extern UART_HandleTypeDef huart1;
 
 extern UART_HandleTypeDef huart2;
 
-extern uint8_t rx_byte;
+extern StreamBufferHandle_t usart_rx_streamHandle;  // USART2 接收流缓冲区句柄
 
-extern osMessageQId usart_rx_queueHandle;  // USART接收队列句柄
+extern UartTx_t uart2_tx;                  // USART2 DMA 发送引擎
+
+extern UartTx_t uart1_tx;                  // USART1 DMA 发送引擎 (数据通道，921600)
 /* USER CODE BEGIN Private defines */
 
+/**
+ * @brief USART2 接收统计
+ */
+typedef struct {
+    uint32_t rx_bytes;          // 收到的字节数
+    uint32_t chunks;            // DMA 事件 (半满/全满/空闲) 次数
+    uint32_t stream_overflow;   // 接收流缓冲区满而丢弃的字节数
+    uint32_t overrun;           // 串口硬件溢出 (ORE) 次数
+    uint32_t frame_err;         // 帧错误次数
+    uint32_t noise_err;         // 噪声错误次数
+    uint32_t restart_fail;      // 重新启动接收失败次数
+} UartRx_Stats_t;
+
 /* USER CODE END Private defines */
 
 void MX_USART1_UART_Init(void);
@@ -58,11 +76,52 @@ void MX_USART2_UART_Init(void);
  * @param  ...: 可变参数
  * @retval None
  * @note   使用示例: send_message("Temperature: %.2f°C\n", temp);
+ * @note   定义 LOG_DEFERRED 时 send_message 被 dlog.h 中的同名宏替换
+ */
+void (send_message)(const char *format, ...);
+
+
+/**
+ * @brief  启动 USART2 DMA 循环接收 (空闲线检测)
+ * @retval None
  */
-void send_message(const char *format, ...);
+void USART2_StartReceive(void);
 
+/**
+ * @brief  计算 USART2 在当前 PCLK1 下实际能达到的波特率
+ * @param  baud: 目标波特率
+ * @retval 实际波特率，超出范围或误差大于 2% 时返回 0
+ */
+uint32_t USART2_CheckBaudRate(uint32_t baud);
 
-void receive_message(char *buffer, size_t buffer_size);
+/**
+ * @brief  运行时修改 USART2 波特率
+ * @param  baud: 新波特率 (需先经 USART2_CheckBaudRate 检查)
+ * @retval HAL_OK: 已切换，HAL_TIMEOUT: 发送缓冲区未能排空，HAL_ERROR: 波特率不可用
+ * @note   等待发送缓冲区排空后切换，并重新启动 DMA 接收；只能在任务中调用
+ */
+HAL_StatusTypeDef USART2_SetBaudRate(uint32_t baud);
+
+/**
+ * @brief  不等发送缓冲区排空，强制修改 USART2 波特率
+ * @param  baud: 新波特率 (需先经 USART2_CheckBaudRate 检查)
+ * @retval HAL_OK: 已切换，HAL_ERROR: 波特率不可用
+ * @note   暂停发送后切换，当前一段 DMA 发不完时中止并丢弃；用于 USART2_SetBaudRate 反复超时后的恢复
+ */
+HAL_StatusTypeDef USART2_ForceBaudRate(uint32_t baud);
+
+/**
+ * @brief  获取 USART2 当前波特率
+ * @retval 波特率
+ */
+uint32_t USART2_GetBaudRate(void);
+
+/**
+ * @brief  获取 USART2 接收统计
+ * @param  stats: 输出统计信息
+ * @retval None
+ */
+void USART2_GetRxStats(UartRx_Stats_t *stats);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
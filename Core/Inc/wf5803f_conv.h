@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file           : wf5803f_conv.h
+  * @brief          : Header for wf5803f_conv.c file.
+  *                   WF5803F 原始数据定点换算 (按量程型号查表)
+  ******************************************************************************
+  * @attention
+  *
+  * 此文件不依赖 HAL，只用整数乘法和移位:
+  * - 压力 (Pa) = 量程 / 0.81 × (原始值 / 2^23 − 0.1) + 量程下限
+  *   通分为 P = (raw × k + c) / (81 × 2^23)，k = 量程 × 100，c 由量程和下限在编译期算出；
+  *   一次 32×32→64 位乘加 (SMLAL)，右移 23 位后除以常数 81 (编译为乘法和移位)，
+  *   结果与精确值四舍五入后逐位一致
+  * - 温度 (0.01℃) = 原始值 × 100 / 256，四舍五入
+  *
+  * 型号由编译选项 WF5803F_MODEL 选择 (CMake: -DWF5803F_MODEL=2BAR|7BAR)，缺省 2 bar。
+  *
+  ******************************************************************************
+  */
+
+#ifndef __WF5803F_CONV_H
+#define __WF5803F_CONV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define WF5803F_CONV_SHIFT      23      // 原始压力满量程 2^23
+#define WF5803F_CONV_DIV        81      // 公式中 0.81 的分母 (×100)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 量程型号
+ */
+typedef enum {
+    WF5803F_MODEL_2BAR = 0,             // 30 ~ 210 kPa
+    WF5803F_MODEL_7BAR,                 // 0 ~ 700 kPa
+    WF5803F_MODEL_COUNT
+} WF5803F_ModelId_t;
+
+/**
+ * @brief 型号换算参数
+ */
+typedef struct {
+    const char *name;                   // 型号名 ("2bar"...)
+    int32_t p_min_pa;                   // 量程下限 (Pa)
+    int32_t p_span_pa;                  // 量程 (Pa)
+    int32_t k;                          // 原始值系数 (量程 × 100)
+    int64_t c;                          // 常数项 (含四舍五入的半个单位)
+} WF5803F_Model_t;
+
+#ifndef WF5803F_MODEL
+#define WF5803F_MODEL           WF5803F_MODEL_2BAR
+#endif
+
+/* Exported variables --------------------------------------------------------*/
+extern const WF5803F_Model_t wf5803f_models[WF5803F_MODEL_COUNT];
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  原始压力换算为 Pa
+ * @param  model: 型号参数 (wf5803f_models 中的一项)
+ * @param  raw: 24 位原始数据 (高 8 位忽略)
+ * @retval 压力 (Pa)，四舍五入
+ */
+int32_t WF5803F_ConvPressure(const WF5803F_Model_t *model, int32_t raw);
+
+/**
+ * @brief  原始温度换算为 0.01℃
+ * @param  raw: 16 位有符号原始数据 (1/256 ℃)
+ * @retval 温度 (0.01℃)，四舍五入
+ */
+int32_t WF5803F_ConvTemperature(int16_t raw);
+
+/**
+ * @brief  当前编译选定的型号
+ * @retval 型号参数
+ */
+const WF5803F_Model_t *WF5803F_ConvModel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WF5803F_CONV_H */
@@ -1,56 +1,37 @@
 #include "NTC.h"
+#include "adc_scan.h"
 
 /**
- * @brief  根据 ADC 数值计算 NTC 温度
- * @param  adcValue  ADC 采样值 (0 ~ 4095 for 12-bit ADC)
- * @return 温度值，单位 摄氏度 (°C)
+ * @brief  读取 ADC1 的通道0 (PA0) 的值
+ * @return ADC 采样值 (0 ~ 4095 for 12-bit ADC)，定时器触发扫描缓冲区中最近 ADC_SCAN_DEPTH 个采样的平均值
  */
-float compute_ntc_temperature(uint32_t adcValue)
+uint32_t Read_ADC0(void)
 {
-    // 1. ADC 转电压
-    float vout = (adcValue / ADC_MAX_VALUE) * V_REF;
-
-    // 2. 由分压公式求 NTC 阻值
-    // R_ntc = R_series * Vout / (Vref - Vout)
-    float r_ntc = (NTC_R_SERIES * vout) / (V_REF - vout);
-
-    // 3. Beta 公式换算温度 (K)
-    float tempK = 1.0f / ( (1.0f/NTC_T0) + (1.0f/NTC_BETA) * logf(r_ntc / NTC_R0) );
+    return AdcScan_Average(ADC_SCAN_NTC1);
+}
 
-    // 4. 转换为摄氏度
-    float tempC = tempK - 273.15f;
+/**
+ * @brief  读取一路 NTC 输入的过采样值
+ * @param  ch  ADC 扫描通道 (ADC_SCAN_NTC1 ~ ADC_SCAN_NTC4)
+ * @return 0 ~ ADC_SCAN_OVS_MAX，最近 ADC_SCAN_OVS_N 个采样的 boxcar 抽取结果；
+ *         启动后尚无抽取结果时用缓冲区平均值左移补齐
+ */
+uint32_t NTC_ReadOversampled(AdcScan_Channel_t ch)
+{
+    uint32_t seq;
+    uint32_t value = AdcScan_Oversampled(ch, &seq);
 
-    return tempC;
+    if (seq == 0) {
+        value = (uint32_t)AdcScan_Average(ch) << ADC_SCAN_OVS_BITS;
+    }
+    return value;
 }
 
 /**
- * @brief  读取 ADC1 的通道0 (PA0) 的值
- * @return ADC 采样值 (0 ~ 4095 for 12-bit ADC)
+ * @brief  读取 ADC1 通道0 (PA0) 的过采样值
+ * @return 0 ~ ADC_SCAN_OVS_MAX
  */
-uint32_t Read_ADC0(void)
+uint32_t Read_ADC0_Oversampled(void)
 {
-    ADC_ChannelConfTypeDef sConfig = {0};
-    uint32_t adcValue = 0;
-    
-    // 配置 ADC 通道0 (PA0 - NTC)
-    sConfig.Channel = ADC_CHANNEL_0;
-    sConfig.Rank = 1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_84CYCLES;
-    
-    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) == HAL_OK)
-    {
-        // 启动 ADC 转换
-        HAL_ADC_Start(&hadc1);
-        
-        // 等待转换完成
-        if (HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK)
-        {
-            adcValue = HAL_ADC_GetValue(&hadc1);
-        }
-        
-        // 停止 ADC
-        HAL_ADC_Stop(&hadc1);
-    }
-    
-    return adcValue;
-}
\ No newline at end of file
+    return NTC_ReadOversampled(ADC_SCAN_NTC1);
+}
@@ -1,35 +1,14 @@
 #include "V_detect.h"
+#include "fmt.h"
+#include "adc_scan.h"
 
 /**
  * @brief  读取 ADC1 通道14 (PC4) 的电压
- * @return ADC 采样值 (0-4095)
+ * @return ADC 采样值 (0-4095)，定时器触发扫描缓冲区中最近 ADC_SCAN_DEPTH 个采样的平均值
  */
 uint32_t Read_VoltageADC(void)
 {
-    ADC_ChannelConfTypeDef sConfig = {0};
-    uint32_t adcValue = 0;
-    
-    // 配置 ADC 通道14 (PC4 - V_DETECT)
-    sConfig.Channel = ADC_CHANNEL_14;
-    sConfig.Rank = 1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_84CYCLES;
-    
-    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) == HAL_OK)
-    {
-        // 启动 ADC 转换
-        HAL_ADC_Start(&hadc1);
-        
-        // 等待转换完成 (超时 100ms)
-        if (HAL_ADC_PollForConversion(&hadc1, 100) == HAL_OK)
-        {
-            adcValue = HAL_ADC_GetValue(&hadc1);
-        }
-        
-        // 停止 ADC
-        HAL_ADC_Stop(&hadc1);
-    }
-    
-    return adcValue;
+    return AdcScan_Average(ADC_SCAN_VDET);
 }
 
 /**
@@ -65,21 +44,24 @@ float Calculate_SourceVoltage(uint32_t adcValue)
 void Send_VoltageWarning(float voltage, const char* message)
 {
     char uartMsg[80];
+    int len;
     
     // 根据 message 判断电压状态
     // message == "OK" 表示正常, 其他表示低压
     if (strcmp(message, "OK") == 0) {
         // 电压正常
-        snprintf(uartMsg, sizeof(uartMsg), 
+        len = Fmt_Snprintf(uartMsg, sizeof(uartMsg), 
                  "Power OK,voltage: %.2fV.\r\n", voltage);
     } else {
         // 电压不足
-        snprintf(uartMsg, sizeof(uartMsg), 
+        len = Fmt_Snprintf(uartMsg, sizeof(uartMsg), 
                  "Power Low,voltage: %.2fV,please charge.\r\n", voltage);
     }
 
-    // 通过 UART2 发送给上位机
-    HAL_UART_Transmit(&huart2, (uint8_t*)uartMsg, strlen(uartMsg), 1000);
+    // 通过 UART2 发送给上位机 (写入 DMA 发送环形缓冲区，不阻塞)
+    if (len > 0 && len < (int)sizeof(uartMsg)) {
+        UartTx_Write(&uart2_tx, (uint8_t*)uartMsg, (uint32_t)len);
+    }
 }
 
 /**
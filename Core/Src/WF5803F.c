@@ -1,82 +1,392 @@
 #include "WF5803F.h"
+#include "i2c_bus.h"
+#include "dwt_time.h"
 
 //需要对传感器寄存器0x30写入000b开始转换单次温度转换，001b开始单次气压转换
 //通过读取0x02寄存器的bit0(DRDY)值来判断是否转换完成,1表示完成
 //转换完成后读取温度和气压数据，原始温度数据Temp_out为16位，分为MSB和LSB。地址为0x09~0x0A
 //原始气压数据Press_out为24位，分为MSB、CSB和LSB。地址为0x06~0x08
-/*气压+温度读取*/
-void WF5803F_ReadDate(int16_t* Temp, int32_t* Press)
+/*
+ * 异步采集状态机 (不阻塞调用任务，不占用 CPU 轮询):
+ *
+ * 单次模式:
+ *   IDLE --Start--> WRITE_CTRL --TxCplt--> WAIT_CONV --定时器--> READ_BURST
+ *                                              ^                      |
+ *                                              +---- DRDY=0 ----------+
+ *   IDLE <--------------------发布结果------------------ DRDY=1 ------+
+ *
+ * 连续模式 (传感器按 ODR 自行周期转换):
+ *   IDLE --Start--> READ_BURST --DRDY=1 或已有转换结果--> 发布结果 --> IDLE
+ *
+ * - 传输都作为描述符提交到 i2c_bus1 的事务队列 (见 i2c_bus.h)，与总线上其他设备排队执行
+ * - READ_BURST 用一次 DMA 读出 0x02~0x0A (状态 + 3B 压力 + 2B 温度)，
+ *   查询 DRDY 和读取数据合并为一次传输
+ * - 传输完成回调和转换延时定时器都在定时器服务任务中执行，状态转移串行，无需加锁
+ * - 传输超时和总线恢复由总线层处理，每个提交成功的传输都会回调；
+ *   等待转换时从启动起计时，超过 WF5803F_TIMEOUT_MS 即结束并报告超时
+ */
+
+#define WF5803F_CMD_SCO       0x08        // 控制寄存器 bit3: 开始转换
+#define WF5803F_CMD_COMBINED  0x02        // measurement_ctrl: 单次气压+温度转换
+#define WF5803F_CMD_PERIODIC  0x03        // measurement_ctrl: 按 sleep_time 周期转换
+#define WF5803F_CMD_ONESHOT   (WF5803F_CMD_SCO | WF5803F_CMD_COMBINED)   // 0x0A
+#define WF5803F_CMD_STOP      0x00        // 停止周期转换
+#define WF5803F_STATUS_DRDY   0x01        // 状态寄存器 bit0: 转换完成
+#define WF5803F_OSR_MASK      0x07        // P_CONFIG bit[2:0]: 气压过采样率
+#define WF5803F_BURST_LEN     (WF5803F_REG_TEMP_MSB + 2 - WF5803F_REG_STATUS)   // 0x02~0x0A
+
+typedef enum {
+    WF5803F_STATE_IDLE = 0,
+    WF5803F_STATE_WRITE_CTRL,             // 正在写控制寄存器
+    WF5803F_STATE_WAIT_CONV,              // 等待转换 (定时器)
+    WF5803F_STATE_READ_BURST,             // 正在 DMA 读状态+数据
+    WF5803F_STATE_CONFIG                  // 正在修改配置 (阻塞读写)
+} WF5803F_State_t;
+
+typedef enum {
+    WF5803F_EVT_TX_DONE = 0,
+    WF5803F_EVT_RX_DONE,
+    WF5803F_EVT_ERROR,                    // 传输出错 (NACK/总线错误/提交失败)
+    WF5803F_EVT_XFER_TIMEOUT,             // 传输超时 (总线层已恢复总线)
+    WF5803F_EVT_TIMER
+} WF5803F_Event_t;
+
+static volatile WF5803F_State_t wf_state = WF5803F_STATE_IDLE;
+static uint8_t wf_cmd = WF5803F_CMD_ONESHOT;
+static uint8_t wf_buf[WF5803F_BURST_LEN]; // 状态 + 3B 保留 + 3B 压力 + 2B 温度
+static uint32_t wf_start_tick;
+static uint64_t wf_start_time;
+static I2cBus_Xfer_t wf_xfer;             // 同一时刻最多一个传输在总线队列中
+static uint8_t wf_have_data;              // 连续模式下已有一次完成的转换
+static WF5803F_Config_t wf_config = { WF5803F_MODE_SINGLE, 0, WF5803F_OSR_4096X };
+static WF5803F_Stats_t wf_stats;
+static WF5803F_Callback_t wf_callback;
+
+static TimerHandle_t wf_timer;
+static StaticTimer_t wf_timer_struct;
+static QueueHandle_t wf_queue;            // 最新一次结果 (长度1，覆盖写)
+static StaticQueue_t wf_queue_struct;
+static uint8_t wf_queue_storage[sizeof(WF5803F_Sample_t)];
+
+static void WF5803F_Step(WF5803F_Event_t event);
+
+/**
+ * @brief  定时器到期，推进状态机 (定时器服务任务)
+ */
+static void WF5803F_TimerCallback(TimerHandle_t timer)
 {
-    uint8_t cmd = 0x0A;                           // 单次气压+温度转换
-    uint8_t status;
-    uint8_t buf[5];
-
-    // 启动一次转换
-    HAL_I2C_Mem_Write(&hi2c1, WF5803F_ADDR, WF5803F_REG_CTRL,
-                      I2C_MEMADD_SIZE_8BIT, &cmd, 1, 100);
-
-    // 简单等待 + 轮询 DRDY bit0
-    osDelay(5);
-    do {
-        HAL_I2C_Mem_Read(&hi2c1, WF5803F_ADDR, WF5803F_REG_STATUS,
-                          I2C_MEMADD_SIZE_8BIT, &status, 1, 100);
-        osDelay(5);
-    } while ((status & 0x01) == 0);
-
-    // 一次性读出 5 字节（3B 压力 + 2B 温度）
-    HAL_I2C_Mem_Read(&hi2c1, WF5803F_ADDR, WF5803F_REG_PRESS_MSB,
-                      I2C_MEMADD_SIZE_8BIT, buf, 5, 100);
-
-    *Press = (int32_t)((uint32_t)buf[0] << 16 | (uint32_t)buf[1] << 8 | buf[2]); // 24bit
-    *Temp  = (int16_t)((uint16_t)buf[3] << 8 | buf[4]);                           // 16bit
+    WF5803F_Step(WF5803F_EVT_TIMER);
 }
 
 /**
- * @brief  将 32位有符号整数(只用低24位) 转换为压力
- * @param  rawData  32位整型数，存放传感器的24位原始数据
- * @return 压力值，单位 kPa
+ * @brief  传输完成，推进状态机 (定时器服务任务，总线层回调)
  */
-float compute_pressure_WF5803F_2BAR_fromInt(int32_t rawData) {
-    // 保留 24位数据
-    rawData &= 0x00FFFFFF;
+static void WF5803F_XferDone(I2cBus_Xfer_t *xfer)
+{
+    if (xfer->status == HAL_OK) {
+        WF5803F_Step(xfer->read ? WF5803F_EVT_RX_DONE : WF5803F_EVT_TX_DONE);
+    } else if (xfer->status == HAL_TIMEOUT) {
+        WF5803F_Step(WF5803F_EVT_XFER_TIMEOUT);
+    } else {
+        WF5803F_Step(WF5803F_EVT_ERROR);
+    }
+}
 
-    // 如果最高位 (bit23) 为1，则需要做符号扩展
-    if (rawData & 0x00800000) {
-        rawData |= 0xFF000000; // 扩展成32位有符号数
+/**
+ * @brief  定时器在 delay_ms 后到期 (不阻塞)
+ */
+static void WF5803F_ArmTimer(uint32_t delay_ms)
+{
+    if (delay_ms == 0) delay_ms = 1;
+    xTimerChangePeriod(wf_timer, pdMS_TO_TICKS(delay_ms), 0);
+}
+
+/**
+ * @brief  进入传输状态并提交传输 (READ_BURST: 读状态和数据寄存器，WRITE_CTRL: 启动单次转换)
+ * @return 0: 已提交，-1: 总线队列满
+ */
+static int WF5803F_Submit(WF5803F_State_t state)
+{
+    wf_state = state;
+    wf_xfer.addr = WF5803F_ADDR;
+    wf_xfer.callback = WF5803F_XferDone;
+    if (state == WF5803F_STATE_READ_BURST) {
+        wf_xfer.reg = WF5803F_REG_STATUS;
+        wf_xfer.read = 1;
+        wf_xfer.data = wf_buf;
+        wf_xfer.len = sizeof(wf_buf);
+    } else {
+        wf_xfer.reg = WF5803F_REG_CTRL;
+        wf_xfer.read = 0;
+        wf_xfer.data = &wf_cmd;
+        wf_xfer.len = 1;
     }
+    return (I2cBus_Submit(&i2c_bus1, &wf_xfer) == HAL_OK) ? 0 : -1;
+}
 
-    // 归一化到 [-1, +1)
-    float factor = (float)rawData / 8388608.0f;  // 除以 2^23
+/**
+ * @brief  结束本次采集并发布结果
+ */
+static void WF5803F_Finish(WF5803F_Result_t result)
+{
+    const uint8_t *press = &wf_buf[WF5803F_REG_PRESS_MSB - WF5803F_REG_STATUS];
+    const uint8_t *temp = &wf_buf[WF5803F_REG_TEMP_MSB - WF5803F_REG_STATUS];
+    WF5803F_Sample_t sample = {0};
 
-    // 固定公式（2bar型号，输出 kPa）
-    return 180.0f/0.81f*(factor-0.1f)+30.0f;
+    xTimerStop(wf_timer, 0);
+
+    sample.result = result;
+    sample.tick = HAL_GetTick();
+    sample.time = DwtTime_Now();
+    sample.cycles = (uint32_t)(sample.time - wf_start_time);
+    if (result == WF5803F_OK) {
+        sample.raw_press = (int32_t)((uint32_t)press[0] << 16 | (uint32_t)press[1] << 8 | press[2]); // 24bit
+        sample.raw_temp  = (int16_t)((uint16_t)temp[0] << 8 | temp[1]);                             // 16bit
+        sample.temp_centi = WF5803F_ConvTemperature(sample.raw_temp);
+        sample.pressure_pa = WF5803F_ConvPressure(WF5803F_ConvModel(), sample.raw_press);
+        sample.temperature = sample.temp_centi / 100.0f;
+        sample.pressure = sample.pressure_pa / 1000.0f;
+        wf_stats.completed++;
+    } else if (result == WF5803F_ERR_BUS) {
+        wf_stats.bus_errors++;
+    } else {
+        wf_stats.timeouts++;
+    }
+
+    wf_state = WF5803F_STATE_IDLE;
+    xQueueOverwrite(wf_queue, &sample);
+    if (wf_callback != NULL) {
+        wf_callback(&sample);
+    }
 }
 
-float compute_temperature_WF5803F_fromInt(int16_t rawData) {
-    // 如果最高位 (bit15) 为1，则需要做符号扩展
-    if (rawData & 0x00008000) {   // 如果bit15是1，表示负数
-        rawData |= 0xFFFF0000;    // 高16位填充1
+/**
+ * @brief  状态机单步 (只在定时器服务任务中执行)
+ * @param  event: 事件
+ */
+static void WF5803F_Step(WF5803F_Event_t event)
+{
+    uint32_t elapsed = HAL_GetTick() - wf_start_tick;
+
+    if (wf_state == WF5803F_STATE_IDLE || wf_state == WF5803F_STATE_CONFIG) {
+        return;
+    }
+
+    switch (event) {
+    case WF5803F_EVT_ERROR:
+        WF5803F_Finish(WF5803F_ERR_BUS);
+        return;
+
+    case WF5803F_EVT_XFER_TIMEOUT:
+        WF5803F_Finish(WF5803F_ERR_TIMEOUT);
+        return;
+
+    case WF5803F_EVT_TIMER:
+        if (wf_state != WF5803F_STATE_WAIT_CONV) {
+            return;   // 传输由总线层看门
+        }
+        if (elapsed >= WF5803F_TIMEOUT_MS) {
+            WF5803F_Finish(WF5803F_ERR_TIMEOUT);
+        } else if (WF5803F_Submit(WF5803F_STATE_READ_BURST) != 0) {
+            WF5803F_Finish(WF5803F_ERR_BUS);
+        }
+        return;
+
+    default:
+        break;
+    }
+
+    switch (wf_state) {
+    case WF5803F_STATE_WRITE_CTRL:
+        if (event != WF5803F_EVT_TX_DONE) break;
+        wf_state = WF5803F_STATE_WAIT_CONV;
+        WF5803F_ArmTimer(WF5803F_CONV_DELAY_MS);
+        break;
+
+    case WF5803F_STATE_READ_BURST:
+        if (event != WF5803F_EVT_RX_DONE) break;
+        // 连续模式下数据寄存器保存最近一次完成的转换，DRDY 已被上次读取清除时数据仍有效
+        if ((wf_buf[0] & WF5803F_STATUS_DRDY) != 0 ||
+            (wf_config.mode == WF5803F_MODE_CONTINUOUS && wf_have_data)) {
+            wf_have_data = (wf_config.mode == WF5803F_MODE_CONTINUOUS);
+            WF5803F_Finish(WF5803F_OK);
+            break;
+        }
+        wf_stats.drdy_retries++;
+        if (elapsed >= WF5803F_TIMEOUT_MS) {
+            WF5803F_Finish(WF5803F_ERR_TIMEOUT);
+            break;
+        }
+        wf_state = WF5803F_STATE_WAIT_CONV;
+        WF5803F_ArmTimer(WF5803F_POLL_MS);
+        break;
+
+    default:
+        break;
     }
+}
 
-    return (float)rawData / 256.0f; // 每个单位 = 1/256 ℃
+/**
+ * @brief  初始化异步采集 (在调度器启动前调用)
+ * @param  callback  采集完成回调，可为 NULL (只通过 WF5803F_WaitSample 获取结果)
+ */
+void WF5803F_Init(WF5803F_Callback_t callback)
+{
+    wf_callback = callback;
+    wf_timer = xTimerCreateStatic("wf5803f", pdMS_TO_TICKS(WF5803F_CONV_DELAY_MS), pdFALSE,
+                                  NULL, WF5803F_TimerCallback, &wf_timer_struct);
+    wf_queue = xQueueCreateStatic(1, sizeof(WF5803F_Sample_t), wf_queue_storage, &wf_queue_struct);
 }
 
 /**
- * @brief  直接获取计算后的温度和气压值
+ * @brief  设置转换模式、输出数据率和过采样率
+ * @param  config  配置，odr 为 sleep_time 编码 (0~15，周期约 odr×62.5ms + 转换时间)
+ * @return WF5803F_OK；WF5803F_ERR_BUSY: 采集进行中；WF5803F_ERR_BUS: 寄存器读写失败；
+ *         WF5803F_ERR_PARAM: 参数超出范围
+ * @note   经总线事务队列阻塞读写 (带超时和重试)，只能在任务中、调度器启动后调用
+ */
+WF5803F_Result_t WF5803F_Configure(const WF5803F_Config_t *config)
+{
+    uint8_t reg;
+    HAL_StatusTypeDef status;
+
+    if (config == NULL || config->odr > WF5803F_ODR_MAX || config->osr > WF5803F_OSR_32768X) {
+        return WF5803F_ERR_PARAM;
+    }
+
+    taskENTER_CRITICAL();
+    if (wf_state != WF5803F_STATE_IDLE) {
+        taskEXIT_CRITICAL();
+        return WF5803F_ERR_BUSY;
+    }
+    wf_state = WF5803F_STATE_CONFIG;
+    taskEXIT_CRITICAL();
+
+    // 1. 过采样率: 读-改-写 P_CONFIG，保留增益位
+    status = I2cBus_MemRead(&i2c_bus1, WF5803F_ADDR, WF5803F_REG_P_CONFIG, &reg, 1);
+    if (status == HAL_OK) {
+        reg = (uint8_t)((reg & ~WF5803F_OSR_MASK) | config->osr);
+        status = I2cBus_MemWrite(&i2c_bus1, WF5803F_ADDR, WF5803F_REG_P_CONFIG, &reg, 1);
+    }
+
+    // 2. 启动或停止周期转换
+    if (status == HAL_OK) {
+        reg = (config->mode == WF5803F_MODE_CONTINUOUS) ?
+              (uint8_t)((config->odr << 4) | WF5803F_CMD_SCO | WF5803F_CMD_PERIODIC) : WF5803F_CMD_STOP;
+        status = I2cBus_MemWrite(&i2c_bus1, WF5803F_ADDR, WF5803F_REG_CTRL, &reg, 1);
+    }
+
+    if (status == HAL_OK) {
+        wf_config = *config;
+    } else {
+        wf_stats.bus_errors++;
+    }
+    wf_have_data = 0;
+    wf_state = WF5803F_STATE_IDLE;
+    return (status == HAL_OK) ? WF5803F_OK : WF5803F_ERR_BUS;
+}
+
+/**
+ * @brief  获取当前配置
+ */
+void WF5803F_GetConfig(WF5803F_Config_t *config)
+{
+    if (config == NULL) return;
+    *config = wf_config;
+}
+
+/**
+ * @brief  启动一次采集 (立即返回)
+ * @return WF5803F_OK: 已启动；WF5803F_ERR_BUSY: 上一次未结束；WF5803F_ERR_BUS: 总线队列满
+ * @note   单次模式下先触发转换；连续模式下直接读取最近一次转换结果。
+ *         结果通过回调和 WF5803F_WaitSample 发布；只能在任务中调用
+ */
+WF5803F_Result_t WF5803F_StartConversion(void)
+{
+    WF5803F_State_t state;
+
+    taskENTER_CRITICAL();
+    if (wf_state != WF5803F_STATE_IDLE) {
+        taskEXIT_CRITICAL();
+        wf_stats.busy++;
+        return WF5803F_ERR_BUSY;
+    }
+    state = (wf_config.mode == WF5803F_MODE_CONTINUOUS) ?
+            WF5803F_STATE_READ_BURST : WF5803F_STATE_WRITE_CTRL;
+    wf_state = state;
+    taskEXIT_CRITICAL();
+
+    xQueueReset(wf_queue);
+    wf_start_tick = HAL_GetTick();
+    wf_start_time = DwtTime_Now();
+    wf_stats.started++;
+
+    if (WF5803F_Submit(state) != 0) {
+        wf_stats.bus_errors++;
+        wf_state = WF5803F_STATE_IDLE;
+        return WF5803F_ERR_BUS;
+    }
+    return WF5803F_OK;
+}
+
+/**
+ * @brief  等待本次采集结果
+ * @param  sample      输出采集数据 (含结果码)
+ * @param  timeout_ms  最长等待时间
+ * @return 采集结果，等待超时返回 WF5803F_ERR_TIMEOUT
+ */
+WF5803F_Result_t WF5803F_WaitSample(WF5803F_Sample_t *sample, uint32_t timeout_ms)
+{
+    if (xQueueReceive(wf_queue, sample, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        sample->result = WF5803F_ERR_TIMEOUT;
+    }
+    return sample->result;
+}
+
+/**
+ * @brief  不等待地取回本次采集结果
+ * @param  sample  输出采集数据 (含结果码)，尚未结束时不修改
+ * @return 采集结果；WF5803F_ERR_BUSY: 采集尚未结束
+ * @note   供固定周期的循环使用: 本周期启动，之后的周期取回，不阻塞
+ */
+WF5803F_Result_t WF5803F_PollSample(WF5803F_Sample_t *sample)
+{
+    if (xQueueReceive(wf_queue, sample, 0) != pdTRUE) {
+        return WF5803F_ERR_BUSY;
+    }
+    return sample->result;
+}
+
+/**
+ * @brief  获取采集统计
+ */
+void WF5803F_GetStats(WF5803F_Stats_t *stats)
+{
+    if (stats == NULL) return;
+    *stats = wf_stats;
+}
+
+/**
+ * @brief  直接获取计算后的温度和气压值 (启动一次转换并等待结果，等待期间任务阻塞、不占用 CPU)
  * @param  temperature  指向float变量的指针，用于存储计算后的温度值(单位: ℃)
  * @param  pressure     指向float变量的指针，用于存储计算后的气压值(单位: kPa)
+ * @return 采集结果，失败时不修改输出值
  */
-void WF5803F_GetData(float* temperature, float* pressure)
+WF5803F_Result_t WF5803F_GetData(float* temperature, float* pressure)
 {
-    int16_t rawTemp;
-    int32_t rawPress;
-    
-    // 读取原始数据
-    WF5803F_ReadDate(&rawTemp, &rawPress);
-    
-    // 转换为实际物理值
-    *temperature = compute_temperature_WF5803F_fromInt(rawTemp);
-    *pressure = compute_pressure_WF5803F_2BAR_fromInt(rawPress);
+    WF5803F_Sample_t sample;
+    WF5803F_Result_t result = WF5803F_StartConversion();
+
+    if (result != WF5803F_OK) {
+        return result;
+    }
+
+    result = WF5803F_WaitSample(&sample, WF5803F_TIMEOUT_MS + WF5803F_POLL_MS);
+    if (result == WF5803F_OK) {
+        *temperature = sample.temperature;
+        *pressure = sample.pressure;
+    }
+    return result;
 }
 
 
@@ -0,0 +1,196 @@
+/**
+  ******************************************************************************
+  * @file           : adc_scan.c
+  * @brief          : ADC1 timer-triggered scan with circular DMA
+  *                   ADC1 定时器触发扫描实现
+  ******************************************************************************
+  * @attention
+  *
+  * DMA 只写、读者只读，每个采样是一个对齐的半字，读写都是原子的。
+  * 读者与 DMA 之间唯一的竞争是刚定位的扫描在读取前被 DMA 绕一圈覆盖，
+  * 这需要读者被阻塞整整 ADC_SCAN_DEPTH 个扫描周期，即使发生读到的也是更新的采样。
+  *
+  * 过采样在 DMA 中断中进行 (累加见 adc_scan_ovs.c)，每半个缓冲区 (ADC_SCAN_DEPTH / 2 次扫描)
+  * 累加一次，每通道 8 次加法；过采样输出值和序号分别是单字，读者先读序号后读值，
+  * 两次读之间发生输出时值比序号新一个周期，对控制环无影响。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_scan.h"
+#include "dwt_time.h"
+
+/* Private define ------------------------------------------------------------*/
+#define ADC_SCAN_LEN            (ADC_SCAN_DEPTH * ADC_SCAN_CHANNELS)
+#define ADC_SCAN_TICK_HZ        1000000U    // TIM2 计数频率
+#define ADC_SCAN_HALF           (ADC_SCAN_LEN / 2U)
+
+/* Private variables ---------------------------------------------------------*/
+static TIM_HandleTypeDef htim2;
+static volatile uint16_t adc_scan_buf[ADC_SCAN_LEN];    // [扫描][通道]
+static volatile uint32_t adc_scan_blocks;
+
+static AdcScan_Ovs_t ovs;                                // 当前抽取周期的累加状态
+static volatile uint32_t ovs_value[ADC_SCAN_CHANNELS];  // 最近一次抽取结果
+static volatile uint32_t ovs_seq;
+static volatile uint64_t ovs_time;                      // 最近一次抽取的时刻 (DwtTime_Now)
+
+/* Private function prototypes -----------------------------------------------*/
+static void AdcScan_TimerInit(void);
+static void AdcScan_Accumulate(const volatile uint16_t *scan);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  配置 TIM2 触发并启动 ADC1 循环 DMA 采样
+ * @retval None
+ */
+void AdcScan_Start(void)
+{
+    for (uint32_t i = 0; i < ADC_SCAN_LEN; i++) {
+        adc_scan_buf[i] = ADC_SCAN_EMPTY;
+    }
+
+    for (uint32_t ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+        ovs_value[ch] = 0;
+    }
+    AdcScan_OvsReset(&ovs);
+    ovs_seq = 0;
+    ovs_time = 0;
+
+    AdcScan_TimerInit();
+    if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)adc_scan_buf, ADC_SCAN_LEN) != HAL_OK) {
+        Error_Handler();
+    }
+    HAL_TIM_Base_Start(&htim2);
+}
+
+/**
+ * @brief  最近一次完整扫描中该通道的采样值
+ */
+uint16_t AdcScan_Latest(AdcScan_Channel_t ch)
+{
+    uint32_t remaining = __HAL_DMA_GET_COUNTER(hadc1.DMA_Handle);
+    uint32_t pos = (ADC_SCAN_LEN - remaining) % ADC_SCAN_LEN;      // DMA 下一个写入位置
+    uint32_t scan = (pos / ADC_SCAN_CHANNELS + ADC_SCAN_DEPTH - 1) % ADC_SCAN_DEPTH;
+    uint16_t value = adc_scan_buf[scan * ADC_SCAN_CHANNELS + ch];
+
+    return (value == ADC_SCAN_EMPTY) ? 0 : value;
+}
+
+/**
+ * @brief  缓冲区中该通道采样的平均值 (最近 ADC_SCAN_DEPTH 次扫描)
+ */
+uint16_t AdcScan_Average(AdcScan_Channel_t ch)
+{
+    uint32_t sum = 0;
+    uint32_t n = 0;
+    uint16_t value;
+
+    for (uint32_t i = ch; i < ADC_SCAN_LEN; i += ADC_SCAN_CHANNELS) {
+        value = adc_scan_buf[i];
+        if (value != ADC_SCAN_EMPTY) {
+            sum += value;
+            n++;
+        }
+    }
+    return (n > 0) ? (uint16_t)((sum + n / 2) / n) : 0;
+}
+
+/**
+ * @brief  最近一次过采样抽取结果
+ */
+uint32_t AdcScan_Oversampled(AdcScan_Channel_t ch, uint32_t *seq)
+{
+    if (seq != NULL) {
+        *seq = ovs_seq;
+    }
+    return ovs_value[ch];
+}
+
+/**
+ * @brief  最近一次过采样抽取的时刻
+ */
+uint64_t AdcScan_OversampledTime(void)
+{
+    uint32_t seq;
+    uint64_t t;
+
+    // 64 位值不能一次读完，读取期间发生抽取时重读
+    do {
+        seq = ovs_seq;
+        t = ovs_time;
+    } while (seq != ovs_seq);
+    return t;
+}
+
+/**
+ * @brief  DMA 传输完成的半缓冲区数
+ */
+uint32_t AdcScan_GetBlocks(void)
+{
+    return adc_scan_blocks;
+}
+
+/**
+ * @brief  TIM2: ADC_SCAN_TICK_HZ 计数，每 ADC_SCAN_RATE_HZ 产生一次更新事件作为 TRGO
+ */
+static void AdcScan_TimerInit(void)
+{
+    TIM_MasterConfigTypeDef master = {0};
+    uint32_t clk = HAL_RCC_GetPCLK1Freq();
+
+    // APB1 分频不为 1 时定时器时钟为 PCLK1 的 2 倍
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+        clk *= 2U;
+    }
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    htim2.Instance = TIM2;
+    htim2.Init.Prescaler = clk / ADC_SCAN_TICK_HZ - 1U;
+    htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim2.Init.Period = ADC_SCAN_TICK_HZ / ADC_SCAN_RATE_HZ - 1U;
+    htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&htim2) != HAL_OK) {
+        Error_Handler();
+    }
+
+    master.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    master.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(&htim2, &master) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief  累加半个缓冲区的扫描，满 ADC_SCAN_OVS_N 个采样时输出抽取结果
+ * @param  scan: 半个缓冲区起始地址 (DMA 正在写另一半)
+ * @retval None
+ * @note   在 DMA 中断中调用
+ */
+static void AdcScan_Accumulate(const volatile uint16_t *scan)
+{
+    if (AdcScan_OvsAccumulate(&ovs, scan, ovs_value)) {
+        ovs_time = DwtTime_Now();
+        ovs_seq++;
+    }
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) {
+        adc_scan_blocks++;
+        AdcScan_Accumulate(&adc_scan_buf[0]);
+    }
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) {
+        adc_scan_blocks++;
+        AdcScan_Accumulate(&adc_scan_buf[ADC_SCAN_HALF]);
+    }
+}
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file           : adc_scan_ovs.c
+  * @brief          : ADC scan oversampling accumulator
+  *                   ADC 扫描过采样累加实现
+  ******************************************************************************
+  * @attention
+  *
+  * 每半个缓冲区每通道 ADC_SCAN_DEPTH / 2 次加法；12 位采样累加 ADC_SCAN_OVS_N 次不超过 2^20，
+  * 32 位累加器不会溢出。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_scan_ovs.h"
+
+/* Private define ------------------------------------------------------------*/
+#define ADC_SCAN_HALF           (ADC_SCAN_DEPTH / 2U * ADC_SCAN_CHANNELS)
+
+#if (ADC_SCAN_OVS_N % (ADC_SCAN_DEPTH / 2U)) != 0
+#error "ADC_SCAN_OVS_N must be a multiple of ADC_SCAN_DEPTH / 2"
+#endif
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  清零累加状态
+ */
+void AdcScan_OvsReset(AdcScan_Ovs_t *ovs)
+{
+    for (uint32_t ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+        ovs->acc[ch] = 0;
+    }
+    ovs->count = 0;
+}
+
+/**
+ * @brief  累加半个缓冲区的扫描，满 ADC_SCAN_OVS_N 个采样时输出抽取结果
+ */
+int AdcScan_OvsAccumulate(AdcScan_Ovs_t *ovs, const volatile uint16_t *scan, volatile uint32_t *out)
+{
+    uint32_t ch;
+
+    for (uint32_t i = 0; i < ADC_SCAN_HALF; i += ADC_SCAN_CHANNELS) {
+        for (ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+            ovs->acc[ch] += scan[i + ch];
+        }
+    }
+
+    ovs->count += ADC_SCAN_DEPTH / 2U;
+    if (ovs->count < ADC_SCAN_OVS_N) {
+        return 0;
+    }
+
+    for (ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+        out[ch] = ovs->acc[ch] >> ADC_SCAN_OVS_BITS;
+        ovs->acc[ch] = 0;
+    }
+    ovs->count = 0;
+    return 1;
+}
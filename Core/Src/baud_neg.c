@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file           : baud_neg.c
+  * @brief          : USART2 baud rate negotiation
+  *                   USART2 波特率协商实现
+  ******************************************************************************
+  * @attention
+  *
+  * 所有函数都只在 USART 接收任务中调用 (命令处理与状态机推进)，无需加锁。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "baud_neg.h"
+#include "cmsis_os.h"
+#include "usart.h"
+#include "fmt.h"
+#include "tlm_frame.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BAUDNEG_POLL_MS     10      // 协商期间接收任务的轮询间隔
+#define BAUDNEG_RESTORE_RETRIES 3   // 恢复原波特率时排空失败的重试次数，用尽后强制恢复
+
+/* Private variables ---------------------------------------------------------*/
+static BaudNeg_State_t baudneg_state = BAUDNEG_IDLE;
+static uint32_t baudneg_new;            // 协商中的新波特率
+static uint32_t baudneg_old;            // 超时后恢复的原波特率
+static uint32_t baudneg_deadline;       // 等待确认的截止时刻 (ms)
+static uint32_t baudneg_next_probe;     // 下一次发送探测帧的时刻 (ms)
+static uint16_t baudneg_seq = 0;
+static uint8_t baudneg_restore_tries;   // 恢复原波特率已失败的次数
+
+/* Private function prototypes -----------------------------------------------*/
+static void BaudNeg_SendProbe(void);
+static void BaudNeg_SendNotice(const char *status, uint32_t baud);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  发起协商 (在 "baud <rate>" 命令中调用)
+ * @param  baud: 新波特率
+ * @retval 0: 已受理，-1: 波特率不可用，-2: 正在协商
+ * @note   实际切换在下一次 BaudNeg_Poll 中进行，保证应答先以原波特率发出
+ */
+int BaudNeg_Start(uint32_t baud)
+{
+    if (baudneg_state != BAUDNEG_IDLE) {
+        return -2;
+    }
+    if (USART2_CheckBaudRate(baud) == 0) {
+        return -1;
+    }
+
+    baudneg_old = USART2_GetBaudRate();
+    baudneg_new = baud;
+    baudneg_restore_tries = 0;
+    baudneg_state = BAUDNEG_SWITCH;
+    return 0;
+}
+
+/**
+ * @brief  上位机确认新波特率 (在 "baud ok" 命令中调用)
+ * @retval 0: 已确认，-1: 当前不在等待确认
+ */
+int BaudNeg_Confirm(void)
+{
+    if (baudneg_state != BAUDNEG_PROBE) {
+        return -1;
+    }
+
+    baudneg_state = BAUDNEG_IDLE;
+    return 0;
+}
+
+/**
+ * @brief  推进协商状态机，在 USART 接收任务中周期调用
+ * @retval None
+ */
+void BaudNeg_Poll(void)
+{
+    uint32_t now;
+
+    if (baudneg_state == BAUDNEG_SWITCH) {
+        // 1. 应答已写入发送缓冲区，排空后切换
+        if (USART2_SetBaudRate(baudneg_new) != HAL_OK) {
+            baudneg_state = BAUDNEG_IDLE;
+            BaudNeg_SendNotice("busy", baudneg_old);
+            return;
+        }
+        now = HAL_GetTick();
+        baudneg_deadline = now + BAUDNEG_CONFIRM_TIMEOUT_MS;
+        baudneg_next_probe = now;
+        baudneg_state = BAUDNEG_PROBE;
+    }
+
+    if (baudneg_state != BAUDNEG_PROBE) {
+        return;
+    }
+
+    now = HAL_GetTick();
+
+    // 2. 超时未确认，恢复原波特率；排空失败时留到下一次轮询重试，
+    //    重试用尽后暂停发送强制恢复 (可能丢弃正在发送的一段)，并通知失败
+    if ((int32_t)(now - baudneg_deadline) >= 0) {
+        if (USART2_SetBaudRate(baudneg_old) == HAL_OK) {
+            baudneg_state = BAUDNEG_IDLE;
+            BaudNeg_SendNotice("timeout", baudneg_old);
+            return;
+        }
+        if (++baudneg_restore_tries <= BAUDNEG_RESTORE_RETRIES) {
+            return;
+        }
+        USART2_ForceBaudRate(baudneg_old);
+        baudneg_state = BAUDNEG_IDLE;
+        BaudNeg_SendNotice("forced", baudneg_old);
+        return;
+    }
+
+    // 3. 周期发送探测帧
+    if ((int32_t)(now - baudneg_next_probe) >= 0) {
+        BaudNeg_SendProbe();
+        baudneg_next_probe += BAUDNEG_PROBE_INTERVAL_MS;
+    }
+}
+
+/**
+ * @brief  接收任务下一次等待数据的最长时间
+ * @retval 系统节拍数，未在协商时为 portMAX_DELAY
+ */
+uint32_t BaudNeg_WaitTicks(void)
+{
+    switch (baudneg_state) {
+    case BAUDNEG_SWITCH: return 0;
+    case BAUDNEG_PROBE:  return pdMS_TO_TICKS(BAUDNEG_POLL_MS);
+    default:             return portMAX_DELAY;
+    }
+}
+
+/**
+ * @brief  以新波特率发送一帧探测帧
+ */
+static void BaudNeg_SendProbe(void)
+{
+    static const uint8_t pattern[8] = TLM_PROBE_PATTERN;
+    uint8_t frame[TLM_FRAME_WIRE_MAX];
+    TlmProbe_t probe;
+    size_t len;
+
+    probe.baud = baudneg_new;
+    for (uint32_t i = 0; i < sizeof(pattern); i++) {
+        probe.pattern[i] = pattern[i];
+    }
+
+    len = TlmFrame_Build(TLM_FRAME_TYPE_PROBE, baudneg_seq++, HAL_GetTick(),
+                         &probe, sizeof(probe), frame);
+    if (len > 0) {
+        UartTx_Write(&uart2_tx, frame, (uint32_t)len);
+    }
+}
+
+/**
+ * @brief  发送协商结果通知 (异步应答，格式同命令应答)
+ */
+static void BaudNeg_SendNotice(const char *status, uint32_t baud)
+{
+    char line[80];
+    int len = Fmt_Snprintf(line, sizeof(line),
+                           "{\"type\":\"ack\",\"cmd\":\"baud\",\"status\":\"%s\",\"baud\":%u}\n",
+                           status, (unsigned int)baud);
+
+    if (len > 0 && len < (int)sizeof(line)) {
+        UartTx_Write(&uart2_tx, (const uint8_t *)line, (uint32_t)len);
+    }
+}
@@ -0,0 +1,290 @@
+/**
+  ******************************************************************************
+  * @file           : cmd_parser.c
+  * @brief          : Line command parser
+  *                   行命令协议解析实现
+  ******************************************************************************
+  * @attention
+  *
+  * 纯 C 实现，不依赖 HAL/RTOS；数字解析不使用 strtof/strtoul
+  * (newlib 的 strtod 会调用 malloc)。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "cmd_parser.h"
+#include "fmt.h"
+#include <stdarg.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define CMD_FLOAT_DIGITS_MAX  9     // 小数解析最多有效数字 (uint32 不溢出)
+
+/* Private variables ---------------------------------------------------------*/
+static const float cmd_pow10[CMD_FLOAT_DIGITS_MAX + 1] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static int Cmd_IsSpace(char c);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化行缓冲区
+ * @param  line: 行缓冲区
+ * @retval None
+ */
+void Cmd_LineInit(Cmd_Line_t *line)
+{
+    if (line == NULL) return;
+
+    line->len = 0;
+    line->overflow = 0;
+    line->buf[0] = '\0';
+}
+
+/**
+ * @brief  输入一个字节
+ * @param  line: 行缓冲区
+ * @param  byte: 收到的字节
+ * @retval 1: 一行完整 (line->buf 以 '\0' 结尾)，-1: 一行结束但超长已丢弃，0: 行未结束
+ * @note   返回 1 或 -1 后下一次调用自动开始新的一行
+ */
+int Cmd_LineFeed(Cmd_Line_t *line, uint8_t byte)
+{
+    if (byte == '\n' || byte == '\r') {
+        int ret = line->overflow ? -1 : 1;
+        line->buf[line->len] = '\0';
+        line->len = 0;
+        line->overflow = 0;
+        // "\r\n" 中的第二个结束符会产生一个空行，由 Cmd_Execute 忽略
+        return ret;
+    }
+
+    if (line->overflow) {
+        return 0;
+    }
+    if (line->len >= CMD_LINE_MAX - 1) {
+        line->overflow = 1;
+        return 0;
+    }
+
+    line->buf[line->len++] = (char)byte;
+    return 0;
+}
+
+/**
+ * @brief  按空白在原处分词
+ * @param  text: 待分词字符串 (会被修改)
+ * @param  argv: 输出各词起始地址
+ * @param  max: argv 容量
+ * @retval 词的个数，超过 max 时返回 max + 1
+ */
+int Cmd_Tokenize(char *text, char *argv[], int max)
+{
+    int argc = 0;
+
+    for (;;) {
+        while (Cmd_IsSpace(*text)) {
+            text++;
+        }
+        if (*text == '\0') {
+            return argc;
+        }
+        if (argc == max) {
+            return max + 1;
+        }
+        argv[argc++] = text;
+        while (*text != '\0' && !Cmd_IsSpace(*text)) {
+            text++;
+        }
+        if (*text != '\0') {
+            *text++ = '\0';
+        }
+    }
+}
+
+/**
+ * @brief  查表并执行一行命令
+ * @param  table: 命令表
+ * @param  count: 命令表项数
+ * @param  text: 一行命令 (会被修改)
+ * @param  entry: 输出匹配的表项，未匹配时为 NULL
+ * @param  reply: 应答附加内容
+ * @retval 执行结果，空行返回 CMD_OK 且 entry 为 NULL
+ */
+Cmd_Status_t Cmd_Execute(const Cmd_Entry_t *table, size_t count, char *text,
+                         const Cmd_Entry_t **entry, Cmd_Reply_t *reply)
+{
+    char *argv[CMD_ARGC_MAX + 1];
+    int argc;
+
+    *entry = NULL;
+
+    // 1. 分词，argv[0] 为命令名
+    argc = Cmd_Tokenize(text, argv, CMD_ARGC_MAX + 1);
+    if (argc == 0) {
+        return CMD_OK;
+    }
+
+    // 2. 查表
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(table[i].name, argv[0]) == 0) {
+            *entry = &table[i];
+            break;
+        }
+    }
+    if (*entry == NULL) {
+        return CMD_ERR_UNKNOWN;
+    }
+
+    // 3. 检查参数个数后调用处理函数
+    argc--;
+    if (argc < (*entry)->min_args || argc > (*entry)->max_args) {
+        return CMD_ERR_ARGC;
+    }
+
+    return (*entry)->handler(argc, &argv[1], reply);
+}
+
+/**
+ * @brief  解析十进制小数 (可带符号，不支持指数)
+ * @param  s: 字符串
+ * @param  value: 输出值
+ * @retval CMD_OK / CMD_ERR_VALUE
+ */
+Cmd_Status_t Cmd_ParseFloat(const char *s, float *value)
+{
+    uint32_t mantissa = 0;
+    int digits = 0;         // 已计入 mantissa 的有效数字
+    int frac_digits = 0;    // 其中小数位数
+    int seen_digit = 0;
+    int negative = 0;
+
+    if (*s == '-' || *s == '+') {
+        negative = (*s == '-');
+        s++;
+    }
+
+    // 整数部分
+    while (*s >= '0' && *s <= '9') {
+        if (mantissa != 0 || *s != '0') {
+            if (digits == CMD_FLOAT_DIGITS_MAX) {
+                return CMD_ERR_VALUE;   // 整数部分超过 9 位
+            }
+            digits++;
+        }
+        mantissa = mantissa * 10U + (uint32_t)(*s - '0');
+        seen_digit = 1;
+        s++;
+    }
+
+    // 小数部分，超出精度的位只校验不计入
+    if (*s == '.') {
+        s++;
+        while (*s >= '0' && *s <= '9') {
+            if (digits < CMD_FLOAT_DIGITS_MAX && frac_digits < CMD_FLOAT_DIGITS_MAX) {
+                mantissa = mantissa * 10U + (uint32_t)(*s - '0');
+                frac_digits++;
+                if (mantissa != 0) {
+                    digits++;
+                }
+            }
+            seen_digit = 1;
+            s++;
+        }
+    }
+
+    if (!seen_digit || *s != '\0') {
+        return CMD_ERR_VALUE;
+    }
+
+    *value = (float)mantissa / cmd_pow10[frac_digits];
+    if (negative) {
+        *value = -*value;
+    }
+    return CMD_OK;
+}
+
+/**
+ * @brief  解析十进制无符号整数
+ * @param  s: 字符串
+ * @param  value: 输出值
+ * @retval CMD_OK / CMD_ERR_VALUE (含溢出)
+ */
+Cmd_Status_t Cmd_ParseU32(const char *s, uint32_t *value)
+{
+    uint32_t v = 0;
+
+    if (*s == '\0') {
+        return CMD_ERR_VALUE;
+    }
+    while (*s >= '0' && *s <= '9') {
+        uint32_t d = (uint32_t)(*s - '0');
+        if (v > (UINT32_MAX - d) / 10U) {
+            return CMD_ERR_VALUE;
+        }
+        v = v * 10U + d;
+        s++;
+    }
+    if (*s != '\0') {
+        return CMD_ERR_VALUE;
+    }
+
+    *value = v;
+    return CMD_OK;
+}
+
+/**
+ * @brief  向应答附加内容追加格式化文本 (超出缓冲区时截断)
+ * @param  reply: 应答附加内容
+ * @param  format: 格式字符串 (同 Fmt_Snprintf)
+ * @retval None
+ */
+void Cmd_ReplyAppend(Cmd_Reply_t *reply, const char *format, ...)
+{
+    va_list args;
+    int n;
+
+    if (reply == NULL || reply->len + 1 >= reply->size) return;
+
+    va_start(args, format);
+    n = Fmt_Vsnprintf(reply->buf + reply->len, reply->size - reply->len, format, args);
+    va_end(args);
+
+    if (n > 0) {
+        reply->len += (size_t)n;
+        if (reply->len >= reply->size) {
+            reply->len = reply->size - 1;
+        }
+    }
+}
+
+/**
+ * @brief  执行结果对应的短字符串 (用于应答)
+ * @param  status: 执行结果
+ * @retval "ok" / "unknown" / "argc" / "value" / "range" / "overflow" / "busy"
+ */
+const char *Cmd_StatusString(Cmd_Status_t status)
+{
+    switch (status) {
+    case CMD_OK:            return "ok";
+    case CMD_ERR_UNKNOWN:   return "unknown";
+    case CMD_ERR_ARGC:      return "argc";
+    case CMD_ERR_VALUE:     return "value";
+    case CMD_ERR_RANGE:     return "range";
+    case CMD_ERR_OVERFLOW:  return "overflow";
+    case CMD_ERR_BUSY:      return "busy";
+    default:                return "error";
+    }
+}
+
+/**
+ * @brief  是否为分隔空白
+ */
+static int Cmd_IsSpace(char c)
+{
+    return (c == ' ' || c == '\t');
+}
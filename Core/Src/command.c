@@ -0,0 +1,766 @@
+/**
+  ******************************************************************************
+  * @file           : command.c
+  * @brief          : Host command handlers
+  *                   上位机命令处理实现
+  ******************************************************************************
+  * @attention
+  *
+  * 命令在 USART 接收任务中执行，PID 参数由采集任务读取；
+  * 单个 float 的读写在 Cortex-M4 上是原子的，成对修改的输出限幅放在临界区内。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "command.h"
+#include "cmsis_os.h"
+#include "usart.h"
+#include "fmt.h"
+#include "temp_pid_ctrl.h"
+#include "telemetry.h"
+#include "baud_neg.h"
+#include "WF5803F.h"
+#include "i2c_bus.h"
+#include "sensor_filter.h"
+#include "ctrl_loop.h"
+#include "dwt_time.h"
+#include <stdarg.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define CMD_REPLY_MAX       224     // 应答附加内容最大长度
+#define CMD_ACK_MAX         272     // 一行应答最大长度
+#define CMD_GAIN_MAX        10000.0f
+#define CMD_DEADBAND_MAX    10.0f
+#define CMD_SETPOINT_MIN    0.0f
+#define CMD_NAME_ECHO_MAX   12      // 未知命令回显的最大长度
+
+#define CMD_COUNT(table)    (sizeof(table) / sizeof((table)[0]))
+
+/* Private variables ---------------------------------------------------------*/
+extern volatile uint8_t g_autoSetpointEnable;   // 调试用自动切换目标温度 (仅通道1)
+
+static Cmd_Line_t cmd_line;
+static uint32_t cmd_channel = 1;                // 温控命令的目标通道 (1 ~ TEMPCTRL_CHANNELS)，"ch" 命令选择
+
+/* WF5803F 过采样率，下标为 P_CONFIG 编码 */
+static const uint16_t cmd_wf_osr[] = { 1024, 2048, 4096, 8192, 256, 512, 16384, 32768 };
+
+/* Private function prototypes -----------------------------------------------*/
+static Cmd_Status_t Command_Help(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Get(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Setpoint(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Kp(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Ki(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Kd(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Deadband(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Limit(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Rate(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Mode(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Route(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Stats(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Baud(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Wf(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_I2c(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Filter(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Channel(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Fusion(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Loop(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_Pid(int argc, char *argv[], Cmd_Reply_t *reply);
+static Cmd_Status_t Command_SetGain(float *gain, const char *key, const char *arg, Cmd_Reply_t *reply);
+static void Command_SendLine(const char *format, ...);
+static void Command_Execute(char *text);
+
+/* 命令表 */
+static const Cmd_Entry_t cmd_table[] = {
+    { "help",  0, 0, Command_Help,     "help" },
+    { "get",   0, 0, Command_Get,      "get" },
+    { "sp",    1, 1, Command_Setpoint, "sp <degC>|auto" },
+    { "kp",    1, 1, Command_Kp,       "kp <gain>" },
+    { "ki",    1, 1, Command_Ki,       "ki <gain>" },
+    { "kd",    1, 1, Command_Kd,       "kd <gain>" },
+    { "db",    1, 1, Command_Deadband, "db <degC>" },
+    { "lim",   2, 2, Command_Limit,    "lim <min> <max>" },
+    { "rate",  1, 1, Command_Rate,     "rate <ms>" },
+    { "mode",  1, 1, Command_Mode,     "mode json|bin" },
+    { "route", 1, 1, Command_Route,    "route console|data" },
+    { "stats", 0, 1, Command_Stats,    "stats [data|tlm|wf]" },
+    { "baud",  1, 1, Command_Baud,     "baud <rate>|ok" },
+    { "wf",    1, 3, Command_Wf,       "wf single|cont [odr 0-15] [osr 256-32768]" },
+    { "i2c",   0, 1, Command_I2c,      "i2c [1|2]" },
+    { "flt",   0, 2, Command_Filter,   "flt [off|lp200|lp100|lp50|lp50x4] [median 1|3|5]" },
+    { "ch",    0, 2, Command_Channel,  "ch [1-4] [on|off]" },
+    { "kf",    0, 3, Command_Fusion,   "kf [on|off] | kf <r_ntc> <r_wf> [q]" },
+    { "ctl",   0, 1, Command_Loop,     "ctl [<ms 1-1000>|reset]" },
+    { "pid",   0, 1, Command_Pid,      "pid [pos|f32|q31|q15]" },
+};
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化命令处理
+ * @retval None
+ */
+void Command_Init(void)
+{
+    Cmd_LineInit(&cmd_line);
+}
+
+/**
+ * @brief  输入串口收到的数据，每收到完整一行执行一条命令并发送应答
+ * @param  data: 数据
+ * @param  len: 数据长度
+ * @retval None
+ * @note   仅在 USART 接收任务中调用
+ */
+void Command_Feed(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        int ret = Cmd_LineFeed(&cmd_line, data[i]);
+        if (ret > 0) {
+            Command_Execute(cmd_line.buf);
+        } else if (ret < 0) {
+            Command_SendLine("{\"type\":\"ack\",\"cmd\":\"\",\"status\":\"%s\"}\n",
+                             Cmd_StatusString(CMD_ERR_OVERFLOW));
+        }
+    }
+}
+
+/**
+ * @brief  执行一行命令并发送应答
+ * @param  text: 一行命令
+ * @retval None
+ */
+static void Command_Execute(char *text)
+{
+    char reply_buf[CMD_REPLY_MAX];
+    Cmd_Reply_t reply = { reply_buf, sizeof(reply_buf), 0 };
+    char name[CMD_NAME_ECHO_MAX + 1];
+    const Cmd_Entry_t *entry;
+    Cmd_Status_t status;
+    size_t n = 0;
+
+    reply_buf[0] = '\0';
+
+    // 先记下命令名用于未知命令回显 (分词会修改原字符串)，引号等字符替换为 '?'
+    while (*text == ' ' || *text == '\t') text++;
+    while (n < CMD_NAME_ECHO_MAX && text[n] > ' ' && text[n] < 0x7F) {
+        name[n] = (text[n] == '"' || text[n] == '\\') ? '?' : text[n];
+        n++;
+    }
+    name[n] = '\0';
+
+    status = Cmd_Execute(cmd_table, CMD_COUNT(cmd_table), text, &entry, &reply);
+    if (status == CMD_OK && entry == NULL) {
+        return;   // 空行
+    }
+
+    Command_SendLine("{\"type\":\"ack\",\"cmd\":\"%s\",\"status\":\"%s\"%s%s}\n",
+                     (entry != NULL) ? entry->name : name,
+                     Cmd_StatusString(status),
+                     (reply.len > 0) ? "," : "",
+                     reply_buf);
+}
+
+/**
+ * @brief  格式化一行并整行写入发送缓冲区
+ * @param  format: 格式字符串
+ * @retval None
+ */
+static void Command_SendLine(const char *format, ...)
+{
+    char line[CMD_ACK_MAX];
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = Fmt_Vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (len <= 0) return;
+    if (len >= (int)sizeof(line)) {
+        len = sizeof(line) - 1;
+        line[len - 1] = '\n';   // 截断时保证以换行结束
+    }
+    UartTx_Write(&uart2_tx, (const uint8_t *)line, (uint32_t)len);
+}
+
+/**
+ * @brief  help: 每条命令输出一行用法
+ */
+static Cmd_Status_t Command_Help(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    for (size_t i = 0; i < CMD_COUNT(cmd_table); i++) {
+        Command_SendLine("{\"type\":\"help\",\"usage\":\"%s\"}\n", cmd_table[i].usage);
+    }
+    Cmd_ReplyAppend(reply, "\"count\":%u", (unsigned int)CMD_COUNT(cmd_table));
+    return CMD_OK;
+}
+
+/**
+ * @brief  get: 查询当前通道的控制参数和上报设置
+ */
+static Cmd_Status_t Command_Get(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+
+    Cmd_ReplyAppend(reply, "\"ch\":%u,\"en\":%u,\"temp\":%.2f,",
+                    (unsigned int)cmd_channel, (unsigned int)c->enabled, c->temp);
+    Cmd_ReplyAppend(reply, "\"sp\":%.2f,\"auto\":%u,\"kp\":%.4f,\"ki\":%.4f,\"kd\":%.4f,",
+                    c->pid.setpoint, (unsigned int)g_autoSetpointEnable,
+                    c->pid.Kp, c->pid.Ki, c->pid.Kd);
+    Cmd_ReplyAppend(reply, "\"db\":%.2f,\"min\":%.1f,\"max\":%.1f,\"out\":%.1f,",
+                    c->pid.deadband, c->pid.output_limit_min,
+                    c->pid.output_limit_max, c->pid.output);
+    Cmd_ReplyAppend(reply, "\"mode\":\"%s\",\"route\":\"%s\",\"rate\":%u,\"baud\":%u",
+                    (Telemetry_GetMode() == TELEMETRY_MODE_BINARY) ? "bin" : "json",
+                    (Telemetry_GetRoute() == TELEMETRY_ROUTE_DATA) ? "data" : "console",
+                    (unsigned int)Telemetry_GetPeriod(), (unsigned int)USART2_GetBaudRate());
+    return CMD_OK;
+}
+
+/**
+ * @brief  sp <degC>|auto: 设置当前通道目标温度，通道1手动设置后关闭调试用自动切换
+ */
+static Cmd_Status_t Command_Setpoint(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+    float value;
+    Cmd_Status_t status;
+
+    if (strcmp(argv[0], "auto") == 0) {
+        g_autoSetpointEnable = 1;
+        Cmd_ReplyAppend(reply, "\"auto\":1");
+        return CMD_OK;
+    }
+
+    status = Cmd_ParseFloat(argv[0], &value);
+    if (status != CMD_OK) return status;
+    if (value < CMD_SETPOINT_MIN || value >= TEMP_SAFE_SHUTDOWN) return CMD_ERR_RANGE;
+
+    if (cmd_channel == 1) {
+        g_autoSetpointEnable = 0;
+    }
+    PID_SetSetpoint(&c->pid, value);
+    Cmd_ReplyAppend(reply, "\"ch\":%u,\"sp\":%.2f,\"auto\":%u",
+                    (unsigned int)cmd_channel, value, (unsigned int)g_autoSetpointEnable);
+    return CMD_OK;
+}
+
+/**
+ * @brief  kp <gain>
+ */
+static Cmd_Status_t Command_Kp(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+
+    return Command_SetGain(&c->pid.Kp, "kp", argv[0], reply);
+}
+
+/**
+ * @brief  ki <gain>
+ */
+static Cmd_Status_t Command_Ki(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+
+    return Command_SetGain(&c->pid.Ki, "ki", argv[0], reply);
+}
+
+/**
+ * @brief  kd <gain>
+ */
+static Cmd_Status_t Command_Kd(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+
+    return Command_SetGain(&c->pid.Kd, "kd", argv[0], reply);
+}
+
+/**
+ * @brief  设置一个 PID 增益 (0 ~ CMD_GAIN_MAX)
+ */
+static Cmd_Status_t Command_SetGain(float *gain, const char *key, const char *arg, Cmd_Reply_t *reply)
+{
+    float value;
+    Cmd_Status_t status = Cmd_ParseFloat(arg, &value);
+
+    if (status != CMD_OK) return status;
+    if (value < 0.0f || value > CMD_GAIN_MAX) return CMD_ERR_RANGE;
+
+    *gain = value;
+    Cmd_ReplyAppend(reply, "\"%s\":%.4f", key, value);
+    return CMD_OK;
+}
+
+/**
+ * @brief  db <degC>: 设置温度死区
+ */
+static Cmd_Status_t Command_Deadband(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+    float value;
+    Cmd_Status_t status = Cmd_ParseFloat(argv[0], &value);
+
+    if (status != CMD_OK) return status;
+    if (value < 0.0f || value > CMD_DEADBAND_MAX) return CMD_ERR_RANGE;
+
+    c->pid.deadband = value;
+    Cmd_ReplyAppend(reply, "\"db\":%.2f", value);
+    return CMD_OK;
+}
+
+/**
+ * @brief  lim <min> <max>: 设置 PID 输出限幅
+ */
+static Cmd_Status_t Command_Limit(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+    float min, max;
+    Cmd_Status_t status;
+
+    status = Cmd_ParseFloat(argv[0], &min);
+    if (status != CMD_OK) return status;
+    status = Cmd_ParseFloat(argv[1], &max);
+    if (status != CMD_OK) return status;
+    if (min < PID_OUTPUT_MIN || max > PID_OUTPUT_MAX || min >= max) return CMD_ERR_RANGE;
+
+    // 上下限成对修改，避免采集任务看到 min > max 的中间状态
+    taskENTER_CRITICAL();
+    c->pid.output_limit_min = min;
+    c->pid.output_limit_max = max;
+    taskEXIT_CRITICAL();
+
+    Cmd_ReplyAppend(reply, "\"min\":%.1f,\"max\":%.1f", min, max);
+    return CMD_OK;
+}
+
+/**
+ * @brief  rate <ms>: 设置上报周期，0 停止上报
+ */
+static Cmd_Status_t Command_Rate(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    uint32_t period;
+    Cmd_Status_t status = Cmd_ParseU32(argv[0], &period);
+
+    if (status != CMD_OK) return status;
+    if (period > TELEMETRY_PERIOD_MAX_MS) return CMD_ERR_RANGE;
+
+    Telemetry_SetPeriod(period);
+    Cmd_ReplyAppend(reply, "\"rate\":%u", (unsigned int)period);
+    return CMD_OK;
+}
+
+/**
+ * @brief  mode json|bin: 切换上报模式
+ */
+static Cmd_Status_t Command_Mode(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    if (strcmp(argv[0], "json") == 0) {
+        Telemetry_SetMode(TELEMETRY_MODE_JSON);
+    } else if (strcmp(argv[0], "bin") == 0) {
+        Telemetry_SetMode(TELEMETRY_MODE_BINARY);
+    } else {
+        return CMD_ERR_VALUE;
+    }
+
+    Cmd_ReplyAppend(reply, "\"mode\":\"%s\"", argv[0]);
+    return CMD_OK;
+}
+
+/**
+ * @brief  route console|data: 切换采样上报通道 (USART2 / USART1)
+ */
+static Cmd_Status_t Command_Route(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    if (strcmp(argv[0], "console") == 0) {
+        Telemetry_SetRoute(TELEMETRY_ROUTE_CONSOLE);
+    } else if (strcmp(argv[0], "data") == 0) {
+        Telemetry_SetRoute(TELEMETRY_ROUTE_DATA);
+    } else {
+        return CMD_ERR_VALUE;
+    }
+
+    Cmd_ReplyAppend(reply, "\"route\":\"%s\",\"baud\":%u", argv[0],
+                    (unsigned int)((Telemetry_GetRoute() == TELEMETRY_ROUTE_DATA) ?
+                                   huart1.Init.BaudRate : USART2_GetBaudRate()));
+    return CMD_OK;
+}
+
+/**
+ * @brief  stats [data|tlm|wf]: 查询串口收发统计，
+ *         data 查询 USART1 数据通道发送统计，tlm 查询采样上报队列统计，wf 查询 WF5803F 采集统计
+ */
+static Cmd_Status_t Command_Stats(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    UartRx_Stats_t rx;
+    UartTx_Stats_t tx;
+    Telemetry_Stats_t tlm;
+    WF5803F_Stats_t wf;
+
+    if (argc > 0 && strcmp(argv[0], "wf") == 0) {
+        WF5803F_GetStats(&wf);
+        Cmd_ReplyAppend(reply, "\"started\":%u,\"completed\":%u,\"busy\":%u,"
+                               "\"bus_err\":%u,\"timeout\":%u,\"drdy_retry\":%u",
+                        (unsigned int)wf.started, (unsigned int)wf.completed,
+                        (unsigned int)wf.busy, (unsigned int)wf.bus_errors,
+                        (unsigned int)wf.timeouts, (unsigned int)wf.drdy_retries);
+        return CMD_OK;
+    }
+
+    if (argc > 0 && strcmp(argv[0], "tlm") == 0) {
+        Telemetry_GetStats(&tlm);
+        Cmd_ReplyAppend(reply, "\"posted\":%u,\"sent\":%u,\"skipped\":%u,\"dropped\":%u,"
+                               "\"queued\":%u,\"queue_high\":%u,\"pool\":%u",
+                        (unsigned int)tlm.posted, (unsigned int)tlm.sent,
+                        (unsigned int)tlm.skipped, (unsigned int)tlm.dropped,
+                        (unsigned int)tlm.queued, (unsigned int)tlm.queue_high,
+                        (unsigned int)TELEMETRY_POOL_SIZE);
+        return CMD_OK;
+    }
+
+    if (argc > 0) {
+        if (strcmp(argv[0], "data") != 0) return CMD_ERR_VALUE;
+        UartTx_GetStats(&uart1_tx, &tx);
+        Cmd_ReplyAppend(reply, "\"tx_bytes\":%u,\"tx_overflow\":%u,\"tx_dropped\":%u,\"tx_high\":%u,"
+                               "\"tx_err\":%u",
+                        (unsigned int)tx.sent_bytes, (unsigned int)tx.overflow_count,
+                        (unsigned int)tx.dropped_bytes, (unsigned int)tx.high_water,
+                        (unsigned int)tx.error_count);
+        return CMD_OK;
+    }
+
+    USART2_GetRxStats(&rx);
+    UartTx_GetStats(&uart2_tx, &tx);
+
+    Cmd_ReplyAppend(reply, "\"rx_bytes\":%u,\"rx_chunks\":%u,\"rx_overflow\":%u,"
+                           "\"ore\":%u,\"fe\":%u,\"ne\":%u,",
+                    (unsigned int)rx.rx_bytes, (unsigned int)rx.chunks,
+                    (unsigned int)rx.stream_overflow, (unsigned int)rx.overrun,
+                    (unsigned int)rx.frame_err, (unsigned int)rx.noise_err);
+    Cmd_ReplyAppend(reply, "\"tx_bytes\":%u,\"tx_overflow\":%u,\"tx_dropped\":%u,\"tx_high\":%u,"
+                           "\"tx_err\":%u",
+                    (unsigned int)tx.sent_bytes, (unsigned int)tx.overflow_count,
+                    (unsigned int)tx.dropped_bytes, (unsigned int)tx.high_water,
+                    (unsigned int)tx.error_count);
+    return CMD_OK;
+}
+
+/**
+ * @brief  baud <rate>|ok: 发起波特率协商 / 确认新波特率
+ */
+static Cmd_Status_t Command_Baud(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    uint32_t baud;
+    Cmd_Status_t status;
+
+    if (strcmp(argv[0], "ok") == 0) {
+        if (BaudNeg_Confirm() != 0) return CMD_ERR_BUSY;
+        Cmd_ReplyAppend(reply, "\"baud\":%u,\"confirmed\":1", (unsigned int)USART2_GetBaudRate());
+        return CMD_OK;
+    }
+
+    status = Cmd_ParseU32(argv[0], &baud);
+    if (status != CMD_OK) return status;
+
+    switch (BaudNeg_Start(baud)) {
+    case 0:
+        break;
+    case -1:
+        return CMD_ERR_RANGE;
+    default:
+        return CMD_ERR_BUSY;
+    }
+
+    // 应答以原波特率发出，之后切换并开始发送探测帧
+    Cmd_ReplyAppend(reply, "\"baud\":%u,\"actual\":%u,\"timeout\":%u",
+                    (unsigned int)baud, (unsigned int)USART2_CheckBaudRate(baud),
+                    (unsigned int)BAUDNEG_CONFIRM_TIMEOUT_MS);
+    return CMD_OK;
+}
+
+/**
+ * @brief  wf single|cont [odr] [osr]: 设置 WF5803F 转换模式、输出数据率编码和过采样率
+ * @note   无参数时 odr/osr 保持当前值；单次模式下 odr 不起作用
+ */
+static Cmd_Status_t Command_Wf(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    WF5803F_Config_t config;
+    uint32_t value;
+    Cmd_Status_t status;
+    size_t i;
+
+    WF5803F_GetConfig(&config);
+
+    if (strcmp(argv[0], "single") == 0) {
+        config.mode = WF5803F_MODE_SINGLE;
+    } else if (strcmp(argv[0], "cont") == 0) {
+        config.mode = WF5803F_MODE_CONTINUOUS;
+    } else {
+        return CMD_ERR_VALUE;
+    }
+
+    if (argc > 1) {
+        status = Cmd_ParseU32(argv[1], &value);
+        if (status != CMD_OK) return status;
+        if (value > WF5803F_ODR_MAX) return CMD_ERR_RANGE;
+        config.odr = (uint8_t)value;
+    }
+    if (argc > 2) {
+        status = Cmd_ParseU32(argv[2], &value);
+        if (status != CMD_OK) return status;
+        for (i = 0; i < CMD_COUNT(cmd_wf_osr); i++) {
+            if (cmd_wf_osr[i] == value) break;
+        }
+        if (i == CMD_COUNT(cmd_wf_osr)) return CMD_ERR_RANGE;
+        config.osr = (WF5803F_Osr_t)i;
+    }
+
+    switch (WF5803F_Configure(&config)) {
+    case WF5803F_OK:
+        break;
+    case WF5803F_ERR_BUSY:
+        return CMD_ERR_BUSY;
+    default:
+        Cmd_ReplyAppend(reply, "\"error\":\"i2c\"");
+        return CMD_ERR_VALUE;
+    }
+
+    Cmd_ReplyAppend(reply, "\"mode\":\"%s\",\"odr\":%u,\"sleep_ms\":%.1f,\"osr\":%u,\"model\":\"%s\"",
+                    argv[0], (unsigned int)config.odr,
+                    config.odr * (WF5803F_ODR_STEP_US / 1000.0f),
+                    (unsigned int)cmd_wf_osr[config.osr], WF5803F_ConvModel()->name);
+    return CMD_OK;
+}
+
+/**
+ * @brief  i2c [1|2]: 查询 I2C 总线统计 (默认 I2C1)
+ * @note   每个设备先输出一行 {"type":"i2c",...}，应答中为总线级计数
+ */
+static Cmd_Status_t Command_I2c(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    I2cBus_DevStats_t dev[I2CBUS_DEV_MAX];
+    I2cBus_t *bus = &i2c_bus1;
+    unsigned int count = 0;
+
+    if (argc > 0) {
+        if (strcmp(argv[0], "2") == 0) {
+            bus = &i2c_bus2;
+        } else if (strcmp(argv[0], "1") != 0) {
+            return CMD_ERR_VALUE;
+        }
+    }
+
+    I2cBus_GetStats(bus, dev);
+    for (int i = 0; i < I2CBUS_DEV_MAX; i++) {
+        const uint32_t *h = dev[i].hist;
+
+        if (dev[i].addr == 0) continue;
+        count++;
+        Command_SendLine("{\"type\":\"i2c\",\"bus\":%u,\"addr\":\"0x%02X\",\"xfer\":%u,\"nack\":%u,"
+                         "\"timeout\":%u,\"err\":%u,\"retry\":%u,\"hist\":[%u,%u,%u,%u,%u,%u,%u,%u]}\n",
+                         (unsigned int)bus->id, (unsigned int)dev[i].addr,
+                         (unsigned int)dev[i].xfers, (unsigned int)dev[i].nacks,
+                         (unsigned int)dev[i].timeouts, (unsigned int)dev[i].errors,
+                         (unsigned int)dev[i].retries,
+                         (unsigned int)h[0], (unsigned int)h[1], (unsigned int)h[2], (unsigned int)h[3],
+                         (unsigned int)h[4], (unsigned int)h[5], (unsigned int)h[6], (unsigned int)h[7]);
+    }
+
+    Cmd_ReplyAppend(reply, "\"bus\":%u,\"speed\":%u,\"recover\":%u,\"recover_fail\":%u,"
+                           "\"queue_full\":%u,\"queue_high\":%u,\"kick_fail\":%u,\"devices\":%u",
+                    (unsigned int)bus->id, (unsigned int)I2cBus_GetSpeed(bus),
+                    (unsigned int)bus->recoveries, (unsigned int)bus->recover_fail,
+                    (unsigned int)bus->queue_full, (unsigned int)bus->queue_high,
+                    (unsigned int)bus->kick_fail, count);
+    return CMD_OK;
+}
+
+/**
+ * @brief  flt [preset] [median]: 设置/查询当前通道的 NTC 滤波级 (IIR 预设和中值窗口)
+ * @note   无参数时只查询；新配置由采集任务在下一个采样应用，应答中 cyc 为上一次处理的周期数
+ */
+static Cmd_Status_t Command_Filter(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    SensorFilter_t *filter = &TempCtrl_GetChannel(cmd_channel)->filter;
+    SensorFilter_Preset_t preset = filter->preset;
+    uint8_t median = filter->median_len;
+    uint32_t value;
+    Cmd_Status_t status;
+
+    if (argc > 0) {
+        preset = SensorFilter_FindPreset(argv[0]);
+        if (preset == SENSOR_FILTER_PRESETS) return CMD_ERR_VALUE;
+    }
+    if (argc > 1) {
+        status = Cmd_ParseU32(argv[1], &value);
+        if (status != CMD_OK) return status;
+        if (value > SENSOR_FILTER_MEDIAN_MAX) return CMD_ERR_RANGE;
+        median = (uint8_t)value;
+    }
+    if (argc > 0 && SensorFilter_Configure(filter, preset, median) != 0) {
+        return CMD_ERR_RANGE;
+    }
+
+    Cmd_ReplyAppend(reply, "\"preset\":\"%s\",\"stages\":%u,\"median\":%u,\"out\":%.3f,"
+                           "\"cyc\":%u,\"cyc_max\":%u",
+                    SensorFilter_GetDesign(preset)->name,
+                    (unsigned int)SensorFilter_GetDesign(preset)->stages, (unsigned int)median,
+                    filter->output,
+                    (unsigned int)filter->cycles_last, (unsigned int)filter->cycles_max);
+    return CMD_OK;
+}
+
+/**
+ * @brief  ch [n] [on|off]: 选择温控命令 (get/sp/kp/ki/kd/db/lim/flt) 的目标通道，并可启用/关闭该通道
+ * @note   无参数时只查询；启用状态由采集任务在下一个控制周期应用 (PID 清零、滤波器重新预置)，
+ *         关闭的通道 PWM 保持为 0
+ */
+static Cmd_Status_t Command_Channel(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c;
+    uint32_t value = cmd_channel;
+    uint32_t mask = 0;
+    Cmd_Status_t status;
+
+    if (argc > 0) {
+        status = Cmd_ParseU32(argv[0], &value);
+        if (status != CMD_OK) return status;
+    }
+    c = TempCtrl_GetChannel(value);
+    if (c == NULL) return CMD_ERR_RANGE;
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "on") == 0) {
+            c->enabled = 1;
+        } else if (strcmp(argv[1], "off") == 0) {
+            c->enabled = 0;
+        } else {
+            return CMD_ERR_VALUE;
+        }
+    }
+    cmd_channel = value;
+
+    for (uint32_t i = 0; i < TEMPCTRL_CHANNELS; i++) {
+        if (tempctrl_ch[i].enabled) {
+            mask |= 1U << i;
+        }
+    }
+    Cmd_ReplyAppend(reply, "\"ch\":%u,\"en\":%u,\"mask\":%u,\"fault\":%u,\"fault_n\":%u",
+                    (unsigned int)cmd_channel, (unsigned int)c->enabled, (unsigned int)mask,
+                    (unsigned int)c->check.fault, (unsigned int)c->check.count);
+    return CMD_OK;
+}
+
+/**
+ * @brief  kf [on|off] | kf <r_ntc> <r_wf> [q]: 通道 1 卡尔曼融合 (见 temp_fusion.h)
+ * @note   on/off 选择 PID 输入用融合估计还是滤波级输出；数值参数修改观测方差 (°C^2)
+ *         和过程噪声，下一个控制周期生效。应答: x/dx 为温度和变化率估计，
+ *         in/sd/n 为 NTC、WF5803F 新息的均值、标准差和观测数，nis 约为 1 时噪声模型合适
+ */
+static Cmd_Status_t Command_Fusion(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempFusion_t *kf = &tempctrl_fusion;
+    const TempFusion_Innov_t *in_ntc = &kf->innov[TEMP_FUSION_NTC];
+    const TempFusion_Innov_t *in_wf = &kf->innov[TEMP_FUSION_WF];
+    float r_ntc = kf->r[TEMP_FUSION_NTC];
+    float r_wf = kf->r[TEMP_FUSION_WF];
+    float q = kf->q;
+    int result;
+    Cmd_Status_t status;
+
+    if (argc == 1) {
+        if (strcmp(argv[0], "on") == 0) {
+            tempctrl_fusion_enabled = 1;
+        } else if (strcmp(argv[0], "off") == 0) {
+            tempctrl_fusion_enabled = 0;
+        } else {
+            return CMD_ERR_VALUE;
+        }
+    } else if (argc > 1) {
+        status = Cmd_ParseFloat(argv[0], &r_ntc);
+        if (status != CMD_OK) return status;
+        status = Cmd_ParseFloat(argv[1], &r_wf);
+        if (status != CMD_OK) return status;
+        if (argc > 2) {
+            status = Cmd_ParseFloat(argv[2], &q);
+            if (status != CMD_OK) return status;
+        }
+
+        // 三个参数一起修改，采集任务不会用到新旧混合的噪声模型
+        taskENTER_CRITICAL();
+        result = TempFusion_SetNoise(kf, q, r_ntc, r_wf);
+        taskEXIT_CRITICAL();
+        if (result != 0) return CMD_ERR_RANGE;
+    }
+
+    Cmd_ReplyAppend(reply, "\"en\":%u,\"x\":%.3f,\"dx\":%.4f,\"q\":%.6f,\"r\":[%.4f,%.4f],"
+                           "\"in\":[%.3f,%.3f],\"sd\":[%.3f,%.3f],\"n\":[%u,%u],\"nis\":%.2f,\"cyc\":%u",
+                    (unsigned int)tempctrl_fusion_enabled, kf->x[0], kf->x[1], q, r_ntc, r_wf,
+                    in_ntc->mean, in_wf->mean, sqrtf(in_ntc->var), sqrtf(in_wf->var),
+                    (unsigned int)in_ntc->count, (unsigned int)in_wf->count,
+                    kf->nis, (unsigned int)kf->cycles_max);
+    return CMD_OK;
+}
+
+/**
+ * @brief  ctl [ms|reset]: 查询控制循环周期统计，修改周期 (1 ~ 1000ms) 或清零统计
+ * @note   新周期和清零在采集任务下一次等待时生效 (修改周期同时清零统计)；时间单位为 µs，
+ *         jit 为实测周期与标称周期之差的最大绝对值，over 为超时周期数，dt 为通道 1 PID 的实测采样间隔
+ */
+static Cmd_Status_t Command_Loop(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    CtrlLoop_Stats_t stats;
+    uint32_t period = CtrlLoop_GetPeriod();
+    Cmd_Status_t status;
+
+    if (argc > 0) {
+        if (strcmp(argv[0], "reset") == 0) {
+            CtrlLoop_ResetStats();
+        } else {
+            status = Cmd_ParseU32(argv[0], &period);
+            if (status != CMD_OK) return status;
+            if (CtrlLoop_SetPeriod(period) != 0) return CMD_ERR_RANGE;
+        }
+    }
+
+    CtrlLoop_GetStats(&stats);
+    Cmd_ReplyAppend(reply, "\"ms\":%u,\"n\":%u,\"over\":%u,\"per\":%u,\"min\":%u,\"max\":%u,"
+                           "\"jit\":%u,\"busy\":%u,\"busy_max\":%u,\"dt\":%.4f",
+                    (unsigned int)period, (unsigned int)stats.count, (unsigned int)stats.overruns,
+                    (unsigned int)DwtTime_ToUs(stats.period_last),
+                    (unsigned int)DwtTime_ToUs(stats.period_min),
+                    (unsigned int)DwtTime_ToUs(stats.period_max),
+                    (unsigned int)DwtTime_ToUs(stats.jitter_max),
+                    (unsigned int)DwtTime_ToUs(stats.busy_last),
+                    (unsigned int)DwtTime_ToUs(stats.busy_max),
+                    TempCtrl_GetChannel(1)->dt);
+    return CMD_OK;
+}
+
+/**
+ * @brief  pid [pos|f32|q31|q15]: 当前通道的 PID 后端 (见 pid_ctrl.h)
+ * @note   不带参数时查询；后端名请求切换，下一次 PID 计算生效 (无扰切换)。
+ *         各后端的闭环仿真对比在上位机做 (Host/tools/pid_bench)，板上耗时看应答的 cyc/cyc_max
+ */
+static Cmd_Status_t Command_Pid(int argc, char *argv[], Cmd_Reply_t *reply)
+{
+    TempCtrl_Channel_t *c = TempCtrl_GetChannel(cmd_channel);
+    PID_Controller_t *pid = &c->pid;
+    PID_Backend_t backend;
+
+    if (argc > 0) {
+        backend = PID_FindBackend(argv[0]);
+        if (backend == PID_BACKENDS) return CMD_ERR_VALUE;
+        PID_SetBackend(pid, backend);
+    }
+
+    Cmd_ReplyAppend(reply, "\"ch\":%u,\"be\":\"%s\",\"req\":\"%s\",\"i\":%.3f,\"err_fs\":%.3f,"
+                           "\"cyc\":%u,\"cyc_max\":%u",
+                    (unsigned int)cmd_channel, PID_BackendName(pid->backend),
+                    PID_BackendName((PID_Backend_t)pid->backend_request),
+                    pid->integral, pid->dsp_err_fs,
+                    (unsigned int)c->pid_cycles_last, (unsigned int)c->pid_cycles_max);
+    return CMD_OK;
+}
@@ -0,0 +1,158 @@
+/**
+  ******************************************************************************
+  * @file           : ctrl_loop.c
+  * @brief          : Fixed-rate control loop scheduling
+  *                   固定周期控制循环实现
+  ******************************************************************************
+  * @attention
+  *
+  * 唤醒节拍用 RTOS 节拍 (osKernelSysTick)，与 osDelayUntil 使用同一时基；
+  * 实测周期和工作时间用 DwtTime_Now，分辨率为一个 CPU 周期。
+  * 统计在临界区内更新和复制，命令任务读到的是一致的快照。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ctrl_loop.h"
+#include "cmsis_os.h"
+#include "dwt_time.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+static volatile uint32_t ctrl_loop_request = CTRL_LOOP_PERIOD_MS;  // 命令任务写入的周期
+static volatile uint8_t ctrl_loop_reset_req;                        // 命令任务请求清零统计
+static uint32_t ctrl_loop_wake_tick;        // 本周期起点 (RTOS 节拍)
+static uint64_t ctrl_loop_wake_time;        // 本周期起点 (DWT)
+static uint8_t ctrl_loop_skip;              // 1: 本次间隔不计入周期统计 (第一个周期)
+static CtrlLoop_Stats_t ctrl_loop_stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void CtrlLoop_ClearStats(uint32_t period_ms);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  以当前时刻作为第一个周期的起点
+ */
+void CtrlLoop_Start(void)
+{
+    CtrlLoop_ClearStats(ctrl_loop_request);
+    ctrl_loop_wake_tick = osKernelSysTick();
+    ctrl_loop_wake_time = DwtTime_Now();
+    ctrl_loop_skip = 1;
+}
+
+/**
+ * @brief  结束本周期并等待下一个周期起点
+ */
+uint32_t CtrlLoop_Wait(void)
+{
+    uint32_t period_ms = ctrl_loop_request;
+    uint32_t busy = (uint32_t)(DwtTime_Now() - ctrl_loop_wake_time);
+    uint32_t nominal;
+    uint32_t measured;
+    uint32_t jitter;
+    uint64_t now;
+
+    // 清零请求或周期修改: 统计只反映当前周期
+    if (ctrl_loop_reset_req || period_ms != ctrl_loop_stats.period_ms) {
+        ctrl_loop_reset_req = 0;
+        CtrlLoop_ClearStats(period_ms);
+    }
+
+    // 已错过下一个周期起点: 不补跑，以当前节拍为起点重新对齐 (osDelayUntil 立即返回)
+    if ((uint32_t)(osKernelSysTick() - ctrl_loop_wake_tick) > period_ms) {
+        ctrl_loop_wake_tick = osKernelSysTick() - period_ms;
+        taskENTER_CRITICAL();
+        ctrl_loop_stats.overruns++;
+        taskEXIT_CRITICAL();
+    }
+    osDelayUntil(&ctrl_loop_wake_tick, period_ms);
+
+    now = DwtTime_Now();
+    measured = (uint32_t)(now - ctrl_loop_wake_time);
+    ctrl_loop_wake_time = now;
+    nominal = period_ms * (SystemCoreClock / 1000U);
+    jitter = (measured > nominal) ? (measured - nominal) : (nominal - measured);
+
+    taskENTER_CRITICAL();
+    ctrl_loop_stats.period_ms = period_ms;
+    ctrl_loop_stats.count++;
+    ctrl_loop_stats.busy_last = busy;
+    if (busy > ctrl_loop_stats.busy_max) {
+        ctrl_loop_stats.busy_max = busy;
+    }
+    if (!ctrl_loop_skip) {
+        ctrl_loop_stats.period_last = measured;
+        if (measured < ctrl_loop_stats.period_min) {
+            ctrl_loop_stats.period_min = measured;
+        }
+        if (measured > ctrl_loop_stats.period_max) {
+            ctrl_loop_stats.period_max = measured;
+        }
+        if (jitter > ctrl_loop_stats.jitter_max) {
+            ctrl_loop_stats.jitter_max = jitter;
+        }
+    }
+    taskEXIT_CRITICAL();
+    ctrl_loop_skip = 0;
+
+    return period_ms;
+}
+
+/**
+ * @brief  请求修改周期
+ */
+int CtrlLoop_SetPeriod(uint32_t period_ms)
+{
+    if (period_ms < CTRL_LOOP_PERIOD_MIN_MS || period_ms > CTRL_LOOP_PERIOD_MAX_MS) return -1;
+
+    ctrl_loop_request = period_ms;
+    return 0;
+}
+
+/**
+ * @brief  获取请求的周期
+ */
+uint32_t CtrlLoop_GetPeriod(void)
+{
+    return ctrl_loop_request;
+}
+
+/**
+ * @brief  获取统计快照
+ */
+void CtrlLoop_GetStats(CtrlLoop_Stats_t *stats)
+{
+    if (stats == NULL) return;
+
+    taskENTER_CRITICAL();
+    *stats = ctrl_loop_stats;
+    taskEXIT_CRITICAL();
+    if (stats->period_min > stats->period_max) {
+        stats->period_min = 0;      // 还没有有效间隔
+    }
+}
+
+/**
+ * @brief  请求清零统计
+ */
+void CtrlLoop_ResetStats(void)
+{
+    ctrl_loop_reset_req = 1;
+}
+
+/**
+ * @brief  清零统计
+ * @param  period_ms: 当前标称周期
+ * @retval None
+ */
+static void CtrlLoop_ClearStats(uint32_t period_ms)
+{
+    taskENTER_CRITICAL();
+    memset(&ctrl_loop_stats, 0, sizeof(ctrl_loop_stats));
+    ctrl_loop_stats.period_ms = period_ms;
+    ctrl_loop_stats.period_min = UINT32_MAX;
+    taskEXIT_CRITICAL();
+}
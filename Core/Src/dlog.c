@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file           : dlog.c
+  * @brief          : Deferred (host-side formatted) logging
+  *                   延迟格式化日志实现
+  ******************************************************************************
+  * @attention
+  *
+  * 负载格式: 日志ID (uint16) | 参数1 | 参数2 | ...，参数编码见 dlog.h
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dlog.h"
+#include "tlm_frame.h"
+#include "usart.h"
+#include <stdatomic.h>
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+static atomic_uint dlog_seq;
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  发送一条延迟格式化日志
+ * @param  id: 日志 ID (格式字符串在 .log_fmt 段内的地址)
+ * @param  nargs: 参数个数
+ * @param  args: 参数数组
+ * @retval None
+ * @note   参数超出单帧负载时，字符串被截断，其余数值参数丢弃
+ */
+void DLog_Write(uint16_t id, uint32_t nargs, const DLog_Arg_t *args)
+{
+    uint8_t payload[TLM_FRAME_PAYLOAD_MAX];
+    uint8_t frame[TLM_FRAME_WIRE_MAX];
+    size_t len = 0;
+    size_t n;
+
+    payload[len++] = (uint8_t)(id & 0xFF);
+    payload[len++] = (uint8_t)(id >> 8);
+
+    for (uint32_t i = 0; i < nargs; i++) {
+        if (args[i].type == DLOG_ARG_STR) {
+            const char *s = (args[i].v.s != NULL) ? args[i].v.s : "";
+            if (len >= sizeof(payload)) break;
+            while (*s != '\0' && len < sizeof(payload) - 1) {
+                payload[len++] = (uint8_t)*s++;
+            }
+            payload[len++] = '\0';
+        } else {
+            if (len + 4 > sizeof(payload)) break;
+            // int32 与 float 均按 4 字节小端原样拷贝
+            memcpy(&payload[len], &args[i].v, 4);
+            len += 4;
+        }
+    }
+
+    n = TlmFrame_Build(TLM_FRAME_TYPE_LOG, (uint16_t)atomic_fetch_add(&dlog_seq, 1),
+                       HAL_GetTick(), payload, len, frame);
+    if (n > 0) {
+        UartTx_Write(&uart2_tx, frame, (uint32_t)n);
+    }
+}
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file           : dwt_time.c
+  * @brief          : 64-bit cycle timestamps from the DWT cycle counter
+  *                   64 位 CPU 周期时间戳实现
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dwt_time.h"
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t dwt_time_high;      // 回绕次数 (时间戳高 32 位)
+static uint32_t dwt_time_last;      // 上一次读到的 CYCCNT
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  开启 DWT 周期计数器并清零时间戳
+ */
+void DwtTime_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    dwt_time_high = 0;
+    dwt_time_last = 0;
+}
+
+/**
+ * @brief  当前时间戳
+ */
+uint64_t DwtTime_Now(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t now;
+    uint64_t t;
+
+    // 读 CYCCNT 和更新扩展状态之间不能被打断，否则较早的读数会把 high 多加一次
+    __disable_irq();
+    now = DWT->CYCCNT;
+    if (now < dwt_time_last) {
+        dwt_time_high++;
+    }
+    dwt_time_last = now;
+    t = ((uint64_t)dwt_time_high << 32) | now;
+    __set_PRIMASK(primask);
+
+    return t;
+}
+
+/**
+ * @brief  推进回绕扩展
+ */
+void DwtTime_Update(void)
+{
+    (void)DwtTime_Now();
+}
+
+/**
+ * @brief  CPU 周期数换算为微秒
+ */
+uint64_t DwtTime_ToUs(uint64_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000U);
+}
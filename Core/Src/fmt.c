@@ -0,0 +1,375 @@
+/**
+  ******************************************************************************
+  * @file           : fmt.c
+  * @brief          : Allocation-free formatter
+  *                   轻量格式化输出实现
+  ******************************************************************************
+  * @attention
+  *
+  * 所有数字先从低位到高位写入固定大小的局部缓冲区，再统一处理符号和填充。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fmt.h"
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/* Private define ------------------------------------------------------------*/
+#define FMT_FLAG_LEFT     0x01U   // '-' 左对齐
+#define FMT_FLAG_ZERO     0x02U   // '0' 补零
+#define FMT_FLAG_PLUS     0x04U   // '+' 正数显示 '+'
+#define FMT_FLAG_SPACE    0x08U   // ' ' 正数前加空格
+
+#define FMT_FLOAT_PREC_MAX  9     // %f 最大精度
+#define FMT_NUM_BUF_SIZE    24    // 可容纳 64 位整数 (八进制22位) 或 定点浮点
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+ * @brief 输出游标
+ */
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t pos;     // 已"输出"的字符数 (可能超过 size)
+} Fmt_Out_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t fmt_pow10[FMT_FLOAT_PREC_MAX + 1] = {
+    1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void Fmt_PutChar(Fmt_Out_t *out, char c);
+static void Fmt_PutField(Fmt_Out_t *out, char sign, const char *digits, int len,
+                         int width, uint32_t flags);
+static int Fmt_Utoa(uint64_t value, uint32_t base, int upper, char *end);
+static int Fmt_Ftoa(float value, int prec, char *end);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  格式化到缓冲区 (语义同 vsnprintf)
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小 (含结尾 '\0')
+ * @param  format: 格式字符串
+ * @param  args: 可变参数
+ * @retval 完整输出所需的字符数 (不含 '\0')，>= size 表示被截断
+ */
+int Fmt_Vsnprintf(char *buf, size_t size, const char *format, va_list args)
+{
+    Fmt_Out_t out = { buf, size, 0 };
+    char num[FMT_NUM_BUF_SIZE];
+    char *num_end = num + FMT_NUM_BUF_SIZE;
+
+    while (*format != '\0') {
+        if (*format != '%') {
+            Fmt_PutChar(&out, *format++);
+            continue;
+        }
+
+        const char *spec_start = format++;
+        uint32_t flags = 0;
+        int width = 0;
+        int prec = -1;
+        int lng = 0;    // 'l' 个数
+
+        // 1. 标志
+        for (;;) {
+            if (*format == '-')      flags |= FMT_FLAG_LEFT;
+            else if (*format == '0') flags |= FMT_FLAG_ZERO;
+            else if (*format == '+') flags |= FMT_FLAG_PLUS;
+            else if (*format == ' ') flags |= FMT_FLAG_SPACE;
+            else break;
+            format++;
+        }
+
+        // 2. 宽度
+        if (*format == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                flags |= FMT_FLAG_LEFT;
+                width = -width;
+            }
+            format++;
+        } else {
+            while (*format >= '0' && *format <= '9') {
+                width = width * 10 + (*format++ - '0');
+            }
+        }
+
+        // 3. 精度
+        if (*format == '.') {
+            format++;
+            prec = 0;
+            if (*format == '*') {
+                prec = va_arg(args, int);
+                format++;
+            } else {
+                while (*format >= '0' && *format <= '9') {
+                    prec = prec * 10 + (*format++ - '0');
+                }
+            }
+        }
+
+        // 4. 长度修饰符 (Cortex-M 上 int/long/size_t 均为 32 位)
+        while (*format == 'l' || *format == 'h' || *format == 'z') {
+            if (*format == 'l') lng++;
+            format++;
+        }
+
+        char sign = '\0';
+        const char *digits = num_end;
+        int len = 0;
+        char conv = *format;
+        if (conv == '\0') {
+            break;
+        }
+        format++;
+
+        switch (conv) {
+        case 'd':
+        case 'i': {
+            int64_t v = (lng >= 2) ? va_arg(args, long long) : (int64_t)va_arg(args, int);
+            uint64_t u = (v < 0) ? (uint64_t)(-(v + 1)) + 1U : (uint64_t)v;
+            if (v < 0)                        sign = '-';
+            else if (flags & FMT_FLAG_PLUS)   sign = '+';
+            else if (flags & FMT_FLAG_SPACE)  sign = ' ';
+            len = Fmt_Utoa(u, 10, 0, num_end);
+            digits = num_end - len;
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o': {
+            uint64_t u = (lng >= 2) ? va_arg(args, unsigned long long) : (uint64_t)va_arg(args, unsigned int);
+            uint32_t base = (conv == 'u') ? 10U : (conv == 'o') ? 8U : 16U;
+            len = Fmt_Utoa(u, base, conv == 'X', num_end);
+            digits = num_end - len;
+            break;
+        }
+        case 'p': {
+            uintptr_t u = (uintptr_t)va_arg(args, void *);
+            len = Fmt_Utoa(u, 16, 0, num_end);
+            digits = num_end - len;
+            sign = 'x';   // 以 "0x" 前缀输出，见下
+            break;
+        }
+        case 'c':
+            num[0] = (char)va_arg(args, int);
+            digits = num;
+            len = 1;
+            flags &= ~FMT_FLAG_ZERO;
+            break;
+        case 's': {
+            const char *s = va_arg(args, const char *);
+            if (s == NULL) s = "(null)";
+            while (s[len] != '\0' && (prec < 0 || len < prec)) len++;
+            digits = s;
+            flags &= ~FMT_FLAG_ZERO;
+            break;
+        }
+        case 'f':
+        case 'F': {
+            float v = (float)va_arg(args, double);
+            if (prec < 0) prec = 6;
+            if (prec > FMT_FLOAT_PREC_MAX) prec = FMT_FLOAT_PREC_MAX;
+            if (signbit(v)) {
+                sign = '-';
+                v = -v;
+            } else if (flags & FMT_FLAG_PLUS) {
+                sign = '+';
+            } else if (flags & FMT_FLAG_SPACE) {
+                sign = ' ';
+            }
+            len = Fmt_Ftoa(v, prec, num_end);
+            digits = num_end - len;
+            if (digits[0] == 'n' || digits[0] == 'i') {
+                flags &= ~FMT_FLAG_ZERO;   // nan/inf 不补零
+            }
+            break;
+        }
+        case '%':
+            Fmt_PutChar(&out, '%');
+            continue;
+        default:
+            // 不支持的转换说明，原样输出
+            while (spec_start < format) {
+                Fmt_PutChar(&out, *spec_start++);
+            }
+            continue;
+        }
+
+        if (sign == 'x') {
+            Fmt_PutChar(&out, '0');
+            Fmt_PutChar(&out, 'x');
+            sign = '\0';
+            width -= 2;
+        }
+        Fmt_PutField(&out, sign, digits, len, width, flags);
+    }
+
+    // 结尾 '\0'
+    if (size > 0) {
+        buf[(out.pos < size) ? out.pos : size - 1] = '\0';
+    }
+
+    return (int)out.pos;
+}
+
+/**
+ * @brief  格式化到缓冲区 (语义同 snprintf)
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小 (含结尾 '\0')
+ * @param  format: 格式字符串
+ * @retval 完整输出所需的字符数 (不含 '\0')
+ */
+int Fmt_Snprintf(char *buf, size_t size, const char *format, ...)
+{
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = Fmt_Vsnprintf(buf, size, format, args);
+    va_end(args);
+
+    return len;
+}
+
+/**
+ * @brief  输出一个字符，超出缓冲区时只计数
+ */
+static void Fmt_PutChar(Fmt_Out_t *out, char c)
+{
+    if (out->pos + 1 < out->size) {
+        out->buf[out->pos] = c;
+    }
+    out->pos++;
+}
+
+/**
+ * @brief  输出一个字段 (符号 + 数字串)，按宽度和标志填充
+ */
+static void Fmt_PutField(Fmt_Out_t *out, char sign, const char *digits, int len,
+                         int width, uint32_t flags)
+{
+    int pad = width - len - (sign != '\0' ? 1 : 0);
+
+    if (!(flags & FMT_FLAG_LEFT) && !(flags & FMT_FLAG_ZERO)) {
+        while (pad-- > 0) Fmt_PutChar(out, ' ');
+    }
+    if (sign != '\0') {
+        Fmt_PutChar(out, sign);
+    }
+    if (!(flags & FMT_FLAG_LEFT) && (flags & FMT_FLAG_ZERO)) {
+        while (pad-- > 0) Fmt_PutChar(out, '0');
+    }
+    for (int i = 0; i < len; i++) {
+        Fmt_PutChar(out, digits[i]);
+    }
+    while (pad-- > 0) {
+        Fmt_PutChar(out, ' ');
+    }
+}
+
+/**
+ * @brief  无符号整数转字符串，从 end 向前写
+ * @retval 写入的字符数
+ */
+static int Fmt_Utoa(uint64_t value, uint32_t base, int upper, char *end)
+{
+    const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char *p = end;
+
+    // 32 位范围内只用 32 位除法，避免调用 64 位除法库函数
+    if (value <= UINT32_MAX) {
+        uint32_t v = (uint32_t)value;
+        do {
+            *--p = hex[v % base];
+            v /= base;
+        } while (v != 0);
+    } else {
+        do {
+            *--p = hex[value % base];
+            value /= base;
+        } while (value != 0);
+    }
+
+    return (int)(end - p);
+}
+
+/**
+ * @brief  非负浮点数转定点小数字符串，从 end 向前写
+ * @param  value: 非负值
+ * @param  prec: 小数位数 (0 ~ FMT_FLOAT_PREC_MAX)
+ * @param  end: 缓冲区末尾
+ * @retval 写入的字符数
+ * @note   单精度值精确等于 mant / 2^shift，整数部分、小数部分和舍入余数都用整数运算精确得到，
+ *         恰好为一半时向偶数舍入，结果与 printf 相同
+ */
+static int Fmt_Ftoa(float value, int prec, char *end)
+{
+    char *p = end;
+    uint32_t bits;
+    uint32_t mant;
+    int shift;
+    uint64_t ipart;
+    uint32_t fpart = 0;
+
+    if (value != value) {
+        p -= 3; p[0] = 'n'; p[1] = 'a'; p[2] = 'n';
+        return 3;
+    }
+    if (value > 1.8e19f) {
+        p -= 3; p[0] = 'i'; p[1] = 'n'; p[2] = 'f';   // 超出 uint64 的数值也按 inf 处理
+        return 3;
+    }
+
+    // 1. 拆成 24 位尾数和二进制小数位数 (非规格化数的指数按 1 计)
+    memcpy(&bits, &value, sizeof(bits));
+    mant = bits & 0x7FFFFFU;
+    if ((bits >> 23) != 0) {
+        mant |= 0x800000U;
+        shift = 150 - (int)(bits >> 23);
+    } else {
+        shift = 149;
+    }
+
+    // 2. 整数部分；小数部分 k / 2^shift 乘以 10^prec 后取整 (k × 10^prec < 2^54)，
+    //    余数与一半比较决定舍入，进位可能传到整数部分。shift >= 64 时小数部分小于 2^-40，舍去
+    if (shift <= 0) {
+        ipart = (uint64_t)mant << -shift;
+    } else if (shift < 64) {
+        uint64_t mask = (1ULL << shift) - 1U;
+        uint64_t scaled = (uint64_t)(mant & mask) * fmt_pow10[prec];
+        uint64_t rem = scaled & mask;
+        uint64_t half = 1ULL << (shift - 1);
+
+        ipart = (shift < 32) ? (mant >> shift) : 0U;
+        fpart = (uint32_t)(scaled >> shift);
+        if (rem > half || (rem == half && (((prec > 0) ? fpart : (uint32_t)ipart) & 1U))) {
+            fpart++;
+            if (fpart >= fmt_pow10[prec]) {
+                fpart -= fmt_pow10[prec];
+                ipart++;
+            }
+        }
+    } else {
+        ipart = 0;
+    }
+
+    if (prec > 0) {
+        for (int i = 0; i < prec; i++) {
+            *--p = (char)('0' + fpart % 10U);
+            fpart /= 10U;
+        }
+        *--p = '.';
+    }
+    p -= Fmt_Utoa(ipart, 10, 0, p);
+
+    return (int)(end - p);
+}
@@ -33,6 +33,13 @@
 #include "WF5803F.h"
 #include "NTC.h"
 #include "V_detect.h"
+#include "telemetry.h"
+#include "command.h"
+#include "baud_neg.h"
+#include "i2c_bus.h"
+#include "sensor_filter.h"
+#include "sensor_check.h"
+#include "ctrl_loop.h"
 /* USER CODE END Includes */
 
 /* Private includes ----------------------------------------------------------*/
@@ -48,6 +55,13 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 #define VOLTAGE_CHECK_INTERVAL  600000  // 电压检测间隔: 10分钟 (600000 ms)
+#define WF_CHECK_TEMP_MIN       (-40.0f)  // WF5803F 温度量程 (°C)
+#define WF_CHECK_TEMP_MAX       125.0f
+#define WF_CHECK_TEMP_RATE      5.0f      // 相邻采样最大变化 (°C)
+#define WF_CHECK_PRESS_RATE     20.0f     // 相邻采样最大变化 (kPa)
+#define WF_CHECK_STUCK_N        20        // 气压连续 20 个采样 (10s) 完全相同判为卡死
+#define WF_CHECK_RECOVER        4         // 连续 4 个有效采样后清除故障
+#define WF_SAMPLE_PERIOD_MS     500       // WF5803F 读取和采样上报周期 (ms)，控制周期更短时每隔几个周期读一次
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -58,13 +72,13 @@
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
 volatile uint8_t g_lowVoltageFlag = 0;  // 低电压标志: 0=正常, 1=低压
-extern PID_Controller_t temp_pid_CN1; // CN1通道PID控制器
+volatile uint8_t g_autoSetpointEnable = 1;  // 调试用自动切换目标温度: 1=开启, "sp <温度>" 命令后关闭
 /* USER CODE END Variables */
 osThreadId defaultTaskHandle;
 osThreadId Sensors_and_computeHandle;
 osThreadId voltageMonitorHandle;
 osThreadId receiveAndTargetChangeHandle;
-osMessageQId usart_rx_queueHandle;
+osThreadId telemetryHandle;
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
@@ -75,6 +89,7 @@ void StartDefaultTask(void const * argument);
 void StartSensors_and_compute(void const * argument);
 void StartVoltageMonitorTask(void const * argument);
 void StartReceiveAndTargetChangeTask(void const * argument);
+void StartTelemetryTask(void const * argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
@@ -94,6 +109,22 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
 }
 /* USER CODE END GET_IDLE_TASK_MEMORY */
 
+/* GetTimerTaskMemory prototype (linked to static allocation support) */
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+
+/* USER CODE BEGIN GET_TIMER_TASK_MEMORY */
+static StaticTask_t xTimerTaskTCBBuffer;
+static StackType_t xTimerStack[configTIMER_TASK_STACK_DEPTH];
+
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+  *ppxTimerTaskTCBBuffer = &xTimerTaskTCBBuffer;
+  *ppxTimerTaskStackBuffer = &xTimerStack[0];
+  *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+  /* place for user code */
+}
+/* USER CODE END GET_TIMER_TASK_MEMORY */
+
 /**
   * @brief  FreeRTOS initialization
   * @param  None
@@ -118,9 +149,13 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_QUEUES */
   /* add queues, ... */
-  /* definition and creation of usart_rx_queue */
-  osMessageQDef(usart_rx_queue, 16, uint32_t);
-  usart_rx_queueHandle = osMessageCreate(osMessageQ(usart_rx_queue), NULL);
+  /* USART2 接收流缓冲区 usart_rx_streamHandle 在 MX_USART2_UART_Init 中静态创建 */
+  /* I2C 总线事务队列和看门狗定时器 */
+  I2cBus_Init();
+  /* 采样缓冲池与待发队列 (采集任务 -> 上报任务) */
+  Telemetry_Init();
+  /* WF5803F 异步采集 (定时器 + 结果队列) */
+  WF5803F_Init(NULL);
   /* USER CODE END RTOS_QUEUES */
 
   /* Create the thread(s) */
@@ -133,13 +168,17 @@ void MX_FREERTOS_Init(void) {
   defaultTaskHandle = osThreadCreate(osThread(defaultTask), NULL);
 
   /* definition and creation of receiveAndTargetChange - USART接收任务，高优先级 */
-  osThreadDef(receiveAndTargetChange, StartReceiveAndTargetChangeTask, osPriorityHigh, 0, 256);
+  osThreadDef(receiveAndTargetChange, StartReceiveAndTargetChangeTask, osPriorityHigh, 0, 384);
   receiveAndTargetChangeHandle = osThreadCreate(osThread(receiveAndTargetChange), NULL);
   
   /* definition and creation of Sensors_and_compute - 传感器与计算任务 */
   osThreadDef(Sensors_and_compute, StartSensors_and_compute, osPriorityNormal, 0, 512);
   Sensors_and_computeHandle = osThreadCreate(osThread(Sensors_and_compute), NULL);
   
+  /* definition and creation of telemetry - 数据上报任务，低于采集任务 */
+  osThreadDef(telemetry, StartTelemetryTask, osPriorityBelowNormal, 0, 384);
+  telemetryHandle = osThreadCreate(osThread(telemetry), NULL);
+
   /* definition and creation of voltageMonitorTask - 最低优先级 */
   osThreadDef(voltageMonitor, StartVoltageMonitorTask, osPriorityLow, 0, 256);
   voltageMonitorHandle = osThreadCreate(osThread(voltageMonitor), NULL);
@@ -178,20 +217,48 @@ void StartDefaultTask(void const * argument)
   * 
   * 功能：传感器读取与计算任务，包含：
   * - WF5803F 温度和气压检测
-  * - NTC 温度检测
+  * - NTC 温度检测 (TempCtrl_Update，全部温控通道)，通道 1 与 WF5803F 温度卡尔曼融合
+  * - PID 计算与加热输出
+  * - 传感器有效性检查 (sensor_check.h)，故障随采样上报
   * - 后续可添加其他传感器和计算逻辑
+  * 采样结果写入缓冲池后交给 telemetry 任务上报，本任务不做格式化和串口发送
+  * 循环按固定周期运行 (ctrl_loop.h，缺省 500ms，1 ~ 1000ms 可调)，WF5803F 每 WF_SAMPLE_PERIOD_MS 启动一次采集，结果在之后的周期中不阻塞地取回
   */
 void StartSensors_and_compute(void const * argument)
 {
-  float temperature;
-  float pressure;
-  float Temp_NTC;
-  uint32_t adcValue;
-  HAL_StatusTypeDef status;
+  float temperature = 0.0f;
+  float pressure = 0.0f;
+  TempCtrl_Channel_t *cn1 = &tempctrl_ch[0];
+  WF5803F_Sample_t wf = {0};
+  const WF5803F_Config_t wf_config = { WF5803F_MODE_CONTINUOUS, 1, WF5803F_OSR_4096X };  // 约 62.5ms + 转换时间
+  Telemetry_Slot_t *slot;
+  const WF5803F_Model_t *model = &wf5803f_models[WF5803F_MODEL];
+  const SensorCheck_Limits_t wf_temp_limits = {
+    WF_CHECK_TEMP_MIN, WF_CHECK_TEMP_MAX, WF_CHECK_TEMP_RATE, 0, WF_CHECK_RECOVER
+  };
+  const SensorCheck_Limits_t wf_press_limits = {
+    model->p_min_pa / 1000.0f, (model->p_min_pa + model->p_span_pa) / 1000.0f,
+    WF_CHECK_PRESS_RATE, WF_CHECK_STUCK_N, WF_CHECK_RECOVER
+  };
+  SensorCheck_t wf_temp_check;
+  SensorCheck_t wf_press_check;
+  uint8_t wf_ok = 0;
+  uint8_t wf_pending = 0;   // 已启动采集，结果尚未取回
+  uint8_t wf_done;          // 本周期得到了一次采集结果 (成功或失败)
+  uint32_t wf_elapsed = WF_SAMPLE_PERIOD_MS;   // 第一个周期就读取
+  uint32_t fault;
 
   send_message("=== Sensors_and_compute Task Started! ===\n");
+  SensorCheck_Init(&wf_temp_check, &wf_temp_limits);
+  SensorCheck_Init(&wf_press_check, &wf_press_limits);
+
+  // WF5803F 连续转换: 传感器自行周期转换，每周期只需一次突发读
+  if (WF5803F_Configure(&wf_config) != WF5803F_OK) {
+    send_message("WF5803F configure failed, using single-shot mode\n");
+  }
   
   /* Infinite loop */
+  CtrlLoop_Start();
   for(;;)
   {
     // 检查低压标志，如果电压过低则挂起任务
@@ -201,48 +268,92 @@ void StartSensors_and_compute(void const * argument)
     }
     
     // ========== WF5803F 温度和气压检测 ==========
-    // 测试 I2C 通信
-    uint8_t test_cmd = 0x0A;
-    status = HAL_I2C_Mem_Write(&hi2c1, WF5803F_ADDR, WF5803F_REG_CTRL, I2C_MEMADD_SIZE_8BIT, &test_cmd, 1, 100);
-    
-    if (status == HAL_OK) {
-      // send_message("I2C Write OK\n");
-    } else {
-      // send_message("I2C Write Failed: %d\n", status);
+    // 按 WF_SAMPLE_PERIOD_MS 启动采集 (与控制周期无关；单次模式触发转换，连续模式直接突发读结果)，
+    // 结果在之后的周期中用 WF5803F_PollSample 取回，I2C 慢或失败时控制周期不受影响
+    wf_done = 0;
+    if (wf_elapsed >= WF_SAMPLE_PERIOD_MS) {
+      wf_elapsed = 0;
+      if (wf_pending) {
+        // 整个读取周期都没有结束 (驱动内部 WF5803F_TIMEOUT_MS 超时，正常不会发生): 本次记为超时
+        wf.result = WF5803F_ERR_TIMEOUT;
+        wf_done = 1;
+      } else {
+        wf.result = WF5803F_StartConversion();
+        wf_pending = (wf.result == WF5803F_OK);
+        wf_done = !wf_pending;              // 启动失败: 本次记为读取失败
+      }
+    }
+    if (wf_pending && !wf_done && WF5803F_PollSample(&wf) != WF5803F_ERR_BUSY) {
+      wf_pending = 0;
+      wf_done = 1;
     }
-    
-    // 获取温度和气压数据
-    WF5803F_GetData(&temperature, &pressure);
-    
-    
-    
-    // ========== NTC 温度检测 ==========
-    // 读取 ADC 值
-    adcValue = Read_ADC0();
-    
-    // 计算温度
-    Temp_NTC = compute_ntc_temperature(adcValue);
-
 
-    //调试使用，自动切换目标温度
-    if (Temp_NTC >38.0f){
-      PID_SetSetpoint(&temp_pid_CN1, TARGET_TEMP_1);
+    if (wf_done) {
+      // 错误计入 WF5803F_GetStats；读取失败或检查不通过时沿用上一次的有效值，故障位随采样上报
+      wf_ok = (wf.result == WF5803F_OK);
+      SensorCheck_Update(&wf_temp_check, wf.temperature, wf_ok);
+      SensorCheck_Update(&wf_press_check, wf.pressure, wf_ok);
+      if (SensorCheck_IsValid(&wf_temp_check) && SensorCheck_IsValid(&wf_press_check)) {
+        temperature = wf.temperature;
+        pressure = wf.pressure;
+      }
+      TempCtrl_SetReference(wf.temperature, wf_ok && SensorCheck_IsValid(&wf_temp_check));
     }
-    else if (Temp_NTC < 29.5f){
-      PID_SetSetpoint(&temp_pid_CN1, TARGET_TEMP_2);
-    
+
+    // ========== NTC 温度检测 + PID 计算与加热输出 ==========
+    // 全部温控通道: 过采样 ADC -> 温度 -> 滤波 -> PID -> TIM3 PWM (未启用的通道保持关断)
+    // 在 WF5803F 之后执行，通道 1 的卡尔曼融合使用最新的 WF5803F 温度；
+    // 只在有新的过采样结果时计算，PID 使用实测采样间隔
+    TempCtrl_Update();
+
+
+    //调试使用，自动切换通道1目标温度，下一周期生效 (通过 "sp <温度>" 命令设定目标后停止切换)
+    if (g_autoSetpointEnable) {
+      if (cn1->temp >38.0f){
+        PID_SetSetpoint(&cn1->pid, TARGET_TEMP_1);
+      }
+      else if (cn1->temp < 29.5f){
+        PID_SetSetpoint(&cn1->pid, TARGET_TEMP_2);
+      }
     }
 
     // ========== 后续可在此处添加其他传感器读取和计算逻辑 ==========
-    PID_Compute(&temp_pid_CN1, Temp_NTC);
-    Set_Heating_PWM((uint32_t)temp_pid_CN1.output);
     
-    // 通过串口发送传感器数据 (JSON格式，分三条发送便于串口监控)
-    send_message("{\"type\":\"data\",\"sensor\":\"WF5803\",\"temp\":%.2f,\"press\":%.2f}\n", temperature, pressure);
-    send_message("{\"type\":\"data\",\"sensor\":\"NTC\",\"temp\":%.2f}\n", Temp_NTC);
-    send_message("{\"type\":\"data\",\"sensor\":\"PID\",\"output\":%.2f}\n", temp_pid_CN1.output);
-    // 延时1秒
-    osDelay(500);
+    if (wf_done) {
+      // 采样交给 telemetry 任务上报 (缓冲池空时本次丢弃，不阻塞控制环)，每次取回 WF5803F 结果后一条
+      fault = (uint32_t)(wf_temp_check.fault | wf_press_check.fault) << TLM_FAULT_SHIFT_WF;
+      for (uint8_t i = 0; i < TEMPCTRL_CHANNELS; i++) {
+        fault |= (uint32_t)tempctrl_ch[i].check.fault << TLM_FAULT_SHIFT_NTC(i);
+      }
+
+      slot = Telemetry_Alloc();
+      if (slot != NULL) {
+        slot->sample.wf_temp = temperature;
+        slot->sample.wf_press = pressure;
+        slot->sample.ntc_temp = cn1->temp_raw;
+        slot->sample.pid_output = cn1->active ? cn1->pid.output : 0.0f;
+        slot->sample.fault = fault;
+        slot->sample.t_cycles = cn1->t_sample;
+        slot->sample.age_cycles = (uint32_t)(cn1->t_sample - cn1->t_input);
+        slot->sample.ctl_cycles = (cn1->t_output >= cn1->t_sample) ? (uint32_t)(cn1->t_output - cn1->t_sample) : 0U;
+        slot->sample.wf_cycles = wf_ok ? wf.cycles : 0U;
+        slot->thermal.mask = 0;
+        for (uint8_t i = 0; i < TEMPCTRL_CHANNELS; i++) {
+          const TempCtrl_Channel_t *c = &tempctrl_ch[i];
+
+          if (c->active) {
+            slot->thermal.mask |= (uint8_t)(1U << i);
+          }
+          slot->thermal.ch[i].temp = c->temp;
+          slot->thermal.ch[i].setpoint = c->pid.setpoint;
+          slot->thermal.ch[i].output = c->active ? c->pid.output : 0.0f;
+        }
+        Telemetry_Post(slot);
+      }
+    }
+
+    // 按绝对节拍等待下一个控制周期 (周期可由 "ctl" 命令修改，统计见 ctrl_loop.h)
+    wf_elapsed += CtrlLoop_Wait();
   }
 }
 
@@ -282,7 +393,7 @@ void StartVoltageMonitorTask(void const * argument)
       if (g_lowVoltageFlag == 0) {
         // 检测到低压，挂起其他任务
         g_lowVoltageFlag = 1;
-        // TempCtrl_EmergencyStop(&temp_pid_CN1); // 紧急关闭加热
+        // TempCtrl_EmergencyStop(); // 紧急关闭加热 (全部通道)
         send_message("!!! LOW VOLTAGE ALERT !!!\n");
         send_message("Suspending All tasks...\n");
         
@@ -313,53 +424,53 @@ void StartVoltageMonitorTask(void const * argument)
   * @retval None
   * 
   * 功能：USART 接收与目标处理任务（最高优先级）
-  * - 阻塞等待从 USART 接收队列读取数据
-  * - 收到数据后立即处理
-  * - 可用于接收命令、改变目标值等操作
+  * - 阻塞等待 USART2 接收流缓冲区中的数据
+  * - DMA 每收到一段数据 (半满/全满/空闲线) 唤醒一次
+  * - 按行解析上位机命令 (设置目标温度、PID 参数、上报模式等)，见 command.h
   * 
   * 优先级：最高 (osPriorityRealtime)
   * 特点：阻塞式读取，死等数据到来
   */
 void StartReceiveAndTargetChangeTask(void const * argument)
 {
-  osEvent event;
-  uint8_t received_byte;
+  uint8_t rx_chunk[32];
+  size_t rx_len;
   
+  Command_Init();
   send_message("=== USART Receive Task Started (Priority: Realtime) ===\n");
  
   /* Infinite loop */
   for(;;)
   {
-    // 阻塞读取队列，永久等待直到有数据到来
-    event = osMessageGet(usart_rx_queueHandle, osWaitForever);
+    // 阻塞读取接收流缓冲区；平时永久等待，波特率协商期间定时返回推进状态机
+    rx_len = xStreamBufferReceive(usart_rx_streamHandle, rx_chunk, sizeof(rx_chunk), BaudNeg_WaitTicks());
     
-    if (event.status == osEventMessage) {
-      // 成功接收到数据
-      received_byte = (uint8_t)event.value.v;
-      
-      // 发送接收到的数据信息
-      send_message("Received byte from USART2: '%c' (0x%02X)\n", 
-                   received_byte, received_byte);
-      // ========== 在此处添加命令处理逻辑 ==========
-      if(received_byte  == '1'){
-        if(temp_pid_CN1.setpoint != TARGET_TEMP_1){
-          PID_SetSetpoint(&temp_pid_CN1, TARGET_TEMP_1);
-          send_message("Target temperature set to %.2f°C\n", TARGET_TEMP_1);
-        } else{
-          PID_SetSetpoint(&temp_pid_CN1, TARGET_TEMP_2);
-          send_message("Target temperature already at %.2f°C\n", TARGET_TEMP_2);
-        }
-      } else if(received_byte  == '2'){
-        
-          temp_pid_CN1.Kp= temp_pid_CN1.Kp + 1.0f;
-          send_message("Kp value increased to %.2f\n", temp_pid_CN1.Kp);
-        }
-
-      }
+    // 组装成行并执行命令，每条命令回复一行 JSON 应答
+    Command_Feed(rx_chunk, rx_len);
+    BaudNeg_Poll();
     
-    // 注意：不需要 osDelay，因为 osMessageGet 本身就是阻塞的
+    // 注意：不需要 osDelay，因为 xStreamBufferReceive 本身就是阻塞的
     // 当没有数据时，任务会自动进入阻塞状态，让出 CPU
   }
 }
 
+/**
+  * @brief  Function implementing the telemetry thread.
+  * @param  argument: Not used
+  * @retval None
+  *
+  * 功能：数据上报任务
+  * - 阻塞等待采集任务提交的采样槽
+  * - 按上报模式/通道格式化或组帧后写入串口发送缓冲区，再归还采样槽
+  *
+  * 优先级：osPriorityBelowNormal，串口输出慢时只会积压在缓冲池中，不影响控制环
+  */
+void StartTelemetryTask(void const * argument)
+{
+  for(;;)
+  {
+    Telemetry_Process(portMAX_DELAY);
+  }
+}
+
 /* USER CODE END Application */
\ No newline at end of file
@@ -0,0 +1,527 @@
+/**
+  ******************************************************************************
+  * @file           : i2c_bus.c
+  * @brief          : I2C bus layer implementation
+  *                   I2C 总线层实现
+  ******************************************************************************
+  * @attention
+  *
+  * 执行器 (启动、完成、超时) 只在定时器服务任务中运行，对 active/seq 的修改无需加锁；
+  * 中断只读取 seq 并投递完成事件。统计更新放在临界区内，阻塞读写的重试计数在调用任务中记录。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2c_bus.h"
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define I2CBUS_RECOVER_PULSES   9       // 总线恢复时最多输出的 SCL 脉冲数
+#define I2CBUS_RECOVER_HALF_US  5       // 恢复时 SCL 半周期 (100kHz)
+#define I2CBUS_BITS_PER_BYTE    9       // 8 位数据 + ACK
+#define I2CBUS_MEM_OVERHEAD     4       // 地址 + 寄存器 + 重复起始地址 + 余量 (字节)
+#define I2CBUS_SEQ_SHIFT        2       // 完成事件参数: 高位为传输序号，低 2 位为 HAL 状态
+#define I2CBUS_STATUS_MASK      0x03U
+
+/* Exported variables --------------------------------------------------------*/
+I2cBus_t i2c_bus1 = {
+    .hi2c = &hi2c1, .id = 1,
+    .scl_port = GPIOB, .scl_pin = GPIO_PIN_8, .sda_port = GPIOB, .sda_pin = GPIO_PIN_9,
+};
+I2cBus_t i2c_bus2 = {
+    .hi2c = &hi2c2, .id = 2,
+    .scl_port = GPIOB, .scl_pin = GPIO_PIN_10, .sda_port = GPIOB, .sda_pin = GPIO_PIN_11,
+};
+
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t i2cbus_hist_edges_us[I2CBUS_HIST_BINS - 1] = I2CBUS_HIST_EDGES_US;
+
+/* Private function prototypes -----------------------------------------------*/
+static void I2cBus_InitBus(I2cBus_t *bus, const char *name);
+static void I2cBus_Kick(void *param, uint32_t unused);
+static void I2cBus_StartNext(I2cBus_t *bus);
+static HAL_StatusTypeDef I2cBus_Start(I2cBus_t *bus, I2cBus_Xfer_t *xfer);
+static void I2cBus_Done(void *param, uint32_t event);
+static void I2cBus_TimerCallback(TimerHandle_t timer);
+static void I2cBus_Finish(I2cBus_t *bus, HAL_StatusTypeDef status, uint32_t error);
+static void I2cBus_IrqEvent(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status);
+static HAL_StatusTypeDef I2cBus_Transfer(I2cBus_t *bus, uint16_t addr, uint8_t reg,
+                                         uint8_t *data, uint16_t len, uint8_t read);
+static void I2cBus_WakeCallback(I2cBus_Xfer_t *xfer);
+static int I2cBus_Cancel(I2cBus_t *bus, I2cBus_Xfer_t *xfer);
+static void I2cBus_Record(I2cBus_t *bus, uint16_t addr, HAL_StatusTypeDef status, uint32_t error, uint32_t cycles);
+static I2cBus_DevStats_t *I2cBus_FindDev(I2cBus_t *bus, uint16_t addr);
+static uint32_t I2cBus_Timeout(const I2cBus_t *bus, uint16_t len);
+static void I2cBus_DelayUs(uint32_t us);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化总线层 (事务队列、看门狗定时器)
+ * @retval None
+ * @note   耗时统计和恢复时的微秒延时使用的 DWT 周期计数器由 DwtTime_Init 开启
+ */
+void I2cBus_Init(void)
+{
+    I2cBus_InitBus(&i2c_bus1, "i2c1");
+    I2cBus_InitBus(&i2c_bus2, "i2c2");
+}
+
+/**
+ * @brief  提交一个传输 (立即返回)
+ */
+HAL_StatusTypeDef I2cBus_Submit(I2cBus_t *bus, I2cBus_Xfer_t *xfer)
+{
+    uint32_t depth;
+    uint8_t kick;
+
+    if (xQueueSend(bus->queue, &xfer, 0) != pdTRUE) {
+        bus->queue_full++;
+        return HAL_BUSY;
+    }
+
+    depth = (uint32_t)uxQueueMessagesWaiting(bus->queue);
+    taskENTER_CRITICAL();
+    if (depth > bus->queue_high) bus->queue_high = depth;
+    kick = !bus->kick_pending;
+    bus->kick_pending = 1;
+    taskEXIT_CRITICAL();
+
+    // 总线忙时由当前传输完成后接着启动
+    if (!kick) return HAL_OK;
+
+    // 已在定时器服务任务中 (描述符回调、驱动定时器回调): 直接启动，不向自身的命令队列投递
+    if (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle()) {
+        I2cBus_Kick(bus, 0);
+        return HAL_OK;
+    }
+
+    // 命令队列满时等待服务任务取走命令；仍失败则撤回描述符，不让它留在队列中无人启动
+    if (xTimerPendFunctionCall(I2cBus_Kick, bus, 0, pdMS_TO_TICKS(I2CBUS_KICK_WAIT_MS)) != pdPASS) {
+        bus->kick_pending = 0;
+        bus->kick_fail++;
+        if (I2cBus_Cancel(bus, xfer) == 0) {
+            return HAL_BUSY;
+        }
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  阻塞读寄存器 (经事务队列，带超时、重试和总线恢复)
+ */
+HAL_StatusTypeDef I2cBus_MemRead(I2cBus_t *bus, uint16_t addr, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    return I2cBus_Transfer(bus, addr, reg, data, len, 1);
+}
+
+/**
+ * @brief  阻塞写寄存器 (经事务队列，带超时、重试和总线恢复)
+ */
+HAL_StatusTypeDef I2cBus_MemWrite(I2cBus_t *bus, uint16_t addr, uint8_t reg, const uint8_t *data, uint16_t len)
+{
+    return I2cBus_Transfer(bus, addr, reg, (uint8_t *)data, len, 0);
+}
+
+/**
+ * @brief  总线恢复: 9 个 SCL 脉冲 + STOP，然后重新初始化外设
+ * @param  bus: 总线
+ * @retval HAL_OK: SDA 已释放，HAL_ERROR: SDA 仍被拉低
+ */
+HAL_StatusTypeDef I2cBus_Recover(I2cBus_t *bus)
+{
+    GPIO_InitTypeDef gpio = {0};
+    GPIO_PinState sda;
+
+    bus->recoveries++;
+
+    // 1. 释放外设 (MspDeInit 同时停止 DMA)，引脚改为开漏输出 (空闲为高)
+    HAL_I2C_DeInit(bus->hi2c);
+
+    gpio.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_WritePin(bus->scl_port, bus->scl_pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(bus->sda_port, bus->sda_pin, GPIO_PIN_SET);
+    gpio.Pin = bus->scl_pin;
+    HAL_GPIO_Init(bus->scl_port, &gpio);
+    gpio.Pin = bus->sda_pin;
+    HAL_GPIO_Init(bus->sda_port, &gpio);
+    I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+
+    // 2. SDA 被从机拉低时输出 SCL 脉冲，让从机把当前字节移完后释放 SDA
+    for (int i = 0; i < I2CBUS_RECOVER_PULSES; i++) {
+        if (HAL_GPIO_ReadPin(bus->sda_port, bus->sda_pin) == GPIO_PIN_SET) break;
+        HAL_GPIO_WritePin(bus->scl_port, bus->scl_pin, GPIO_PIN_RESET);
+        I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+        HAL_GPIO_WritePin(bus->scl_port, bus->scl_pin, GPIO_PIN_SET);
+        I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+    }
+
+    // 3. STOP: SCL 为高时 SDA 由低变高
+    HAL_GPIO_WritePin(bus->scl_port, bus->scl_pin, GPIO_PIN_RESET);
+    I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+    HAL_GPIO_WritePin(bus->sda_port, bus->sda_pin, GPIO_PIN_RESET);
+    I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+    HAL_GPIO_WritePin(bus->scl_port, bus->scl_pin, GPIO_PIN_SET);
+    I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+    HAL_GPIO_WritePin(bus->sda_port, bus->sda_pin, GPIO_PIN_SET);
+    I2cBus_DelayUs(I2CBUS_RECOVER_HALF_US);
+    sda = HAL_GPIO_ReadPin(bus->sda_port, bus->sda_pin);
+
+    // 4. 重新初始化 (MspInit 恢复复用功能、DMA 和中断，HAL_I2C_Init 内含软件复位)
+    HAL_I2C_Init(bus->hi2c);
+
+    if (sda != GPIO_PIN_SET) {
+        bus->recover_fail++;
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  获取设备统计快照
+ */
+void I2cBus_GetStats(const I2cBus_t *bus, I2cBus_DevStats_t *dev)
+{
+    taskENTER_CRITICAL();
+    memcpy(dev, bus->dev, sizeof(bus->dev));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief  当前 CPU 周期计数 (DWT->CYCCNT)
+ */
+uint32_t I2cBus_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  获取总线当前时钟频率
+ */
+uint32_t I2cBus_GetSpeed(const I2cBus_t *bus)
+{
+    return bus->hi2c->Init.ClockSpeed;
+}
+
+/**
+ * @brief  创建一条总线的事务队列和看门狗定时器
+ */
+static void I2cBus_InitBus(I2cBus_t *bus, const char *name)
+{
+    bus->queue = xQueueCreateStatic(I2CBUS_QUEUE_LEN, sizeof(I2cBus_Xfer_t *),
+                                    bus->queue_storage, &bus->queue_struct);
+    bus->timer = xTimerCreateStatic(name, 1, pdFALSE, bus, I2cBus_TimerCallback, &bus->timer_struct);
+}
+
+/**
+ * @brief  提交后的启动请求 (定时器服务任务)
+ */
+static void I2cBus_Kick(void *param, uint32_t unused)
+{
+    I2cBus_t *bus = (I2cBus_t *)param;
+
+    bus->kick_pending = 0;
+    if (bus->active == NULL) {
+        I2cBus_StartNext(bus);
+    }
+}
+
+/**
+ * @brief  从队列取出下一个描述符并启动，启动失败的直接完成后继续取下一个
+ * @note   回调中再次提交时可能已经启动了下一个，active 非空时停止
+ */
+static void I2cBus_StartNext(I2cBus_t *bus)
+{
+    I2cBus_Xfer_t *xfer;
+    HAL_StatusTypeDef status;
+    uint32_t error;
+
+    while (bus->active == NULL && xQueueReceive(bus->queue, &xfer, 0) == pdTRUE) {
+        bus->active = xfer;
+        bus->seq++;
+        bus->timeout_ms = I2cBus_Timeout(bus, xfer->len);
+        bus->start_tick = HAL_GetTick();
+        bus->start_cycles = I2cBus_Cycles();
+
+        status = I2cBus_Start(bus, xfer);
+        if (status == HAL_OK) {
+            xTimerChangePeriod(bus->timer, pdMS_TO_TICKS(bus->timeout_ms) + 1, 0);
+            return;
+        }
+
+        // 外设空闲但总线一直忙 (SCL/SDA 被拉低)，恢复后结束该传输并继续
+        error = bus->hi2c->ErrorCode;
+        if (status == HAL_BUSY && bus->hi2c->State == HAL_I2C_STATE_READY &&
+            __HAL_I2C_GET_FLAG(bus->hi2c, I2C_FLAG_BUSY)) {
+            I2cBus_Recover(bus);
+        }
+        I2cBus_Finish(bus, status, error);
+    }
+}
+
+/**
+ * @brief  启动一个传输: 读用 DMA (单字节或无 DMA 通道时用中断)，写用中断
+ */
+static HAL_StatusTypeDef I2cBus_Start(I2cBus_t *bus, I2cBus_Xfer_t *xfer)
+{
+    if (!xfer->read) {
+        return HAL_I2C_Mem_Write_IT(bus->hi2c, xfer->addr, xfer->reg, I2C_MEMADD_SIZE_8BIT,
+                                    xfer->data, xfer->len);
+    }
+    if (bus->hi2c->hdmarx != NULL && xfer->len > 1) {
+        return HAL_I2C_Mem_Read_DMA(bus->hi2c, xfer->addr, xfer->reg, I2C_MEMADD_SIZE_8BIT,
+                                    xfer->data, xfer->len);
+    }
+    return HAL_I2C_Mem_Read_IT(bus->hi2c, xfer->addr, xfer->reg, I2C_MEMADD_SIZE_8BIT,
+                               xfer->data, xfer->len);
+}
+
+/**
+ * @brief  传输完成事件 (定时器服务任务)
+ * @param  param: 总线
+ * @param  event: 传输序号 << I2CBUS_SEQ_SHIFT | HAL 状态
+ */
+static void I2cBus_Done(void *param, uint32_t event)
+{
+    I2cBus_t *bus = (I2cBus_t *)param;
+
+    if (bus->active == NULL || (event >> I2CBUS_SEQ_SHIFT) != (bus->seq & (UINT32_MAX >> I2CBUS_SEQ_SHIFT))) {
+        return;   // 超时结束后迟到的事件
+    }
+    xTimerStop(bus->timer, 0);
+    I2cBus_Finish(bus, (HAL_StatusTypeDef)(event & I2CBUS_STATUS_MASK), bus->hi2c->ErrorCode);
+    I2cBus_StartNext(bus);
+}
+
+/**
+ * @brief  当前传输超时 (定时器服务任务): 恢复总线，结束当前传输后继续
+ */
+static void I2cBus_TimerCallback(TimerHandle_t timer)
+{
+    I2cBus_t *bus = (I2cBus_t *)pvTimerGetTimerID(timer);
+    uint32_t elapsed = HAL_GetTick() - bus->start_tick;
+    uint32_t error;
+
+    if (bus->active == NULL) return;
+    if (elapsed < bus->timeout_ms) {
+        // 上一个传输的定时器到期时下一个已启动，按当前传输重新计时
+        xTimerChangePeriod(bus->timer, pdMS_TO_TICKS(bus->timeout_ms - elapsed) + 1, 0);
+        return;
+    }
+
+    error = bus->hi2c->ErrorCode | HAL_I2C_ERROR_TIMEOUT;
+    bus->seq++;   // 作废当前传输迟到的完成事件
+    I2cBus_Recover(bus);
+    I2cBus_Finish(bus, HAL_TIMEOUT, error);
+    I2cBus_StartNext(bus);
+}
+
+/**
+ * @brief  结束当前传输: 记录统计、填写结果并回调
+ * @note   回调后不再访问描述符 (阻塞读写的描述符在调用任务栈上)
+ */
+static void I2cBus_Finish(I2cBus_t *bus, HAL_StatusTypeDef status, uint32_t error)
+{
+    I2cBus_Xfer_t *xfer = bus->active;
+
+    bus->active = NULL;
+    I2cBus_Record(bus, xfer->addr, status, error, I2cBus_Cycles() - bus->start_cycles);
+    xfer->status = status;
+    xfer->error = error;
+    if (xfer->callback != NULL) {
+        xfer->callback(xfer);
+    }
+}
+
+/**
+ * @brief  I2C/DMA 中断中的完成事件转交定时器服务任务
+ */
+static void I2cBus_IrqEvent(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status)
+{
+    I2cBus_t *bus = (hi2c == &hi2c1) ? &i2c_bus1 : (hi2c == &hi2c2) ? &i2c_bus2 : NULL;
+    BaseType_t woken = pdFALSE;
+
+    if (bus == NULL) return;
+
+    // 投递失败时事件丢失，由看门狗超时兜底
+    xTimerPendFunctionCallFromISR(I2cBus_Done, bus,
+                                  (bus->seq << I2CBUS_SEQ_SHIFT) | ((uint32_t)status & I2CBUS_STATUS_MASK),
+                                  &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief  阻塞读写: 提交描述符并等待完成，失败时退避重试
+ */
+static HAL_StatusTypeDef I2cBus_Transfer(I2cBus_t *bus, uint16_t addr, uint8_t reg,
+                                         uint8_t *data, uint16_t len, uint8_t read)
+{
+    StaticSemaphore_t done_struct;
+    SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&done_struct);
+    I2cBus_Xfer_t xfer = {
+        .addr = addr, .reg = reg, .read = read, .data = data, .len = len,
+        .callback = I2cBus_WakeCallback, .ctx = done,
+    };
+    HAL_StatusTypeDef status = HAL_ERROR;
+    I2cBus_DevStats_t *dev;
+
+    for (uint32_t attempt = 0; attempt <= I2CBUS_RETRY_MAX; attempt++) {
+        if (attempt > 0) {
+            taskENTER_CRITICAL();
+            dev = I2cBus_FindDev(bus, addr);
+            if (dev != NULL) dev->retries++;
+            taskEXIT_CRITICAL();
+            osDelay(I2CBUS_BACKOFF_MS << (attempt - 1));
+        }
+
+        xfer.status = HAL_TIMEOUT;
+        status = I2cBus_Submit(bus, &xfer);
+        if (status != HAL_OK) continue;
+
+        // 超时后从队列撤回从未启动的描述符；已在执行的必须等回调 (描述符在本任务栈上)，
+        // I2cBus_Cancel 确保其看门狗在运行，最迟在传输超时后结束
+        while (xSemaphoreTake(done, pdMS_TO_TICKS(I2CBUS_WAIT_MS)) != pdTRUE) {
+            if (I2cBus_Cancel(bus, &xfer) == 0) {
+                taskENTER_CRITICAL();
+                dev = I2cBus_FindDev(bus, addr);
+                if (dev != NULL) dev->timeouts++;
+                taskEXIT_CRITICAL();
+                break;
+            }
+        }
+        status = xfer.status;
+        if (status == HAL_OK) break;
+    }
+
+    vSemaphoreDelete(done);
+    return status;
+}
+
+/**
+ * @brief  阻塞读写的完成回调: 唤醒等待的任务
+ */
+static void I2cBus_WakeCallback(I2cBus_Xfer_t *xfer)
+{
+    xSemaphoreGive((SemaphoreHandle_t)xfer->ctx);
+}
+
+/**
+ * @brief  从队列中撤回一个尚未启动的描述符
+ * @retval 0: 已撤回 (不会回调)；-1: 不在队列中 (正在执行或已完成)
+ * @note   在任务中调用。描述符正在执行而看门狗未运行 (执行器重设定时器时命令队列满) 时补设
+ */
+static int I2cBus_Cancel(I2cBus_t *bus, I2cBus_Xfer_t *xfer)
+{
+    I2cBus_Xfer_t *item;
+    UBaseType_t count;
+    int found = 0;
+    uint8_t active;
+
+    // 挂起调度器，执行器不会同时取队列；其余描述符按原顺序放回
+    vTaskSuspendAll();
+    count = uxQueueMessagesWaiting(bus->queue);
+    while (count-- > 0 && xQueueReceive(bus->queue, &item, 0) == pdTRUE) {
+        if (item == xfer) {
+            found = 1;
+        } else {
+            xQueueSend(bus->queue, &item, 0);
+        }
+    }
+    active = (bus->active == xfer);
+    (void)xTaskResumeAll();
+
+    if (found) return 0;
+    if (active && xTimerIsTimerActive(bus->timer) == pdFALSE) {
+        xTimerChangePeriod(bus->timer, pdMS_TO_TICKS(bus->timeout_ms) + 1, pdMS_TO_TICKS(I2CBUS_KICK_WAIT_MS));
+    }
+    return -1;
+}
+
+/**
+ * @brief  记录一次传输结果 (定时器服务任务)
+ */
+static void I2cBus_Record(I2cBus_t *bus, uint16_t addr, HAL_StatusTypeDef status, uint32_t error, uint32_t cycles)
+{
+    uint32_t us = cycles / (SystemCoreClock / 1000000U);
+    uint32_t bin = 0;
+    I2cBus_DevStats_t *dev;
+
+    while (bin < I2CBUS_HIST_BINS - 1 && us >= i2cbus_hist_edges_us[bin]) {
+        bin++;
+    }
+
+    taskENTER_CRITICAL();
+    dev = I2cBus_FindDev(bus, addr);
+    if (dev != NULL) {
+        dev->xfers++;
+        if (status == HAL_OK) {
+            dev->hist[bin]++;
+        } else if (error & HAL_I2C_ERROR_AF) {
+            dev->nacks++;
+        } else if (status == HAL_TIMEOUT || (error & HAL_I2C_ERROR_TIMEOUT)) {
+            dev->timeouts++;
+        } else {
+            dev->errors++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief  按地址查找设备统计槽，首次出现时分配
+ * @retval 统计槽，表满时返回 NULL
+ */
+static I2cBus_DevStats_t *I2cBus_FindDev(I2cBus_t *bus, uint16_t addr)
+{
+    uint8_t addr7 = (uint8_t)(addr >> 1);
+
+    for (int i = 0; i < I2CBUS_DEV_MAX; i++) {
+        if (bus->dev[i].addr == addr7) return &bus->dev[i];
+        if (bus->dev[i].addr == 0) {
+            bus->dev[i].addr = addr7;
+            return &bus->dev[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief  按传输长度和总线速度计算超时 (ms)
+ */
+static uint32_t I2cBus_Timeout(const I2cBus_t *bus, uint16_t len)
+{
+    uint32_t bits = (uint32_t)(len + I2CBUS_MEM_OVERHEAD) * I2CBUS_BITS_PER_BYTE;
+    uint32_t speed = I2cBus_GetSpeed(bus);
+
+    return I2CBUS_TIMEOUT_BASE_MS + (2U * bits * 1000U + speed - 1U) / speed;
+}
+
+/**
+ * @brief  微秒级忙等 (DWT 周期计数)
+ */
+static void I2cBus_DelayUs(uint32_t us)
+{
+    uint32_t start = I2cBus_Cycles();
+    uint32_t cycles = us * (SystemCoreClock / 1000000U);
+
+    while (I2cBus_Cycles() - start < cycles) {
+    }
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2cBus_IrqEvent(hi2c, HAL_OK);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2cBus_IrqEvent(hi2c, HAL_OK);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2cBus_IrqEvent(hi2c, HAL_ERROR);
+}
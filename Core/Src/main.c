@@ -20,6 +20,7 @@
 #include "main.h"
 #include "cmsis_os.h"
 #include "adc.h"
+#include "dma.h"
 #include "i2c.h"
 #include "usart.h"
 #include "gpio.h"
@@ -31,6 +32,8 @@
 #include "WF5803F.h"
 #include "NTC.h"
 #include "V_detect.h"
+#include "adc_scan.h"
+#include "dwt_time.h"
 
 /* USER CODE END Includes */
 
@@ -54,7 +57,6 @@
 /* USER CODE BEGIN PV */
 
 TIM_HandleTypeDef htim3; // TIM3句柄
-PID_Controller_t temp_pid_CN1; // CN1通道PID控制器
 
 
 /* USER CODE END PV */
@@ -97,11 +99,12 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  DwtTime_Init(); // 开启 DWT 周期计数器 (64 位时间戳、耗时统计)
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_I2C1_Init();
   MX_ADC1_Init();
   MX_I2C2_Init();
@@ -111,12 +114,16 @@ int main(void)
   /* USER CODE BEGIN 2 */
   // TempCtrl_Init(); // 初始化温度控制系统
   MX_TIM3_Init(); // 初始化TIM3为PWM输出
-  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);       // 启动CH1 PWM
-  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);       // 启动CH2 PWM
-  HAL_UART_Receive_IT(&huart2, &rx_byte, 1); // 启动USART2的中断接收，接收单个字节
-
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);       // 启动CH1 PWM (PC6)
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);       // 启动CH2 PWM (PC7)
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_3);       // 启动CH3 PWM (PC8)
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_4);       // 启动CH4 PWM (PC9)
+  USART2_StartReceive(); // 启动USART2的DMA循环接收 (空闲线检测)
+
+  AdcScan_Start(); // 启动 TIM2 触发的 ADC1 扫描 (NTC + 电源电压，DMA 循环缓冲区)
+  Delay_Blocking_ms(ADC_SCAN_FILL_MS); // 等缓冲区填满一轮，此时 SysTick/中断可能被屏蔽，不能用 HAL_Delay
   Detect_Power(); // 检测电源电压，必要时发送警告
-  TempCtrl_Init(&temp_pid_CN1); // 初始化温度控制系统，传入CN1通道PID控制器结构体指针
+  TempCtrl_Init(); // 初始化温度控制系统 (全部通道，缺省只启用通道1)
   /* USER CODE END 2 */
 
   /* Call init function for freertos objects (in cmsis_os2.c) */
@@ -211,9 +218,10 @@ void MX_TIM3_Init(void)
   sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
   HAL_TIM_PWM_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_1);
 
-  // 配置通道2
-  sConfigOC.Pulse = 0;
+  // 配置通道2~4 (与通道1相同)
   HAL_TIM_PWM_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_2);
+  HAL_TIM_PWM_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_3);
+  HAL_TIM_PWM_ConfigChannel(&htim3, &sConfigOC, TIM_CHANNEL_4);
 }
 
 /* USER CODE END 4 */
@@ -236,7 +244,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM1)
+  {
+    DwtTime_Update(); // 每 1ms 推进一次 CYCCNT 回绕扩展
+  }
   /* USER CODE END Callback 1 */
 }
 
@@ -261,7 +272,9 @@ void Detect_Power(void)
   float voltage;
   uint8_t voltageStatus;
   /*安全保护开始*/
-  Set_Heating_PWM(0); // 确保加热关闭
+  for (uint8_t ch = 0; ch < TEMPCTRL_CHANNELS; ch++) {
+    Set_Heating_PWM(ch, 0); // 确保加热关闭 (全部通道)
+  }
   /*安全保护结束*/
 
   // ========== 上电电压检测 ==========
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file           : ntc_conv.c
+  * @brief          : NTC temperature conversion
+  *                   NTC 温度换算: 运行时查表插值，公式版本用于调试和核对
+  ******************************************************************************
+  */
+
+#include "ntc_conv.h"
+#include "adc_scan_ovs.h"
+#include "arm_math.h"
+#include <math.h>
+
+#define NTC_CODE_SHIFT (20 - (16 - NTC_TABLE_BITS))   // ADC 码 -> arm_linear_interp_q15 的 12.20 输入
+
+_Static_assert(NTC_TABLE_CODE_MAX == ADC_SCAN_OVS_MAX, "NTC table full scale must match ADC oversampling");
+
+/**
+ * @brief  查表计算 NTC 温度 (ntc_table 线性插值，代替每次 logf 和浮点除法)
+ * @param  code  过采样 ADC 码 (0 ~ NTC_TABLE_CODE_MAX)
+ * @return 温度值，单位 摄氏度 (°C)，分辨率 1/NTC_TABLE_SCALE
+ */
+static float ntc_lookup(uint32_t code)
+{
+    if (code > NTC_TABLE_CODE_MAX) {
+        code = NTC_TABLE_CODE_MAX;
+    }
+    return arm_linear_interp_q15(ntc_table, (q31_t)(code << NTC_CODE_SHIFT), NTC_TABLE_SIZE)
+           / (float)NTC_TABLE_SCALE;
+}
+
+/**
+ * @brief  按公式计算 NTC 温度 (Beta 或 Steinhart-Hart，与查找表的生成公式一致)
+ * @param  ratio  Vout / Vref (0 ~ 1)
+ * @return 温度值，单位 摄氏度 (°C)
+ * @note   每次调用一次 logf，仅用于调试和核对查找表
+ */
+float compute_ntc_temperature_exact(float ratio)
+{
+    // 1. ADC 转电压
+    float vout = ratio * V_REF;
+
+    // 2. 由分压公式求 NTC 阻值
+    // R_ntc = R_series * Vout / (Vref - Vout)
+    float r_ntc = (NTC_R_SERIES * vout) / (V_REF - vout);
+
+    // 3. Beta / Steinhart-Hart 公式换算温度 (K)
+#if NTC_USE_STEINHART
+    float lnR = logf(r_ntc);
+    float tempK = 1.0f / ((float)NTC_SH_A + (float)NTC_SH_B * lnR + (float)NTC_SH_C * lnR * lnR * lnR);
+#else
+    float tempK = 1.0f / ( (1.0f/NTC_T0) + (1.0f/NTC_BETA) * logf(r_ntc / NTC_R0) );
+#endif
+
+    // 4. 转换为摄氏度
+    float tempC = tempK - 273.15f;
+
+    return tempC;
+}
+
+/**
+ * @brief  根据 ADC 数值计算 NTC 温度
+ * @param  adcValue  ADC 采样值 (0 ~ 4095 for 12-bit ADC)
+ * @return 温度值，单位 摄氏度 (°C)
+ */
+float compute_ntc_temperature(uint32_t adcValue)
+{
+    return ntc_lookup(adcValue << ADC_SCAN_OVS_BITS);
+}
+
+/**
+ * @brief  根据过采样 ADC 数值计算 NTC 温度
+ * @param  adcValue  过采样值 (0 ~ ADC_SCAN_OVS_MAX，16 位)
+ * @return 温度值，单位 摄氏度 (°C)
+ */
+float compute_ntc_temperature_ovs(uint32_t adcValue)
+{
+    return ntc_lookup(adcValue);
+}
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file           : ntc_table.c
+  * @brief          : NTC 温度查找表 (由 Host/tools/ntc_table_gen 生成，勿手工修改)
+  ******************************************************************************
+  */
+
+#include "ntc_param.h"
+
+// 生成时的参数，ntc_param.h 修改后需要重新生成
+_Static_assert(NTC_BETA == 3380.0f && NTC_R0 == 10000.0f && NTC_T0 == 298.15f &&
+               NTC_R_SERIES == 10000.0f && NTC_USE_STEINHART == 0 &&
+               NTC_SH_A == 6.2906366191e-04 && NTC_SH_B == 2.9585798817e-04 && NTC_SH_C == 0.0 &&
+               NTC_TABLE_BITS == 10 && NTC_TABLE_CODE_MAX == 65520U && NTC_TABLE_SCALE == 256 &&
+               NTC_TABLE_T_MIN == (-55) && NTC_TABLE_T_MAX == 127,
+               "ntc_param.h changed, regenerate ntc_table.c with Host/tools/ntc_table_gen");
+
+const int16_t ntc_table[NTC_TABLE_SIZE] = {
+     32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,
+     32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,
+     32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,
+     32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,
+     32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,  32512,
+     32512,  32512,  32512,  32512,  32492,  32257,  32028,  31803,  31583,  31368,
+     31157,  30950,  30747,  30547,  30352,  30160,  29971,  29786,  29604,  29426,
+     29250,  29077,  28907,  28740,  28575,  28413,  28253,  28096,  27941,  27789,
+     27639,  27491,  27345,  27201,  27059,  26919,  26781,  26644,  26510,  26377,
+     26246,  26117,  25989,  25863,  25738,  25615,  25493,  25373,  25254,  25137,
+     25020,  24906,  24792,  24680,  24569,  24459,  24350,  24243,  24136,  24031,
+     23927,  23824,  23722,  23620,  23520,  23421,  23323,  23226,  23129,  23034,
+     22940,  22846,  22753,  22661,  22570,  22480,  22390,  22301,  22213,  22126,
+     22040,  21954,  21869,  21785,  21701,  21618,  21536,  21454,  21373,  21293,
+     21213,  21134,  21055,  20977,  20900,  20823,  20747,  20671,  20596,  20522,
+     20448,  20374,  20301,  20229,  20157,  20086,  20015,  19944,  19874,  19805,
+     19736,  19667,  19599,  19531,  19464,  19397,  19331,  19265,  19199,  19134,
+     19069,  19005,  18941,  18877,  18814,  18751,  18689,  18627,  18565,  18504,
+     18443,  18382,  18322,  18262,  18202,  18143,  18084,  18025,  17967,  17909,
+     17851,  17794,  17736,  17680,  17623,  17567,  17511,  17456,  17400,  17345,
+     17290,  17236,  17182,  17128,  17074,  17021,  16967,  16915,  16862,  16810,
+     16757,  16705,  16654,  16602,  16551,  16500,  16450,  16399,  16349,  16299,
+     16249,  16199,  16150,  16101,  16052,  16003,  15955,  15906,  15858,  15811,
+     15763,  15715,  15668,  15621,  15574,  15527,  15481,  15434,  15388,  15342,
+     15297,  15251,  15206,  15160,  15115,  15070,  15026,  14981,  14937,  14893,
+     14849,  14805,  14761,  14717,  14674,  14631,  14588,  14545,  14502,  14459,
+     14417,  14375,  14332,  14290,  14249,  14207,  14165,  14124,  14083,  14041,
+     14000,  13960,  13919,  13878,  13838,  13797,  13757,  13717,  13677,  13637,
+     13598,  13558,  13519,  13479,  13440,  13401,  13362,  13323,  13284,  13246,
+     13207,  13169,  13131,  13093,  13055,  13017,  12979,  12941,  12904,  12866,
+     12829,  12791,  12754,  12717,  12680,  12643,  12607,  12570,  12533,  12497,
+     12461,  12424,  12388,  12352,  12316,  12280,  12245,  12209,  12173,  12138,
+     12103,  12067,  12032,  11997,  11962,  11927,  11892,  11857,  11823,  11788,
+     11753,  11719,  11685,  11650,  11616,  11582,  11548,  11514,  11480,  11446,
+     11413,  11379,  11346,  11312,  11279,  11245,  11212,  11179,  11146,  11113,
+     11080,  11047,  11014,  10981,  10949,  10916,  10884,  10851,  10819,  10786,
+     10754,  10722,  10690,  10658,  10626,  10594,  10562,  10530,  10498,  10467,
+     10435,  10403,  10372,  10341,  10309,  10278,  10247,  10215,  10184,  10153,
+     10122,  10091,  10060,  10029,   9999,   9968,   9937,   9907,   9876,   9846,
+      9815,   9785,   9754,   9724,   9694,   9664,   9633,   9603,   9573,   9543,
+      9513,   9483,   9454,   9424,   9394,   9364,   9335,   9305,   9275,   9246,
+      9216,   9187,   9158,   9128,   9099,   9070,   9041,   9011,   8982,   8953,
+      8924,   8895,   8866,   8837,   8808,   8780,   8751,   8722,   8693,   8665,
+      8636,   8608,   8579,   8550,   8522,   8494,   8465,   8437,   8409,   8380,
+      8352,   8324,   8296,   8267,   8239,   8211,   8183,   8155,   8127,   8099,
+      8072,   8044,   8016,   7988,   7960,   7933,   7905,   7877,   7850,   7822,
+      7794,   7767,   7739,   7712,   7684,   7657,   7630,   7602,   7575,   7548,
+      7520,   7493,   7466,   7439,   7411,   7384,   7357,   7330,   7303,   7276,
+      7249,   7222,   7195,   7168,   7141,   7114,   7087,   7061,   7034,   7007,
+      6980,   6953,   6927,   6900,   6873,   6847,   6820,   6793,   6767,   6740,
+      6714,   6687,   6661,   6634,   6608,   6581,   6555,   6528,   6502,   6476,
+      6449,   6423,   6397,   6370,   6344,   6318,   6292,   6265,   6239,   6213,
+      6187,   6161,   6135,   6108,   6082,   6056,   6030,   6004,   5978,   5952,
+      5926,   5900,   5874,   5848,   5822,   5796,   5770,   5744,   5718,   5692,
+      5667,   5641,   5615,   5589,   5563,   5537,   5511,   5486,   5460,   5434,
+      5408,   5383,   5357,   5331,   5305,   5280,   5254,   5228,   5202,   5177,
+      5151,   5125,   5100,   5074,   5048,   5023,   4997,   4971,   4946,   4920,
+      4895,   4869,   4843,   4818,   4792,   4767,   4741,   4715,   4690,   4664,
+      4639,   4613,   4588,   4562,   4537,   4511,   4486,   4460,   4434,   4409,
+      4383,   4358,   4332,   4307,   4281,   4256,   4230,   4205,   4179,   4154,
+      4128,   4103,   4077,   4052,   4026,   4001,   3975,   3949,   3924,   3898,
+      3873,   3847,   3822,   3796,   3771,   3745,   3720,   3694,   3669,   3643,
+      3617,   3592,   3566,   3541,   3515,   3490,   3464,   3438,   3413,   3387,
+      3362,   3336,   3310,   3285,   3259,   3233,   3208,   3182,   3156,   3131,
+      3105,   3079,   3054,   3028,   3002,   2976,   2951,   2925,   2899,   2873,
+      2848,   2822,   2796,   2770,   2744,   2718,   2693,   2667,   2641,   2615,
+      2589,   2563,   2537,   2511,   2485,   2459,   2433,   2407,   2381,   2355,
+      2329,   2303,   2277,   2251,   2225,   2199,   2173,   2146,   2120,   2094,
+      2068,   2042,   2015,   1989,   1963,   1936,   1910,   1884,   1857,   1831,
+      1804,   1778,   1752,   1725,   1699,   1672,   1645,   1619,   1592,   1566,
+      1539,   1512,   1486,   1459,   1432,   1405,   1379,   1352,   1325,   1298,
+      1271,   1244,   1217,   1190,   1163,   1136,   1109,   1082,   1055,   1028,
+      1000,    973,    946,    919,    891,    864,    837,    809,    782,    754,
+       727,    699,    671,    644,    616,    588,    561,    533,    505,    477,
+       449,    421,    394,    366,    337,    309,    281,    253,    225,    197,
+       168,    140,    112,     83,     55,     26,     -2,    -31,    -60,    -88,
+      -117,   -146,   -175,   -204,   -232,   -261,   -290,   -320,   -349,   -378,
+      -407,   -436,   -466,   -495,   -525,   -554,   -584,   -613,   -643,   -673,
+      -702,   -732,   -762,   -792,   -822,   -852,   -882,   -913,   -943,   -973,
+     -1004,  -1034,  -1065,  -1095,  -1126,  -1157,  -1188,  -1218,  -1249,  -1280,
+     -1311,  -1343,  -1374,  -1405,  -1436,  -1468,  -1499,  -1531,  -1563,  -1595,
+     -1626,  -1658,  -1690,  -1722,  -1755,  -1787,  -1819,  -1851,  -1884,  -1917,
+     -1949,  -1982,  -2015,  -2048,  -2081,  -2114,  -2147,  -2181,  -2214,  -2248,
+     -2281,  -2315,  -2349,  -2383,  -2417,  -2451,  -2485,  -2519,  -2554,  -2588,
+     -2623,  -2658,  -2693,  -2728,  -2763,  -2798,  -2833,  -2869,  -2904,  -2940,
+     -2976,  -3012,  -3048,  -3084,  -3121,  -3157,  -3194,  -3231,  -3267,  -3304,
+     -3342,  -3379,  -3416,  -3454,  -3492,  -3530,  -3568,  -3606,  -3644,  -3683,
+     -3722,  -3760,  -3799,  -3839,  -3878,  -3917,  -3957,  -3997,  -4037,  -4077,
+     -4118,  -4158,  -4199,  -4240,  -4281,  -4323,  -4364,  -4406,  -4448,  -4490,
+     -4533,  -4575,  -4618,  -4661,  -4704,  -4748,  -4792,  -4836,  -4880,  -4924,
+     -4969,  -5014,  -5059,  -5105,  -5150,  -5196,  -5242,  -5289,  -5336,  -5383,
+     -5430,  -5478,  -5526,  -5574,  -5623,  -5672,  -5721,  -5771,  -5821,  -5871,
+     -5922,  -5972,  -6024,  -6075,  -6128,  -6180,  -6233,  -6286,  -6340,  -6394,
+     -6448,  -6503,  -6558,  -6614,  -6670,  -6727,  -6784,  -6842,  -6900,  -6959,
+     -7018,  -7078,  -7138,  -7199,  -7260,  -7322,  -7385,  -7448,  -7512,  -7577,
+     -7642,  -7708,  -7774,  -7841,  -7909,  -7978,  -8048,  -8118,  -8189,  -8261,
+     -8334,  -8408,  -8483,  -8558,  -8635,  -8713,  -8791,  -8871,  -8952,  -9034,
+     -9118,  -9202,  -9288,  -9375,  -9464,  -9554,  -9645,  -9738,  -9833,  -9929,
+    -10027, -10127, -10229, -10333, -10439, -10547, -10658, -10770, -10886, -11004,
+    -11125, -11249, -11376, -11507, -11641, -11779, -11920, -12067, -12218, -12373,
+    -12535, -12702, -12875, -13055, -13243, -13439, -13644, -13859, -14080, -14080,
+    -14080, -14080, -14080, -14080, -14080, -14080, -14080, -14080, -14080, -14080,
+    -14080, -14080, -14080, -14080, -14080,
+};
@@ -0,0 +1,345 @@
+/**
+  ******************************************************************************
+  * @file           : pid_ctrl.c
+  * @brief          : PID controller with selectable CMSIS-DSP backends
+  *                   PID 控制器实现 (位置式浮点 / CMSIS-DSP 增量式 f32、q31、q15)
+  ******************************************************************************
+  * @attention
+  *
+  * 增量式后端的状态写回积分限幅后、输出限幅前的 y，每次重算系数 (增益、dt、限幅变化，
+  * 复位或切换后端) 都由 prev_error / integral 重新预置，因此 f32 后端与位置式逐点一致，
+  * 定点后端只多出量化误差；误差或输出超出定点可表示范围的采样按位置式计算。
+  * arm_pid_instance_q15 的布局随 ARM_MATH_DSP 变化 (A1/A2 打包)，
+  * 系数只经 Kp/Ki/Kd 字段和 arm_pid_init_q15 写入，不直接访问 A0~A2。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pid_ctrl.h"
+#include <math.h>
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+static const char *const pid_backend_names[PID_BACKENDS] = { "pos", "f32", "q31", "q15" };
+
+/* Private function prototypes -----------------------------------------------*/
+static float Clamp(float value, float min, float max);
+static float PID_ComputeDsp(PID_Controller_t *pid, float error, float dt);
+static void PID_DspConfigure(PID_Controller_t *pid, float dt, float out_fs);
+static int PID_DspSetOutput(PID_Controller_t *pid, float y);
+static q31_t PID_ToQ31(float value);
+static q15_t PID_ToQ15(float value);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  PID控制器计算
+ * @param  pid: PID控制器结构体指针
+ * @param  measured_value: 当前测量的温度值
+ * @param  dt: 与上一次计算的实测采样间隔 (s)，<= 0 时按 sample_time_ms
+ * @retval PID输出值 (0-1000ms)
+ */
+float PID_Compute(PID_Controller_t *pid, float measured_value, float dt)
+{
+    if (pid == NULL) return 0.0f;
+
+    // 应用后端切换请求: 新后端的状态在第一次计算时预置
+    if (pid->backend_request != (uint8_t)pid->backend && pid->backend_request < PID_BACKENDS) {
+        pid->backend = (PID_Backend_t)pid->backend_request;
+        pid->dsp_valid = 0;
+    }
+
+    // 计算误差
+    float error = pid->setpoint - measured_value;
+
+    // 死区控制 - 在目标温度附近小幅波动时不调整
+    if (fabsf(error) < pid->deadband) {
+        // 保持当前输出，不累积积分
+        return pid->output;
+    }
+
+    // 计算积分项 (无实测间隔时用标称采样时间)
+    if (!(dt > 0.0f)) {
+        dt = pid->sample_time_ms / 1000.0f;
+    }
+    if (pid->backend != PID_BACKEND_POS) {
+        return PID_ComputeDsp(pid, error, dt);
+    }
+    pid->integral += error * dt;
+
+    // 积分限幅，防止积分饱和
+    pid->integral = Clamp(pid->integral, pid->integral_limit_min, pid->integral_limit_max);
+
+    // 计算微分项
+    float derivative = (error - pid->prev_error) / dt;
+
+    // PID输出计算
+    pid->output = pid->Kp * error +
+                  pid->Ki * pid->integral +
+                  pid->Kd * derivative;
+
+    // 输出限幅 (0-1000ms)
+    pid->output = Clamp(pid->output, pid->output_limit_min, pid->output_limit_max);
+
+    // 保存当前误差供下次使用
+    pid->prev_error = error;
+
+    return pid->output;
+}
+
+/**
+ * @brief  设置PID目标温度
+ * @param  pid: PID控制器结构体指针
+ * @param  setpoint: 目标温度
+ * @retval None
+ */
+void PID_SetSetpoint(PID_Controller_t *pid, float setpoint)
+{
+    if (pid == NULL) return;
+    pid->setpoint = setpoint;
+}
+
+/**
+ * @brief  重置PID控制器
+ * @param  pid: PID控制器结构体指针
+ * @retval None
+ */
+void PID_Reset(PID_Controller_t *pid)
+{
+    if (pid == NULL) return;
+
+    pid->integral = 0.0f;
+    pid->prev_error = 0.0f;
+    pid->output = 0.0f;
+    pid->dsp_valid = 0;
+}
+
+/**
+ * @brief  请求切换后端
+ */
+int PID_SetBackend(PID_Controller_t *pid, PID_Backend_t backend)
+{
+    if (pid == NULL || backend >= PID_BACKENDS) return -1;
+
+    pid->backend_request = (uint8_t)backend;
+    return 0;
+}
+
+/**
+ * @brief  后端名称
+ */
+const char *PID_BackendName(PID_Backend_t backend)
+{
+    if (backend >= PID_BACKENDS) return "?";
+    return pid_backend_names[backend];
+}
+
+/**
+ * @brief  按名称查找后端
+ */
+PID_Backend_t PID_FindBackend(const char *name)
+{
+    for (uint32_t i = 0; i < PID_BACKENDS; i++) {
+        if (strcmp(name, pid_backend_names[i]) == 0) return (PID_Backend_t)i;
+    }
+    return PID_BACKENDS;
+}
+
+/**
+ * @brief  增量式后端的一次计算
+ * @param  pid: PID控制器结构体指针
+ * @param  error: 误差 (°C，死区外)
+ * @param  dt: 采样间隔 (s)
+ * @retval PID输出值
+ */
+static float PID_ComputeDsp(PID_Controller_t *pid, float error, float dt)
+{
+    float out_fs = 2.0f * fmaxf(fabsf(pid->output_limit_max), fabsf(pid->output_limit_min));
+    float p = pid->Kp * error;
+    float d = pid->Kd * (error - pid->prev_error) / dt;
+    float i_lo = fminf(pid->Ki * pid->integral_limit_min, pid->Ki * pid->integral_limit_max);
+    float i_hi = fmaxf(pid->Ki * pid->integral_limit_min, pid->Ki * pid->integral_limit_max);
+    float x = 0.0f;
+    float y = 0.0f;
+
+    if (!pid->dsp_valid || pid->Kp != pid->dsp_kp || pid->Ki != pid->dsp_ki ||
+        pid->Kd != pid->dsp_kd || out_fs != pid->dsp_out_fs ||
+        fabsf(dt - pid->dsp_dt) > PID_DSP_DT_TOL * pid->dsp_dt) {
+        PID_DspConfigure(pid, dt, out_fs);
+    }
+    if (pid->backend != PID_BACKEND_F32) {
+        x = error / pid->dsp_err_fs;
+        if (fabsf(x) > 0.5f) {
+            pid->dsp_valid = 0;
+        }
+    }
+
+    if (pid->dsp_valid) {
+        // 增量式输出 y[n] = y[n-1] + A0 x[n] + A1 x[n-1] + A2 x[n-2]
+        switch (pid->backend) {
+        case PID_BACKEND_F32:
+            y = arm_pid_f32(&pid->dsp.f32, error);
+            break;
+        case PID_BACKEND_Q31:
+            y = (float)arm_pid_q31(&pid->dsp.q31, PID_ToQ31(x)) * (out_fs / 2147483648.0f);
+            break;
+        default:
+            y = (float)arm_pid_q15(&pid->dsp.q15, PID_ToQ15(x)) * (out_fs / 32768.0f);
+            break;
+        }
+
+        // 积分限幅: 积分贡献 y - P - D 不超出 Ki × [积分下限, 积分上限]
+        y = Clamp(y, p + d + i_lo, p + d + i_hi);
+        if (pid->Ki != 0.0f) {
+            pid->integral = (y - p - d) / pid->Ki;
+        } else {
+            pid->integral += error * dt;
+        }
+        pid->integral = Clamp(pid->integral, pid->integral_limit_min, pid->integral_limit_max);
+
+        // 写回积分限幅后的 y (不做输出限幅)，后续增量与位置式一致
+        if (PID_DspSetOutput(pid, y) != 0) {
+            pid->dsp_valid = 0;
+        }
+    } else {
+        // 定点后端误差超出 ±err_fs/2: 本次按位置式计算，下一次重新预置状态
+        pid->integral += error * dt;
+        pid->integral = Clamp(pid->integral, pid->integral_limit_min, pid->integral_limit_max);
+        y = p + d + pid->Ki * pid->integral;
+    }
+
+    // 输出限幅 (0-1000ms)
+    pid->output = Clamp(y, pid->output_limit_min, pid->output_limit_max);
+    pid->prev_error = error;
+    return pid->output;
+}
+
+/**
+ * @brief  按当前增益、dt 和输出满量程重算增量式系数，并由 prev_error / integral 预置状态
+ * @param  pid: PID控制器结构体指针
+ * @param  dt: 采样间隔 (s)
+ * @param  out_fs: 输出满量程
+ * @retval None
+ * @note   预置 x[n-1] = x[n-2] = prev_error，y[n-1] = Kp prev_error + Ki integral，
+ *         下一次增量式输出与位置式 Kp e + Ki (integral + e dt) + Kd de/dt 相同。
+ *         定点后端预置值超出可表示范围时 dsp_valid 保持 0
+ */
+static void PID_DspConfigure(PID_Controller_t *pid, float dt, float out_fs)
+{
+    float kp = pid->Kp;
+    float ki = pid->Ki * dt;
+    float kd = pid->Kd / dt;
+    float sum = fabsf(kp + ki + kd) + fabsf(kp + 2.0f * kd) + fabsf(kd);
+    float x = pid->prev_error;
+    uint8_t fits = 1;
+    float k;
+
+    pid->dsp_kp = pid->Kp;
+    pid->dsp_ki = pid->Ki;
+    pid->dsp_kd = pid->Kd;
+    pid->dsp_dt = dt;
+    pid->dsp_out_fs = out_fs;
+    pid->dsp_err_fs = PID_Q_ERR_FS_MAX;
+    if (sum * PID_Q_ERR_FS_MAX > PID_Q_HEADROOM * out_fs) {
+        pid->dsp_err_fs = PID_Q_HEADROOM * out_fs / sum;
+    }
+    k = pid->dsp_err_fs / out_fs;
+
+    switch (pid->backend) {
+    case PID_BACKEND_F32:
+        pid->dsp.f32.Kp = kp;
+        pid->dsp.f32.Ki = ki;
+        pid->dsp.f32.Kd = kd;
+        arm_pid_init_f32(&pid->dsp.f32, 0);
+        pid->dsp.f32.state[0] = x;
+        pid->dsp.f32.state[1] = x;
+        break;
+    case PID_BACKEND_Q31:
+        x /= pid->dsp_err_fs;
+        fits = (fabsf(x) <= 0.5f);
+        pid->dsp.q31.Kp = PID_ToQ31(kp * k);
+        pid->dsp.q31.Ki = PID_ToQ31(ki * k);
+        pid->dsp.q31.Kd = PID_ToQ31(kd * k);
+        arm_pid_init_q31(&pid->dsp.q31, 0);
+        pid->dsp.q31.state[0] = PID_ToQ31(x);
+        pid->dsp.q31.state[1] = PID_ToQ31(x);
+        break;
+    default:
+        x /= pid->dsp_err_fs;
+        fits = (fabsf(x) <= 0.5f);
+        pid->dsp.q15.Kp = PID_ToQ15(kp * k);
+        pid->dsp.q15.Ki = PID_ToQ15(ki * k);
+        pid->dsp.q15.Kd = PID_ToQ15(kd * k);
+        arm_pid_init_q15(&pid->dsp.q15, 0);
+        pid->dsp.q15.state[0] = PID_ToQ15(x);
+        pid->dsp.q15.state[1] = PID_ToQ15(x);
+        break;
+    }
+
+    pid->dsp_valid = (fits &&
+                      PID_DspSetOutput(pid, pid->Kp * pid->prev_error + pid->Ki * pid->integral) == 0);
+}
+
+/**
+ * @brief  写入增量式状态 y[n-1]
+ * @param  pid: PID控制器结构体指针
+ * @param  y: 输出 (未做输出限幅)
+ * @retval 0: 成功，-1: 定点后端超出可表示范围 ±out_fs/2
+ */
+static int PID_DspSetOutput(PID_Controller_t *pid, float y)
+{
+    float v = y / pid->dsp_out_fs;
+
+    switch (pid->backend) {
+    case PID_BACKEND_F32:
+        pid->dsp.f32.state[2] = y;
+        return 0;
+    case PID_BACKEND_Q31:
+        if (fabsf(v) > 0.5f) return -1;
+        pid->dsp.q31.state[2] = PID_ToQ31(v);
+        return 0;
+    default:
+        if (fabsf(v) > 0.5f) return -1;
+        pid->dsp.q15.state[2] = PID_ToQ15(v);
+        return 0;
+    }
+}
+
+/**
+ * @brief  浮点转 Q31 (舍入到最近，饱和)
+ * @param  value: [-1, 1)
+ * @retval Q31 值
+ */
+static q31_t PID_ToQ31(float value)
+{
+    if (value >= 1.0f) return INT32_MAX;
+    if (value <= -1.0f) return INT32_MIN;
+    return (q31_t)lrintf(value * 2147483648.0f);
+}
+
+/**
+ * @brief  浮点转 Q15 (舍入到最近，饱和)
+ * @param  value: [-1, 1)
+ * @retval Q15 值
+ */
+static q15_t PID_ToQ15(float value)
+{
+    if (value >= 1.0f) return INT16_MAX;
+    if (value <= -1.0f) return INT16_MIN;
+    return (q15_t)__SSAT((q31_t)lrintf(value * 32768.0f), 16);
+}
+
+/**
+ * @brief  限幅函数
+ * @param  value: 输入值
+ * @param  min: 最小值
+ * @param  max: 最大值
+ * @retval 限幅后的值
+ */
+static float Clamp(float value, float min, float max)
+{
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file           : sensor_check.c
+  * @brief          : Sensor validity checks
+  *                   传感器有效性检查实现
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sensor_check.h"
+#include <string.h>
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化检查状态
+ */
+void SensorCheck_Init(SensorCheck_t *check, const SensorCheck_Limits_t *limits)
+{
+    memset(check, 0, sizeof(*check));
+    check->limits = limits;
+}
+
+/**
+ * @brief  清除历史和故障
+ */
+void SensorCheck_Reset(SensorCheck_t *check)
+{
+    check->have_last = 0;
+    check->fault = 0;
+    check->same = 0;
+    check->good = 0;
+}
+
+/**
+ * @brief  检查一个采样
+ */
+uint8_t SensorCheck_Update(SensorCheck_t *check, float value, uint8_t io_ok)
+{
+    const SensorCheck_Limits_t *lim = check->limits;
+    uint8_t now = 0;
+
+    if (!io_ok) {
+        now = SENSOR_FAULT_IO;
+    } else if (!(value >= lim->min && value <= lim->max)) {
+        // 写成取反形式，NaN 也判为超量程
+        now = SENSOR_FAULT_RANGE;
+        check->have_last = 0;
+    } else {
+        if (check->have_last) {
+            float delta = value - check->last;
+
+            if (delta > lim->rate_max || delta < -lim->rate_max) {
+                now |= SENSOR_FAULT_RATE;
+            }
+            check->same = (value == check->last) ? (uint16_t)(check->same + 1U) : 0U;
+            if (lim->stuck_n != 0 && check->same >= lim->stuck_n) {
+                now |= SENSOR_FAULT_STUCK;
+                check->same = lim->stuck_n;     // 饱和，防止回绕
+            }
+        }
+        check->last = value;
+        check->have_last = 1;
+    }
+
+    if (now != 0) {
+        check->fault |= now;
+        check->good = 0;
+        check->count++;
+    } else if (check->fault != 0 && ++check->good >= lim->recover_n) {
+        check->fault = 0;
+        check->good = 0;
+    }
+    return check->fault;
+}
@@ -0,0 +1,240 @@
+/**
+  ******************************************************************************
+  * @file           : sensor_filter.c
+  * @brief          : Sensor filtering stage
+  *                   传感器滤波级实现
+  ******************************************************************************
+  * @attention
+  *
+  * 系数由双线性变换 (预畸变) 离线计算:
+  *   K = tan(pi * fc / fs), n = 1 / (1 + K/Q + K^2)
+  *   b0 = b2 = K^2 * n, b1 = 2 * b0, a1 = -2 * (K^2 - 1) * n, a2 = -(1 - K/Q + K^2) * n
+  * fs = 1e6 / SENSOR_FILTER_TS_US = 3.90625Hz；2 阶 Q = 0.7071；4 阶由 Q = 0.5412 / 1.3066 两级组成。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sensor_filter.h"
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define SENSOR_FILTER_REQ_VALID     0x00010000U     // 序号最低位，保证请求非 0
+
+// 处理耗时的计时源: 固件为 DWT->CYCCNT，上位机由 SENSOR_FILTER_CLOCK 指定计时函数
+#ifdef SENSOR_FILTER_CLOCK
+uint32_t SENSOR_FILTER_CLOCK(void);
+#define SENSOR_FILTER_NOW()         SENSOR_FILTER_CLOCK()
+#else
+#include "main.h"
+#define SENSOR_FILTER_NOW()         (DWT->CYCCNT)
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static const float sensor_filter_lp200[] = {
+    2.096338286e-02f, 4.192676572e-02f, 2.096338286e-02f, 1.550704594e+00f, -6.345581253e-01f,
+};
+
+static const float sensor_filter_lp100[] = {
+    5.797639337e-03f, 1.159527867e-02f, 5.797639337e-03f, 1.773354345e+00f, -7.965449027e-01f,
+};
+
+static const float sensor_filter_lp50[] = {
+    1.529289293e-03f, 3.058578586e-03f, 1.529289293e-03f, 1.886374883e+00f, -8.924920401e-01f,
+};
+
+static const float sensor_filter_lp50x4[] = {
+    1.504496723e-03f, 3.008993445e-03f, 1.504496723e-03f, 1.855793303e+00f, -8.618112900e-01f,
+    1.567959141e-03f, 3.135918283e-03f, 1.567959141e-03f, 1.934074053e+00f, -9.403458897e-01f,
+};
+
+static const SensorFilter_Design_t sensor_filter_designs[SENSOR_FILTER_PRESETS] = {
+    [SENSOR_FILTER_OFF]    = { "off",    0, NULL },
+    [SENSOR_FILTER_LP200]  = { "lp200",  1, sensor_filter_lp200 },
+    [SENSOR_FILTER_LP100]  = { "lp100",  1, sensor_filter_lp100 },
+    [SENSOR_FILTER_LP50]   = { "lp50",   1, sensor_filter_lp50 },
+    [SENSOR_FILTER_LP50X4] = { "lp50x4", 2, sensor_filter_lp50x4 },
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void SensorFilter_Apply(SensorFilter_t *filter, uint32_t request);
+static void SensorFilter_Prime(SensorFilter_t *filter, float value);
+static float SensorFilter_Median(SensorFilter_t *filter, float input);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化滤波器
+ */
+void SensorFilter_Init(SensorFilter_t *filter, SensorFilter_Preset_t preset, uint8_t median)
+{
+    memset(filter, 0, sizeof(*filter));
+    if (SensorFilter_Configure(filter, preset, median) != 0) {
+        SensorFilter_Configure(filter, SENSOR_FILTER_OFF, 1);
+    }
+    filter->applied = filter->request;
+    SensorFilter_Apply(filter, filter->request);
+}
+
+/**
+ * @brief  请求修改配置
+ */
+int SensorFilter_Configure(SensorFilter_t *filter, SensorFilter_Preset_t preset, uint8_t median)
+{
+    uint32_t seq;
+
+    if (preset >= SENSOR_FILTER_PRESETS) return -1;
+    if (median == 0 || median > SENSOR_FILTER_MEDIAN_MAX || (median & 1U) == 0) return -1;
+
+    seq = (filter->request & 0xFFFF0000U) + SENSOR_FILTER_REQ_VALID;
+    filter->request = seq | ((uint32_t)median << 8) | (uint32_t)preset;
+    return 0;
+}
+
+/**
+ * @brief  丢弃滤波历史
+ */
+void SensorFilter_Reset(SensorFilter_t *filter)
+{
+    filter->primed = 0;
+}
+
+/**
+ * @brief  处理一个采样
+ */
+float SensorFilter_Process(SensorFilter_t *filter, float input, uint32_t periods)
+{
+    uint32_t start = SENSOR_FILTER_NOW();
+    uint32_t request = filter->request;
+    float output = input;
+
+    if (request != filter->applied) {
+        filter->applied = request;
+        SensorFilter_Apply(filter, request);
+    }
+    if (!filter->primed) {
+        SensorFilter_Prime(filter, input);
+    }
+
+    if (filter->median_len > 1) {
+        input = SensorFilter_Median(filter, input);
+    }
+    if (filter->iir.numStages > 0 && periods <= 1) {
+        arm_biquad_cascade_df2T_f32(&filter->iir, &input, &output, 1);
+    } else if (filter->iir.numStages > 0) {
+        // 错过的采样周期以当前输入补足，IIR 始终按设计采样率推进
+        float hold[SENSOR_FILTER_STEPS_MAX];
+        float out[SENSOR_FILTER_STEPS_MAX];
+
+        if (periods > SENSOR_FILTER_STEPS_MAX) {
+            periods = SENSOR_FILTER_STEPS_MAX;
+        }
+        for (uint32_t i = 0; i < periods; i++) {
+            hold[i] = input;
+        }
+        arm_biquad_cascade_df2T_f32(&filter->iir, hold, out, periods);
+        output = out[periods - 1];
+    } else {
+        output = input;
+    }
+
+    filter->output = output;
+    filter->cycles_last = SENSOR_FILTER_NOW() - start;
+    if (filter->cycles_last > filter->cycles_max) {
+        filter->cycles_max = filter->cycles_last;
+    }
+    return output;
+}
+
+/**
+ * @brief  获取预设的设计
+ */
+const SensorFilter_Design_t *SensorFilter_GetDesign(SensorFilter_Preset_t preset)
+{
+    return (preset < SENSOR_FILTER_PRESETS) ? &sensor_filter_designs[preset] : NULL;
+}
+
+/**
+ * @brief  按名称查找预设
+ */
+SensorFilter_Preset_t SensorFilter_FindPreset(const char *name)
+{
+    for (int i = 0; i < SENSOR_FILTER_PRESETS; i++) {
+        if (strcmp(sensor_filter_designs[i].name, name) == 0) {
+            return (SensorFilter_Preset_t)i;
+        }
+    }
+    return SENSOR_FILTER_PRESETS;
+}
+
+/**
+ * @brief  应用配置请求，下一个采样重新预置
+ * @param  filter: 滤波器
+ * @param  request: 配置请求
+ * @retval None
+ */
+static void SensorFilter_Apply(SensorFilter_t *filter, uint32_t request)
+{
+    const SensorFilter_Design_t *design;
+
+    filter->preset = (SensorFilter_Preset_t)(request & 0xFFU);
+    filter->median_len = (uint8_t)((request >> 8) & 0xFFU);
+    design = &sensor_filter_designs[filter->preset];
+
+    arm_biquad_cascade_df2T_init_f32(&filter->iir, design->stages, design->coeffs, filter->state);
+    filter->median_pos = 0;
+    filter->primed = 0;
+    filter->cycles_max = 0;
+}
+
+/**
+ * @brief  把中值窗口和 IIR 状态预置为输入恒为 value 时的稳态
+ * @param  filter: 滤波器
+ * @param  value: 稳态值
+ * @retval None
+ * @note   df2T: y = b0*x + s1, s1' = b1*x + a1*y + s2, s2' = b2*x + a2*y；
+ *         各级直流增益为 1，稳态时 x = y = value
+ */
+static void SensorFilter_Prime(SensorFilter_t *filter, float value)
+{
+    const float *c = filter->iir.pCoeffs;
+
+    for (uint8_t i = 0; i < filter->median_len; i++) {
+        filter->median_buf[i] = value;
+    }
+    for (uint8_t stage = 0; stage < filter->iir.numStages; stage++, c += 5) {
+        float s2 = (c[2] + c[4]) * value;
+
+        filter->state[2 * stage] = (c[1] + c[3]) * value + s2;
+        filter->state[2 * stage + 1] = s2;
+    }
+    filter->primed = 1;
+}
+
+/**
+ * @brief  中值预滤波: 写入窗口后取中值
+ * @param  filter: 滤波器
+ * @param  input: 输入
+ * @retval 窗口中值
+ */
+static float SensorFilter_Median(SensorFilter_t *filter, float input)
+{
+    float sorted[SENSOR_FILTER_MEDIAN_MAX];
+    uint8_t n = filter->median_len;
+
+    filter->median_buf[filter->median_pos] = input;
+    filter->median_pos = (uint8_t)((filter->median_pos + 1U) % n);
+
+    // 插入排序，窗口最多 5 个
+    for (uint8_t i = 0; i < n; i++) {
+        float v = filter->median_buf[i];
+        uint8_t j = i;
+
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    return sorted[n / 2];
+}
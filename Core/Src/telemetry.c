@@ -0,0 +1,244 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.c
+  * @brief          : Sensor telemetry output
+  *                   传感器数据上报实现
+  ******************************************************************************
+  * @attention
+  *
+  * 缓冲池用两个只传指针的静态队列实现: 空闲队列和待发队列，
+  * 两个队列长度都等于槽数，因此 Telemetry_Post 和归还槽时永远不会失败。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "telemetry.h"
+#include "usart.h"
+#include "cmsis_os.h"
+#include "dwt_time.h"
+
+/* Private variables ---------------------------------------------------------*/
+static volatile Telemetry_Mode_t telemetry_mode = TELEMETRY_MODE_JSON;
+static volatile Telemetry_Route_t telemetry_route = TELEMETRY_ROUTE_DEFAULT;
+static uint16_t telemetry_seq = 0;
+static uint16_t telemetry_thermal_seq = 0;
+static volatile uint32_t telemetry_period_ms = TELEMETRY_PERIOD_DEFAULT_MS;
+static uint32_t telemetry_last_tick = 0;
+static uint8_t telemetry_started = 0;    // 首个采样立即上报
+
+static Telemetry_Slot_t telemetry_pool[TELEMETRY_POOL_SIZE];
+static uint8_t telemetry_free_storage[TELEMETRY_POOL_SIZE * sizeof(Telemetry_Slot_t *)];
+static uint8_t telemetry_ready_storage[TELEMETRY_POOL_SIZE * sizeof(Telemetry_Slot_t *)];
+static StaticQueue_t telemetry_free_struct;
+static StaticQueue_t telemetry_ready_struct;
+static QueueHandle_t telemetry_free_queue;      // 空闲槽
+static QueueHandle_t telemetry_ready_queue;     // 待发送的槽
+static volatile Telemetry_Stats_t telemetry_stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Telemetry_Output(const Telemetry_Slot_t *slot);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  创建缓冲池和待发队列 (静态分配)
+ * @retval None
+ * @note   在 MX_FREERTOS_Init 中、任务创建前调用
+ */
+void Telemetry_Init(void)
+{
+    telemetry_free_queue = xQueueCreateStatic(TELEMETRY_POOL_SIZE, sizeof(Telemetry_Slot_t *),
+                                              telemetry_free_storage, &telemetry_free_struct);
+    telemetry_ready_queue = xQueueCreateStatic(TELEMETRY_POOL_SIZE, sizeof(Telemetry_Slot_t *),
+                                               telemetry_ready_storage, &telemetry_ready_struct);
+
+    for (uint32_t i = 0; i < TELEMETRY_POOL_SIZE; i++) {
+        Telemetry_Slot_t *slot = &telemetry_pool[i];
+        xQueueSend(telemetry_free_queue, &slot, 0);
+    }
+}
+
+/**
+ * @brief  从缓冲池取一个空闲槽 (不阻塞)
+ * @retval 空闲槽，池空时返回 NULL 并计入丢弃
+ */
+Telemetry_Slot_t *Telemetry_Alloc(void)
+{
+    Telemetry_Slot_t *slot;
+
+    if (xQueueReceive(telemetry_free_queue, &slot, 0) != pdTRUE) {
+        telemetry_stats.dropped++;
+        return NULL;
+    }
+    return slot;
+}
+
+/**
+ * @brief  提交已填写的槽，交给上报任务发送
+ * @param  slot: Telemetry_Alloc 取得的槽
+ * @retval None
+ */
+void Telemetry_Post(Telemetry_Slot_t *slot)
+{
+    uint32_t depth;
+
+    if (slot == NULL) return;
+
+    slot->tick = HAL_GetTick();
+    xQueueSend(telemetry_ready_queue, &slot, 0);   // 队列长度等于槽数，不会满
+
+    telemetry_stats.posted++;
+    depth = (uint32_t)uxQueueMessagesWaiting(telemetry_ready_queue);
+    if (depth > telemetry_stats.queue_high) {
+        telemetry_stats.queue_high = depth;
+    }
+}
+
+/**
+ * @brief  等待并发送一个采样，发送后归还缓冲槽 (上报任务中循环调用)
+ * @param  wait_ticks: 最长等待时间 (系统节拍)
+ * @retval None
+ */
+void Telemetry_Process(uint32_t wait_ticks)
+{
+    Telemetry_Slot_t *slot;
+
+    if (xQueueReceive(telemetry_ready_queue, &slot, wait_ticks) != pdTRUE) {
+        return;
+    }
+
+    Telemetry_Output(slot);
+    xQueueSend(telemetry_free_queue, &slot, 0);
+}
+
+/**
+ * @brief  获取上报统计
+ * @param  stats: 输出统计信息
+ * @retval None
+ */
+void Telemetry_GetStats(Telemetry_Stats_t *stats)
+{
+    if (stats == NULL) return;
+    *stats = telemetry_stats;
+    stats->queued = (uint32_t)uxQueueMessagesWaiting(telemetry_ready_queue);
+}
+
+/**
+ * @brief  设置上报模式
+ * @param  mode: TELEMETRY_MODE_JSON / TELEMETRY_MODE_BINARY
+ * @retval None
+ */
+void Telemetry_SetMode(Telemetry_Mode_t mode)
+{
+    telemetry_mode = mode;
+}
+
+/**
+ * @brief  获取当前上报模式
+ * @retval 当前模式
+ */
+Telemetry_Mode_t Telemetry_GetMode(void)
+{
+    return telemetry_mode;
+}
+
+/**
+ * @brief  设置上报通道
+ * @param  route: TELEMETRY_ROUTE_CONSOLE / TELEMETRY_ROUTE_DATA
+ * @retval None
+ */
+void Telemetry_SetRoute(Telemetry_Route_t route)
+{
+    telemetry_route = route;
+}
+
+/**
+ * @brief  获取当前上报通道
+ * @retval 当前通道
+ */
+Telemetry_Route_t Telemetry_GetRoute(void)
+{
+    return telemetry_route;
+}
+
+/**
+ * @brief  设置上报周期
+ * @param  period_ms: 上报周期 (ms)，0 表示停止上报
+ * @retval None
+ * @note   实际上报间隔不会短于采集任务的采样周期
+ */
+void Telemetry_SetPeriod(uint32_t period_ms)
+{
+    telemetry_period_ms = period_ms;
+}
+
+/**
+ * @brief  获取上报周期
+ * @retval 上报周期 (ms)，0 表示已停止
+ */
+uint32_t Telemetry_GetPeriod(void)
+{
+    return telemetry_period_ms;
+}
+
+/**
+ * @brief  上报一组传感器采样 (上报任务中调用)
+ * @param  slot: 采样槽
+ * @retval None
+ * @note   距上次上报不足上报周期时直接返回；帧内时间戳为采样时刻；
+ *         二进制模式下整帧一次写入发送缓冲区，不会与其他文本消息交错；
+ *         数据通道 (USART1) 上始终发送二进制帧；
+ *         通道 2~4 有启用时另发一帧多通道温控状态 (通道1 已在采样记录中)
+ */
+static void Telemetry_Output(const Telemetry_Slot_t *slot)
+{
+    const TlmSample_t *sample = &slot->sample;
+    const TlmThermal_t *thermal = &slot->thermal;
+    uint8_t zones = thermal->mask & (uint8_t)~1U;
+    uint32_t period = telemetry_period_ms;
+    uint32_t now = slot->tick;
+
+    if (period == 0 || (telemetry_started && (now - telemetry_last_tick) < period)) {
+        telemetry_stats.skipped++;
+        return;
+    }
+    telemetry_started = 1;
+    telemetry_last_tick = now;
+
+    if (telemetry_route == TELEMETRY_ROUTE_DATA || telemetry_mode == TELEMETRY_MODE_BINARY) {
+        uint8_t frame[TLM_FRAME_WIRE_MAX];
+        UartTx_t *tx = (telemetry_route == TELEMETRY_ROUTE_DATA) ? &uart1_tx : &uart2_tx;
+        size_t len = TlmFrame_Build(TLM_FRAME_TYPE_SAMPLE, telemetry_seq++, now,
+                                    sample, sizeof(TlmSample_t), frame);
+        if (len > 0) {
+            UartTx_Write(tx, frame, (uint32_t)len);
+        }
+        if (zones != 0) {
+            len = TlmFrame_Build(TLM_FRAME_TYPE_THERMAL, telemetry_thermal_seq++, now,
+                                 thermal, sizeof(TlmThermal_t), frame);
+            if (len > 0) {
+                UartTx_Write(tx, frame, (uint32_t)len);
+            }
+        }
+    } else {
+        // JSON格式，分三条发送便于串口监控；时间为 µs，t_us 只取低 32 位 (约 71 分钟回绕)
+        send_message("{\"type\":\"data\",\"sensor\":\"WF5803\",\"temp\":%.2f,\"press\":%.2f,\"lat_us\":%lu}\n",
+                     sample->wf_temp, sample->wf_press, (unsigned long)DwtTime_ToUs(sample->wf_cycles));
+        send_message("{\"type\":\"data\",\"sensor\":\"NTC\",\"temp\":%.2f,\"t_us\":%lu,\"age_us\":%lu}\n",
+                     sample->ntc_temp, (unsigned long)(uint32_t)DwtTime_ToUs(sample->t_cycles),
+                     (unsigned long)DwtTime_ToUs(sample->age_cycles));
+        send_message("{\"type\":\"data\",\"sensor\":\"PID\",\"output\":%.2f,\"lat_us\":%lu}\n",
+                     sample->pid_output, (unsigned long)DwtTime_ToUs(sample->ctl_cycles));
+        if (sample->fault != 0) {
+            send_message("{\"type\":\"fault\",\"mask\":%lu}\n", (unsigned long)sample->fault);
+        }
+        for (uint8_t i = 1; i < TLM_THERMAL_CHANNELS; i++) {
+            if (zones & (1U << i)) {
+                send_message("{\"type\":\"data\",\"sensor\":\"ZONE\",\"ch\":%u,\"temp\":%.2f,\"sp\":%.2f,\"output\":%.2f}\n",
+                             (unsigned int)(i + 1), thermal->ch[i].temp, thermal->ch[i].setpoint, thermal->ch[i].output);
+            }
+        }
+    }
+    telemetry_stats.sent++;
+}
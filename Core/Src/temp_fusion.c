@@ -0,0 +1,240 @@
+/**
+  ******************************************************************************
+  * @file           : temp_fusion.c
+  * @brief          : NTC / WF5803F temperature fusion
+  *                   NTC 与 WF5803F 温度的卡尔曼融合实现
+  ******************************************************************************
+  * @attention
+  *
+  * 观测行数 m 随有效传感器变化 (1 或 2)，矩阵实例每次按 m 初始化，
+  * 缓冲区按最大尺寸放在栈上。arm_mat_inverse_f32 会破坏源矩阵，求逆前先复制 S。
+  * P 更新用 (I - K H) P，结果再强制对称，避免舍入误差累积使 P 失去正定性。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "temp_fusion.h"
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define TEMP_FUSION_STAT_K      (1.0f / (float)TEMP_FUSION_STAT_N)
+
+/* Private function prototypes -----------------------------------------------*/
+static void TempFusion_Prime(TempFusion_t *kf, float temp, float r);
+static void TempFusion_Stat(TempFusion_Innov_t *stat, float y);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化
+ */
+void TempFusion_Init(TempFusion_t *kf)
+{
+    memset(kf, 0, sizeof(*kf));
+    arm_mat_init_f32(&kf->mx, 2, 1, kf->x);
+    arm_mat_init_f32(&kf->mP, 2, 2, kf->P);
+    kf->q = TEMP_FUSION_Q;
+    kf->r[TEMP_FUSION_NTC] = TEMP_FUSION_R_NTC;
+    kf->r[TEMP_FUSION_WF] = TEMP_FUSION_R_WF;
+    kf->wf_offset = TEMP_FUSION_WF_OFFSET;
+    kf->nis = 1.0f;
+}
+
+/**
+ * @brief  丢弃状态
+ */
+void TempFusion_Reset(TempFusion_t *kf)
+{
+    kf->primed = 0;
+}
+
+/**
+ * @brief  修改噪声参数
+ */
+int TempFusion_SetNoise(TempFusion_t *kf, float q, float r_ntc, float r_wf)
+{
+    // 写成取反形式，NaN 也拒绝
+    if (!(q > 0.0f) || !(r_ntc > 0.0f) || !(r_wf > 0.0f)) return -1;
+
+    kf->q = q;
+    kf->r[TEMP_FUSION_NTC] = r_ntc;
+    kf->r[TEMP_FUSION_WF] = r_wf;
+    return 0;
+}
+
+/**
+ * @brief  一个周期: 预测并用有效观测更新
+ */
+float TempFusion_Update(TempFusion_t *kf, float dt, float t_ntc, uint8_t ntc_ok, float t_wf, uint8_t wf_ok)
+{
+    uint32_t start = DWT->CYCCNT;
+    float F[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    float Ft[4], Q[4], FP[4], FPFt[4], x[2];
+    float H[4], Ht[4], z[2], R[4], Hx[2], y[2];
+    float PHt[4], S[4], Sc[4], Si[4], K[4], Ky[2], Siy[2];
+    float KH[4], IKH[4], P[4];
+    const float I[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    TempFusion_Source_t src[TEMP_FUSION_SOURCES];
+    arm_matrix_instance_f32 mF, mFt, mQ, mFP, mFPFt, mx;
+    arm_matrix_instance_f32 mH, mHt, mz, mR, mHx, my;
+    arm_matrix_instance_f32 mPHt, mS, mSc, mSi, mK, mKy, mSiy;
+    arm_matrix_instance_f32 mKH, mI, mIKH, mPn;
+    uint16_t m = 0;
+    float nis = 0.0f;
+
+    if (!(dt > 0.0f)) {
+        dt = TEMP_FUSION_DT_S;
+    }
+    F[1] = dt;
+
+    if (!kf->primed) {
+        if (ntc_ok) {
+            TempFusion_Prime(kf, t_ntc, kf->r[TEMP_FUSION_NTC]);
+        } else if (wf_ok) {
+            TempFusion_Prime(kf, t_wf - kf->wf_offset, kf->r[TEMP_FUSION_WF]);
+        } else {
+            return t_ntc;
+        }
+        return kf->x[0];
+    }
+
+    /* 预测: x = F x, P = F P F' + Q */
+    Q[0] = kf->q * dt * dt * dt / 3.0f;
+    Q[1] = kf->q * dt * dt / 2.0f;
+    Q[2] = Q[1];
+    Q[3] = kf->q * dt;
+
+    arm_mat_init_f32(&mF, 2, 2, F);
+    arm_mat_init_f32(&mFt, 2, 2, Ft);
+    arm_mat_init_f32(&mQ, 2, 2, Q);
+    arm_mat_init_f32(&mFP, 2, 2, FP);
+    arm_mat_init_f32(&mFPFt, 2, 2, FPFt);
+    arm_mat_init_f32(&mx, 2, 1, x);
+
+    arm_mat_mult_f32(&mF, &kf->mx, &mx);
+    arm_mat_trans_f32(&mF, &mFt);
+    arm_mat_mult_f32(&mF, &kf->mP, &mFP);
+    arm_mat_mult_f32(&mFP, &mFt, &mFPFt);
+    arm_mat_add_f32(&mFPFt, &mQ, &kf->mP);
+    kf->x[0] = x[0];
+    kf->x[1] = x[1];
+
+    /* 观测: 每个有效传感器一行 */
+    if (ntc_ok) {
+        src[m] = TEMP_FUSION_NTC;
+        z[m++] = t_ntc;
+    }
+    if (wf_ok) {
+        src[m] = TEMP_FUSION_WF;
+        z[m++] = t_wf - kf->wf_offset;
+    }
+
+    if (m > 0) {
+        for (uint16_t i = 0; i < m; i++) {
+            H[2 * i] = 1.0f;
+            H[2 * i + 1] = 0.0f;
+            for (uint16_t j = 0; j < m; j++) {
+                R[i * m + j] = (i == j) ? kf->r[src[i]] : 0.0f;
+            }
+        }
+
+        arm_mat_init_f32(&mH, m, 2, H);
+        arm_mat_init_f32(&mHt, 2, m, Ht);
+        arm_mat_init_f32(&mz, m, 1, z);
+        arm_mat_init_f32(&mR, m, m, R);
+        arm_mat_init_f32(&mHx, m, 1, Hx);
+        arm_mat_init_f32(&my, m, 1, y);
+        arm_mat_init_f32(&mPHt, 2, m, PHt);
+        arm_mat_init_f32(&mS, m, m, S);
+        arm_mat_init_f32(&mSc, m, m, Sc);
+        arm_mat_init_f32(&mSi, m, m, Si);
+        arm_mat_init_f32(&mK, 2, m, K);
+        arm_mat_init_f32(&mKy, 2, 1, Ky);
+        arm_mat_init_f32(&mSiy, m, 1, Siy);
+        arm_mat_init_f32(&mKH, 2, 2, KH);
+        arm_mat_init_f32(&mI, 2, 2, (float32_t *)I);
+        arm_mat_init_f32(&mIKH, 2, 2, IKH);
+        arm_mat_init_f32(&mPn, 2, 2, P);
+
+        /* y = z - H x, S = H P H' + R */
+        arm_mat_trans_f32(&mH, &mHt);
+        arm_mat_mult_f32(&mH, &kf->mx, &mHx);
+        arm_mat_sub_f32(&mz, &mHx, &my);
+        arm_mat_mult_f32(&kf->mP, &mHt, &mPHt);
+        arm_mat_mult_f32(&mH, &mPHt, &mS);
+        arm_mat_add_f32(&mS, &mR, &mS);
+
+        memcpy(Sc, S, sizeof(float) * m * m);
+        if (arm_mat_inverse_f32(&mSc, &mSi) != ARM_MATH_SUCCESS) {
+            // r > 0 时 S 正定，只有状态已发散 (NaN/Inf) 才会走到这里
+            kf->primed = 0;
+            return (ntc_ok) ? t_ntc : kf->x[0];
+        }
+
+        /* K = P H' S^-1, x = x + K y, P = (I - K H) P */
+        arm_mat_mult_f32(&mPHt, &mSi, &mK);
+        arm_mat_mult_f32(&mK, &my, &mKy);
+        arm_mat_add_f32(&kf->mx, &mKy, &kf->mx);
+        arm_mat_mult_f32(&mK, &mH, &mKH);
+        arm_mat_sub_f32(&mI, &mKH, &mIKH);
+        arm_mat_mult_f32(&mIKH, &kf->mP, &mPn);
+        kf->P[0] = P[0];
+        kf->P[1] = 0.5f * (P[1] + P[2]);
+        kf->P[2] = kf->P[1];
+        kf->P[3] = P[3];
+
+        /* 新息统计 */
+        arm_mat_mult_f32(&mSi, &my, &mSiy);
+        for (uint16_t i = 0; i < m; i++) {
+            TempFusion_Stat(&kf->innov[src[i]], y[i]);
+            nis += y[i] * Siy[i];
+        }
+        kf->nis += TEMP_FUSION_STAT_K * (nis / (float)m - kf->nis);
+    }
+
+    kf->cycles_last = DWT->CYCCNT - start;
+    if (kf->cycles_last > kf->cycles_max) {
+        kf->cycles_max = kf->cycles_last;
+    }
+    return kf->x[0];
+}
+
+/**
+ * @brief  用一个观测初始化状态: 温度取观测值，速度取 0
+ * @param  kf: 滤波器
+ * @param  temp: 温度观测 (°C)
+ * @param  r: 该观测的方差
+ * @retval None
+ */
+static void TempFusion_Prime(TempFusion_t *kf, float temp, float r)
+{
+    kf->x[0] = temp;
+    kf->x[1] = 0.0f;
+    kf->P[0] = r;
+    kf->P[1] = 0.0f;
+    kf->P[2] = 0.0f;
+    kf->P[3] = TEMP_FUSION_P0_RATE;
+    kf->primed = 1;
+}
+
+/**
+ * @brief  新息的指数平均均值和方差
+ * @param  stat: 统计
+ * @param  y: 新息
+ * @retval None
+ */
+static void TempFusion_Stat(TempFusion_Innov_t *stat, float y)
+{
+    stat->last = y;
+    if (stat->count == 0) {
+        stat->mean = y;
+        stat->var = 0.0f;
+    } else {
+        float d = y - stat->mean;
+
+        stat->mean += TEMP_FUSION_STAT_K * d;
+        stat->var = (1.0f - TEMP_FUSION_STAT_K) * (stat->var + TEMP_FUSION_STAT_K * d * d);
+    }
+    stat->count++;
+}
@@ -11,6 +11,8 @@
   * 硬件配置:
   * - PC6: TIM3_CH1 (加热控制1) - 硬件PWM输出
   * - PC7: TIM3_CH2 (加热控制2) - 硬件PWM输出
+  * - PC8: TIM3_CH3 (加热控制3) - 硬件PWM输出
+  * - PC9: TIM3_CH4 (加热控制4) - 硬件PWM输出
   * 
   * 控制策略:
   * - 使用TIM3硬件PWM控制NMOS占空比 (周期1000ms)
@@ -22,32 +24,54 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "temp_pid_ctrl.h"
+#include "NTC.h"
+#include "dwt_time.h"
 
 
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private define ------------------------------------------------------------*/
 
+// 滤波预设按 ADC 过采样抽取率设计
+_Static_assert((uint64_t)ADC_SCAN_OVS_N * 1000000U / ADC_SCAN_RATE_HZ == SENSOR_FILTER_TS_US,
+               "sensor filter presets must be designed for the ADC oversampling output rate");
+
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
+TempCtrl_Channel_t tempctrl_ch[TEMPCTRL_CHANNELS] = {
+    { .adc = ADC_SCAN_NTC1, .tim_channel = TIM_CHANNEL_1 },    // PA0 -> PC6
+    { .adc = ADC_SCAN_NTC2, .tim_channel = TIM_CHANNEL_2 },    // PA1 -> PC7
+    { .adc = ADC_SCAN_NTC3, .tim_channel = TIM_CHANNEL_3 },    // PA2 -> PC8
+    { .adc = ADC_SCAN_NTC4, .tim_channel = TIM_CHANNEL_4 },    // PA3 -> PC9
+};
+
+TempFusion_t tempctrl_fusion;
+volatile uint8_t tempctrl_fusion_enabled = TEMPCTRL_FUSION_ENABLE;
+
+static float tempctrl_ref_temp;         // 最近的 WF5803F 温度 (TempCtrl_SetReference)
+static uint8_t tempctrl_ref_valid;      // 1: 有效且尚未用于融合
+
+static const SensorCheck_Limits_t tempctrl_ntc_limits = {
+    TEMPCTRL_NTC_MIN, TEMPCTRL_NTC_MAX, TEMPCTRL_NTC_RATE_MAX,
+    TEMPCTRL_NTC_STUCK_N, TEMPCTRL_NTC_RECOVER
+};
 
 /* Private function prototypes -----------------------------------------------*/
-static float Clamp(float value, float min, float max);
 
 /* Function implementations --------------------------------------------------*/
 
 /**
  * @brief  设置加热MOS管硬件PWM占空比（0-10000）
+ * @param  ch: 通道下标 (0 ~ TEMPCTRL_CHANNELS-1)
  * @param  duty_ms: 0-1000ms（实际PWM周期为1000ms）
  */
-void Set_Heating_PWM(uint16_t duty_ms)
+void Set_Heating_PWM(uint8_t ch, uint16_t duty_ms)
 {
+    if (ch >= TEMPCTRL_CHANNELS) return;
     if (duty_ms > 1000) duty_ms = 1000;
-    if(duty_ms < 0) duty_ms = 0;
     uint32_t pulse = duty_ms * 10; // 1000ms对应10000计数
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse); // PC6
-    // __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_2, pulse); // PC7
+    __HAL_TIM_SET_COMPARE(&htim3, tempctrl_ch[ch].tim_channel, pulse);
 }
 
 /**
@@ -80,104 +104,31 @@ void PID_Init(PID_Controller_t *pid)
     pid->integral_limit_max = PID_INTEGRAL_MAX;
     pid->integral_limit_min = PID_INTEGRAL_MIN;
     
+    // 设置死区
+    pid->deadband = TEMP_DEADBAND;
+    
     // 设置采样时间
     pid->sample_time_ms = PID_SAMPLE_TIME_MS;
-}
 
-/**
- * @brief  PID控制器计算
- * @param  pid: PID控制器结构体指针
- * @param  measured_value: 当前测量的温度值
- * @retval PID输出值 (0-1000ms)
- */
-float PID_Compute(PID_Controller_t *pid, float measured_value)
-{
-    if (pid == NULL) return 0.0f;
-    
-    // 计算误差
-    float error = pid->setpoint - measured_value;
-    
-    // 死区控制 - 在目标温度附近小幅波动时不调整
-    if (fabsf(error) < TEMP_DEADBAND) {
-        // 保持当前输出，不累积积分
-        return pid->output;
-    }
-    
-    // 计算积分项 (转换采样时间到秒)
-    float dt = pid->sample_time_ms / 1000.0f;
-    pid->integral += error * dt;
-    
-    // 积分限幅，防止积分饱和
-    pid->integral = Clamp(pid->integral, pid->integral_limit_min, pid->integral_limit_max);
-    
-    // 计算微分项
-    float derivative = (error - pid->prev_error) / dt;
-    
-    // PID输出计算
-    pid->output = pid->Kp * error + 
-                  pid->Ki * pid->integral + 
-                  pid->Kd * derivative;
-    
-    // 输出限幅 (0-1000ms)
-    pid->output = Clamp(pid->output, pid->output_limit_min, pid->output_limit_max);
-    
-    // 保存当前误差供下次使用
-    pid->prev_error = error;
-    
-    return pid->output;
+    // 设置后端
+    pid->backend = TEMPCTRL_PID_BACKEND;
+    pid->backend_request = (uint8_t)TEMPCTRL_PID_BACKEND;
+    pid->dsp_valid = 0;
 }
 
 /**
- * @brief  设置PID目标温度
- * @param  pid: PID控制器结构体指针
- * @param  setpoint: 目标温度
+ * @brief  紧急关闭加热 (全部通道)
  * @retval None
  */
-void PID_SetSetpoint(PID_Controller_t *pid, float setpoint)
+void TempCtrl_EmergencyStop(void)
 {
-    if (pid == NULL) return;
-    pid->setpoint = setpoint;
-}
+    for (uint8_t i = 0; i < TEMPCTRL_CHANNELS; i++) {
+        // 关闭硬件PWM输出
+        Set_Heating_PWM(i, 0);
 
-/**
- * @brief  重置PID控制器
- * @param  pid: PID控制器结构体指针
- * @retval None
- */
-void PID_Reset(PID_Controller_t *pid)
-{
-    if (pid == NULL) return;
-    
-    pid->integral = 0.0f;
-    pid->prev_error = 0.0f;
-    pid->output = 0.0f;
-}
-
-/**
- * @brief  限幅函数
- * @param  value: 输入值
- * @param  min: 最小值
- * @param  max: 最大值
- * @retval 限幅后的值
- */
-static float Clamp(float value, float min, float max)
-{
-    if (value < min) return min;
-    if (value > max) return max;
-    return value;
-}
-
-/**
- * @brief  紧急关闭加热
- * @retval None
- */
-void TempCtrl_EmergencyStop(PID_Controller_t *pid)
-{
-    // 关闭硬件PWM输出
-    Set_Heating_PWM(0);
-    
-    // 重置PID控制器
-    PID_Reset(pid);
+        // 重置PID控制器
+        PID_Reset(&tempctrl_ch[i].pid);
+    }
     
     send_message("[TEMP_CTRL] Emergency stop activated!\n");
 }
@@ -186,15 +137,26 @@ void TempCtrl_EmergencyStop(PID_Controller_t *pid)
  * @brief  初始化温度控制系统
  * @retval None
  */
-void TempCtrl_Init(PID_Controller_t *pid)
+void TempCtrl_Init(void)
 {
-    // 初始化PID控制器
-    PID_Init(pid);
-    
-    // 初始化硬件PWM为关断状态
-    Set_Heating_PWM(0);
+    PID_Controller_t *pid = &tempctrl_ch[0].pid;
+
+    for (uint8_t i = 0; i < TEMPCTRL_CHANNELS; i++) {
+        TempCtrl_Channel_t *c = &tempctrl_ch[i];
+
+        // 初始化PID控制器和滤波器
+        PID_Init(&c->pid);
+        SensorFilter_Init(&c->filter, TEMPCTRL_FILTER_PRESET, TEMPCTRL_FILTER_MEDIAN);
+        SensorCheck_Init(&c->check, &tempctrl_ntc_limits);
+        c->enabled = (i == 0);
+        c->active = c->enabled;
+
+        // 初始化硬件PWM为关断状态
+        Set_Heating_PWM(i, 0);
+    }
+    TempFusion_Init(&tempctrl_fusion);
     
-    send_message("Temperature Control Initialized\n");
+    send_message("Temperature Control Initialized (%d channels, CH1 enabled)\n", TEMPCTRL_CHANNELS);
     send_message("Target Temperature: %.2f°C\n", pid->setpoint);
     send_message("PID Parameters: Kp=%.2f, Ki=%.2f, Kd=%.2f\n", 
            pid->Kp, pid->Ki, pid->Kd);
@@ -210,6 +172,121 @@ void TempCtrl_Init(PID_Controller_t *pid)
     // #endif
 }
 
+/**
+ * @brief  提供新的 WF5803F 温度 (在下一个 NTC 采样的融合中使用一次)
+ * @param  temp: WF5803F 温度 (°C)
+ * @param  valid: 1: 有效
+ * @retval None
+ */
+void TempCtrl_SetReference(float temp, uint8_t valid)
+{
+    tempctrl_ref_temp = temp;
+    tempctrl_ref_valid = valid;
+}
+
+/**
+ * @brief  一个控制周期: 全部通道读取 NTC、滤波、PID 计算并更新 PWM
+ * @retval None
+ */
+void TempCtrl_Update(void)
+{
+    uint64_t t_input = AdcScan_OversampledTime();
+
+    for (uint8_t i = 0; i < TEMPCTRL_CHANNELS; i++) {
+        TempCtrl_Channel_t *c = &tempctrl_ch[i];
+        uint8_t enabled = c->enabled;
+        uint8_t was_valid = SensorCheck_IsValid(&c->check);
+        uint64_t start;
+        uint64_t dt_us;
+        float dt;
+
+        // 控制周期短于 ADC 抽取周期时多数周期没有新的过采样结果: 不重复处理同一个采样，输出保持
+        if (t_input == c->t_input && enabled == c->active) {
+            continue;
+        }
+
+        // 启用状态变化: 从当前温度重新开始 (PID 清零，滤波器按下一个采样预置)
+        if (enabled != c->active) {
+            c->active = enabled;
+            PID_Reset(&c->pid);
+            SensorFilter_Reset(&c->filter);
+            SensorCheck_Reset(&c->check);
+            if (i == TEMPCTRL_FUSION_CH) {
+                TempFusion_Reset(&tempctrl_fusion);
+            }
+            c->t_pid = 0;
+            was_valid = 1;
+        }
+
+        c->t_sample = DwtTime_Now();
+        c->t_input = t_input;
+        c->temp_raw = compute_ntc_temperature_ovs(NTC_ReadOversampled(c->adc));
+        if (!enabled) {
+            Set_Heating_PWM(i, 0);
+            continue;
+        }
+
+        // 传感器故障: 关断输出，故障期间的采样不进入滤波器和 PID
+        if (SensorCheck_Update(&c->check, c->temp_raw, 1) != 0) {
+            if (was_valid) {
+                PID_Reset(&c->pid);
+                send_message("[TEMP_CTRL] CH%u sensor fault 0x%02X (%.2f°C), heater off\n",
+                             (unsigned int)(i + 1), (unsigned int)c->check.fault, c->temp_raw);
+            }
+            Set_Heating_PWM(i, 0);
+            c->t_pid = 0;
+            continue;
+        }
+        if (!was_valid) {
+            SensorFilter_Reset(&c->filter);
+            if (i == TEMPCTRL_FUSION_CH) {
+                TempFusion_Reset(&tempctrl_fusion);
+            }
+            send_message("[TEMP_CTRL] CH%u sensor recovered\n", (unsigned int)(i + 1));
+        }
+
+        // 实测采样间隔: 相邻两个参与计算的过采样结果的抽取时刻之差 (复位后第一次为 0)
+        dt_us = (c->t_pid != 0) ? DwtTime_ToUs(c->t_input - c->t_pid) : 0;
+        dt = (float)dt_us * 1.0e-6f;
+        c->t_pid = c->t_input;
+        c->dt = dt;
+
+        // 滤波器按抽取率设计: 控制周期跨过几个抽取周期，IIR 就推进几步
+        c->temp = SensorFilter_Process(&c->filter, c->temp_raw,
+                                       (uint32_t)((dt_us + SENSOR_FILTER_TS_US / 2U) / SENSOR_FILTER_TS_US));
+        if (i == TEMPCTRL_FUSION_CH) {
+            // 融合始终运行 (新息统计可与滤波输出对比)，是否作为 PID 输入由命令选择；
+            // WF5803F 温度只使用一次，WF5803F 采样比 NTC 慢时其余周期只用 NTC 更新
+            float fused = TempFusion_Update(&tempctrl_fusion, dt, c->temp_raw, 1,
+                                            tempctrl_ref_temp, tempctrl_ref_valid);
+
+            tempctrl_ref_valid = 0;
+            if (tempctrl_fusion_enabled) {
+                c->temp = fused;
+            }
+        }
+        start = DwtTime_Now();
+        PID_Compute(&c->pid, c->temp, dt);
+        c->pid_cycles_last = (uint32_t)(DwtTime_Now() - start);
+        if (c->pid_cycles_last > c->pid_cycles_max) {
+            c->pid_cycles_max = c->pid_cycles_last;
+        }
+        Set_Heating_PWM(i, (uint16_t)c->pid.output);
+        c->t_output = DwtTime_Now();
+    }
+}
+
+/**
+ * @brief  获取通道
+ * @param  ch: 通道号 (1 ~ TEMPCTRL_CHANNELS)
+ * @retval 通道，通道号无效时为 NULL
+ */
+TempCtrl_Channel_t *TempCtrl_GetChannel(uint32_t ch)
+{
+    if (ch < 1 || ch > TEMPCTRL_CHANNELS) return NULL;
+    return &tempctrl_ch[ch - 1];
+}
+
 // /**
 //  * @brief  获取PID控制器指针（用于外部调整PID参数）
 //  * @retval PID控制器结构体指针
@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file           : tlm_frame.c
+  * @brief          : Binary telemetry frame encoder/decoder
+  *                   二进制遥测帧编解码 (COBS + CRC16)
+  ******************************************************************************
+  * @attention
+  *
+  * 纯 C 实现，不依赖 HAL/RTOS，上位机解码库直接编译此文件。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "tlm_frame.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+
+/* CRC-16/CCITT 半字节查表 (16项，兼顾速度与 Flash 占用) */
+static const uint16_t crc16_nibble_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  计算 CRC-16/CCITT-FALSE
+ * @param  crc: 初值 (首次调用传 0xFFFF)
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval CRC 值
+ */
+uint16_t TlmFrame_Crc16(uint16_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 4) ^ crc16_nibble_table[((crc >> 12) ^ (data[i] >> 4)) & 0x0F]);
+        crc = (uint16_t)((crc << 4) ^ crc16_nibble_table[((crc >> 12) ^ (data[i] & 0x0F)) & 0x0F]);
+    }
+    return crc;
+}
+
+/**
+ * @brief  COBS 编码
+ * @param  src: 原始数据
+ * @param  len: 原始数据长度
+ * @param  dst: 输出缓冲区，至少 TLM_COBS_MAX(len) 字节
+ * @retval 编码后长度 (不含分隔符)
+ */
+size_t TlmFrame_CobsEncode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_idx = 0;   // 当前 code 字节位置
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1;
+        } else {
+            dst[out++] = src[i];
+            if (++code == 0xFF) {
+                dst[code_idx] = code;
+                code_idx = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_idx] = code;
+
+    return out;
+}
+
+/**
+ * @brief  COBS 解码
+ * @param  src: 编码数据 (不含分隔符)
+ * @param  len: 编码数据长度
+ * @param  dst: 输出缓冲区，至少 len 字节
+ * @retval 解码后长度，数据非法时返回 0
+ */
+size_t TlmFrame_CobsDecode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < len) {
+        uint8_t code = src[in++];
+        if (code == 0 || in + code - 1 > len) {
+            return 0;  // 帧内出现 0 或长度越界
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            if (src[in] == 0) return 0;
+            dst[out++] = src[in++];
+        }
+        // code < 0xFF 表示此处原有一个 0，最后一段除外
+        if (code < 0xFF && in < len) {
+            dst[out++] = 0;
+        }
+    }
+
+    return out;
+}
+
+/**
+ * @brief  组装完整的线上帧 (含 CRC、COBS 编码及前后分隔符)
+ * @param  type: 帧类型
+ * @param  seq: 序号
+ * @param  timestamp_ms: 设备时间戳
+ * @param  payload: 负载
+ * @param  payload_len: 负载长度
+ * @param  out: 输出缓冲区，至少 TLM_FRAME_WIRE_MAX 字节
+ * @retval 帧总长度，负载过长时返回 0
+ */
+size_t TlmFrame_Build(uint8_t type, uint16_t seq, uint32_t timestamp_ms,
+                      const void *payload, size_t payload_len, uint8_t *out)
+{
+    uint8_t raw[TLM_FRAME_RAW_MAX];
+    TlmFrameHeader_t header;
+    size_t raw_len;
+    uint16_t crc;
+    size_t n;
+
+    if (sizeof(header) + payload_len + 2 > sizeof(raw)) {
+        return 0;
+    }
+
+    // 1. 帧头 + 负载
+    header.type = type;
+    header.version = TLM_FRAME_VERSION;
+    header.seq = seq;
+    header.timestamp_ms = timestamp_ms;
+    memcpy(raw, &header, sizeof(header));
+    memcpy(raw + sizeof(header), payload, payload_len);
+    raw_len = sizeof(header) + payload_len;
+
+    // 2. CRC16 (小端)
+    crc = TlmFrame_Crc16(0xFFFF, raw, raw_len);
+    raw[raw_len++] = (uint8_t)(crc & 0xFF);
+    raw[raw_len++] = (uint8_t)(crc >> 8);
+
+    // 3. 分隔符 + COBS + 分隔符
+    out[0] = TLM_FRAME_DELIMITER;
+    n = TlmFrame_CobsEncode(raw, raw_len, &out[1]);
+    out[1 + n] = TLM_FRAME_DELIMITER;
+
+    return n + 2;
+}
+
+/**
+ * @brief  解析一帧 (输入为两个分隔符之间的 COBS 数据)
+ * @param  src: 编码数据
+ * @param  len: 编码数据长度
+ * @param  header: 输出帧头
+ * @param  payload: 输出负载缓冲区，至少 TLM_FRAME_RAW_MAX 字节
+ * @retval 负载长度，COBS 非法或 CRC 错误时返回 -1
+ */
+int TlmFrame_Parse(const uint8_t *src, size_t len, TlmFrameHeader_t *header, uint8_t *payload)
+{
+    uint8_t raw[TLM_FRAME_RAW_MAX];
+    size_t raw_len;
+    uint16_t crc;
+
+    if (len == 0 || len > TLM_COBS_MAX(TLM_FRAME_RAW_MAX)) {
+        return -1;
+    }
+
+    raw_len = TlmFrame_CobsDecode(src, len, raw);
+    if (raw_len < sizeof(TlmFrameHeader_t) + 2 || raw_len > sizeof(raw)) {
+        return -1;
+    }
+
+    // 校验 CRC
+    crc = TlmFrame_Crc16(0xFFFF, raw, raw_len - 2);
+    if (raw[raw_len - 2] != (uint8_t)(crc & 0xFF) || raw[raw_len - 1] != (uint8_t)(crc >> 8)) {
+        return -1;
+    }
+
+    memcpy(header, raw, sizeof(TlmFrameHeader_t));
+    raw_len -= sizeof(TlmFrameHeader_t) + 2;
+    memcpy(payload, raw + sizeof(TlmFrameHeader_t), raw_len);
+
+    return (int)raw_len;
+}
@@ -0,0 +1,274 @@
+/**
+  ******************************************************************************
+  * @file           : uart_tx.c
+  * @brief          : UART DMA TX ring buffer implementation
+  *                   串口 DMA 发送环形缓冲区实现
+  ******************************************************************************
+  * @attention
+  *
+  * 写入路径只有一次 CAS 预留 + memcpy + 一次原子加法，不会阻塞调用者；
+  * 实际发送由 DMA 完成，发送完成中断里续发剩余数据；DMA 出错中止发送时丢弃该段后续发。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_tx.h"
+#include <string.h>
+
+/* Private function prototypes -----------------------------------------------*/
+static void UartTx_Kick(UartTx_t *tx);
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  初始化发送环形缓冲区
+ * @param  tx: 发送结构体指针
+ * @param  huart: 串口句柄
+ * @param  buf: 缓冲区
+ * @param  size: 缓冲区大小 (2的幂)
+ * @retval None
+ */
+void UartTx_Init(UartTx_t *tx, UART_HandleTypeDef *huart, uint8_t *buf, uint32_t size)
+{
+    if (tx == NULL) return;
+
+    tx->huart = huart;
+    tx->buf = buf;
+    tx->size = size;
+    atomic_init(&tx->reserve, 0);
+    atomic_init(&tx->commit, 0);
+    atomic_init(&tx->tail, 0);
+    atomic_flag_clear(&tx->busy);
+    atomic_init(&tx->paused, false);
+    tx->dma_len = 0;
+
+    atomic_init(&tx->sent_bytes, 0);
+    atomic_init(&tx->overflow_count, 0);
+    atomic_init(&tx->dropped_bytes, 0);
+    atomic_init(&tx->error_count, 0);
+    tx->high_water = 0;
+}
+
+/**
+ * @brief  写入一条消息（不阻塞）
+ * @param  tx: 发送结构体指针
+ * @param  data: 数据
+ * @param  len: 数据长度
+ * @retval 实际写入字节数，缓冲区不足时返回0（整条丢弃）
+ */
+uint32_t UartTx_Write(UartTx_t *tx, const uint8_t *data, uint32_t len)
+{
+    uint32_t start;
+    uint32_t used;
+    uint32_t mask = tx->size - 1;
+
+    if (len == 0) return 0;
+
+    // 1. CAS 预留空间，空间不足时整条丢弃
+    start = atomic_load(&tx->reserve);
+    do {
+        used = start - atomic_load(&tx->tail);
+        if (len > tx->size - used) {
+            atomic_fetch_add(&tx->overflow_count, 1);
+            atomic_fetch_add(&tx->dropped_bytes, len);
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak(&tx->reserve, &start, start + len));
+
+    // 2. 拷贝数据，跨越缓冲区末尾时分两段
+    uint32_t idx = start & mask;
+    uint32_t first = tx->size - idx;
+    if (first >= len) {
+        memcpy(&tx->buf[idx], data, len);
+    } else {
+        memcpy(&tx->buf[idx], data, first);
+        memcpy(&tx->buf[0], data + first, len - first);
+    }
+
+    // 3. 提交，最后一个完成提交的生产者负责启动 DMA
+    atomic_fetch_add(&tx->commit, len);
+
+    used += len;
+    if (used > tx->high_water) {
+        tx->high_water = used;  // 统计用，竞争时偶尔少记可以接受
+    }
+
+    UartTx_Kick(tx);
+    return len;
+}
+
+/**
+ * @brief  DMA 发送完成处理，在 HAL_UART_TxCpltCallback 中调用
+ * @param  tx: 发送结构体指针
+ * @retval None
+ */
+void UartTx_TxCpltHandler(UartTx_t *tx)
+{
+    uint32_t len = tx->dma_len;
+
+    tx->dma_len = 0;
+    atomic_fetch_add(&tx->sent_bytes, len);
+    atomic_fetch_add(&tx->tail, len);
+    atomic_flag_clear(&tx->busy);
+
+    // 续发剩余数据
+    UartTx_Kick(tx);
+}
+
+/**
+ * @brief  DMA 发送出错处理，在 HAL_UART_ErrorCallback 中调用
+ * @param  tx: 发送结构体指针
+ * @retval None
+ * @note   HAL 在 DMA 发送错误时中止发送 (gState 回到 READY) 且不再产生完成中断，
+ *         这里丢弃正在发送的一段 (已发出多少不确定，重发会产生重复数据)，释放 busy 后续发。
+ *         接收错误也会进入同一回调，只有发送 DMA 报告错误时才处理
+ */
+void UartTx_ErrorHandler(UartTx_t *tx)
+{
+    DMA_HandleTypeDef *hdma = tx->huart->hdmatx;
+    uint32_t len = tx->dma_len;
+
+    if (len == 0 || hdma == NULL || hdma->ErrorCode == HAL_DMA_ERROR_NONE ||
+        tx->huart->gState != HAL_UART_STATE_READY) {
+        return;
+    }
+    hdma->ErrorCode = HAL_DMA_ERROR_NONE;   // 已处理，避免后续接收错误回调重复处理
+    HAL_UART_AbortTransmit(tx->huart);       // 直接模式错误 (DME) 时数据流未被硬件关闭，确保停止
+
+    tx->dma_len = 0;
+    atomic_fetch_add(&tx->error_count, 1);
+    atomic_fetch_add(&tx->dropped_bytes, len);
+    atomic_fetch_add(&tx->tail, len);
+    atomic_flag_clear(&tx->busy);
+
+    // 续发剩余数据
+    UartTx_Kick(tx);
+}
+
+/**
+ * @brief  缓冲区中的数据是否已全部交给 DMA 发送完成
+ * @param  tx: 发送结构体指针
+ * @retval 1: 空闲，0: 仍有数据待发送或正在发送
+ * @note   只说明 DMA 已完成，移位寄存器中的最后一个字节需另查 UART_FLAG_TC
+ */
+int UartTx_IsIdle(UartTx_t *tx)
+{
+    uint32_t tail = atomic_load(&tx->tail);
+
+    return (tx->dma_len == 0 && atomic_load(&tx->reserve) == tail);
+}
+
+/**
+ * @brief  暂停发送: 之后写入的数据只进缓冲区，不再启动新的 DMA
+ * @param  tx: 发送结构体指针
+ * @retval 1: 已暂停 (没有进行中的 DMA)，0: 当前一段仍在发送，稍后再调用
+ * @note   暂停后完成中断不再续发，busy 空出后由这里占住，此后任何人都无法启动 DMA
+ */
+int UartTx_Pause(UartTx_t *tx)
+{
+    atomic_store(&tx->paused, true);
+    return atomic_flag_test_and_set(&tx->busy) ? 0 : 1;
+}
+
+/**
+ * @brief  中止正在发送的一段并丢弃 (计入丢弃字节数)
+ * @param  tx: 发送结构体指针
+ * @retval None
+ * @note   中止后没有完成中断，busy 转归暂停者；已发出多少不确定，整段丢弃
+ */
+void UartTx_Abort(UartTx_t *tx)
+{
+    uint32_t len;
+
+    HAL_UART_AbortTransmit(tx->huart);
+
+    len = tx->dma_len;
+    tx->dma_len = 0;
+    atomic_fetch_add(&tx->dropped_bytes, len);
+    atomic_fetch_add(&tx->tail, len);
+}
+
+/**
+ * @brief  恢复发送，暂停期间写入的数据随即发出
+ * @param  tx: 发送结构体指针
+ * @retval None
+ */
+void UartTx_Resume(UartTx_t *tx)
+{
+    atomic_store(&tx->paused, false);
+    atomic_flag_clear(&tx->busy);
+    UartTx_Kick(tx);
+}
+
+/**
+ * @brief  获取发送统计信息
+ * @param  tx: 发送结构体指针
+ * @param  stats: 输出统计信息
+ * @retval None
+ */
+void UartTx_GetStats(UartTx_t *tx, UartTx_Stats_t *stats)
+{
+    if (tx == NULL || stats == NULL) return;
+
+    stats->sent_bytes = atomic_load(&tx->sent_bytes);
+    stats->overflow_count = atomic_load(&tx->overflow_count);
+    stats->dropped_bytes = atomic_load(&tx->dropped_bytes);
+    stats->error_count = atomic_load(&tx->error_count);
+    stats->high_water = tx->high_water;
+}
+
+/**
+ * @brief  DMA 空闲且所有预留都已提交时，启动下一段 DMA 发送
+ * @param  tx: 发送结构体指针
+ * @retval None
+ * @note   busy 标志保证同一时刻只有一个调用者能启动 DMA；
+ *         释放 busy 后再检查一次，避免与正在提交的生产者错过彼此
+ */
+static void UartTx_Kick(UartTx_t *tx)
+{
+    for (;;) {
+        if (atomic_load(&tx->paused)) {
+            return;  // 已暂停，由 UartTx_Resume 续发
+        }
+        if (atomic_flag_test_and_set(&tx->busy)) {
+            return;  // DMA 正在发送，由完成中断续发
+        }
+        if (atomic_load(&tx->paused)) {
+            atomic_flag_clear(&tx->busy);   // 与 UartTx_Pause 竞争: 让给暂停者
+            return;
+        }
+
+        uint32_t tail = atomic_load(&tx->tail);
+        uint32_t commit = atomic_load(&tx->commit);
+        uint32_t reserve = atomic_load(&tx->reserve);
+
+        if (commit == reserve && commit != tail) {
+            // 只发送到缓冲区末尾的连续部分，剩余部分下次续发
+            uint32_t idx = tail & (tx->size - 1);
+            uint32_t len = commit - tail;
+            if (len > tx->size - idx) {
+                len = tx->size - idx;
+            }
+            if (len > 0xFFFFU) {
+                len = 0xFFFFU;  // DMA 单次最多 65535 字节
+            }
+
+            tx->dma_len = len;
+            if (HAL_UART_Transmit_DMA(tx->huart, &tx->buf[idx], (uint16_t)len) == HAL_OK) {
+                return;
+            }
+            tx->dma_len = 0;
+            atomic_flag_clear(&tx->busy);
+            return;  // 串口忙，留待下一次写入或完成中断
+        }
+
+        atomic_flag_clear(&tx->busy);
+
+        // 仍有生产者未提交时由它负责启动；否则确认释放 busy 期间没有漏掉的数据
+        commit = atomic_load(&tx->commit);
+        if (commit != atomic_load(&tx->reserve) || commit == atomic_load(&tx->tail)) {
+            return;
+        }
+    }
+}
@@ -21,22 +21,41 @@
 #include "usart.h"
 
 /* USER CODE BEGIN 0 */
+#include "fmt.h"
 
 
 // 定义发送缓冲区大小
 #define UART_TX_BUFFER_SIZE 256
-#define UART_RX_BUFFER_SIZE 64          // 环形或临时接收缓冲区总大小
+#define UART2_TX_RING_SIZE  1024        // USART2 DMA 发送环形缓冲区大小 (2的幂)
+#define UART2_RX_DMA_SIZE   128         // USART2 DMA 循环接收缓冲区大小
+#define UART2_RX_STREAM_SIZE 256        // USART2 接收流缓冲区大小 (ISR -> 接收任务)
+#define UART2_DRAIN_TIMEOUT_MS 200      // 切换波特率前等待发送缓冲区排空的超时
+#define UART2_TC_TIMEOUT_MS    2        // 等待最后一个字节移出的超时 (9600 时一个字符约 1ms)
+#define UART1_TX_RING_SIZE  2048        // USART1 数据通道 DMA 发送环形缓冲区大小 (2的幂)
 
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart1;
 UART_HandleTypeDef huart2;
+DMA_HandleTypeDef hdma_usart2_rx;
+DMA_HandleTypeDef hdma_usart2_tx;
+DMA_HandleTypeDef hdma_usart1_tx;
 
 /* USER CODE BEGIN 1 */
 
 
-//static uint8_t rx_buffer[UART_RX_BUFFER_SIZE]; // 用于累积数据的缓冲区
-uint8_t rx_byte;               // 用于单字节接收
+static uint8_t uart2_rx_dma_buf[UART2_RX_DMA_SIZE];  // DMA 循环接收缓冲区
+static uint16_t uart2_rx_last_pos;                    // 上次处理到的 DMA 缓冲区位置
+static uint8_t uart2_rx_stream_storage[UART2_RX_STREAM_SIZE + 1];
+static StaticStreamBuffer_t uart2_rx_stream_struct;
+StreamBufferHandle_t usart_rx_streamHandle;           // USART2 接收流缓冲区
+static volatile UartRx_Stats_t uart2_rx_stats;        // USART2 接收统计
+
+static uint8_t uart2_tx_buf[UART2_TX_RING_SIZE]; // USART2 发送环形缓冲区
+UartTx_t uart2_tx;                              // USART2 DMA 发送引擎
+
+static uint8_t uart1_tx_buf[UART1_TX_RING_SIZE]; // USART1 发送环形缓冲区
+UartTx_t uart1_tx;                              // USART1 DMA 发送引擎 (数据通道)
 
 
 
@@ -53,7 +72,7 @@ void MX_USART1_UART_Init(void)
 
   /* USER CODE END USART1_Init 1 */
   huart1.Instance = USART1;
-  huart1.Init.BaudRate = 115200;
+  huart1.Init.BaudRate = 921600;
   huart1.Init.WordLength = UART_WORDLENGTH_8B;
   huart1.Init.StopBits = UART_STOPBITS_1;
   huart1.Init.Parity = UART_PARITY_NONE;
@@ -65,6 +84,7 @@ void MX_USART1_UART_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN USART1_Init 2 */
+  UartTx_Init(&uart1_tx, &huart1, uart1_tx_buf, UART1_TX_RING_SIZE);
 
   /* USER CODE END USART1_Init 2 */
 
@@ -94,7 +114,10 @@ void MX_USART2_UART_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN USART2_Init 2 */
-
+  UartTx_Init(&uart2_tx, &huart2, uart2_tx_buf, UART2_TX_RING_SIZE);
+  // 接收流缓冲区静态创建，保证在调度器启动前开始接收也能安全写入
+  usart_rx_streamHandle = xStreamBufferCreateStatic(UART2_RX_STREAM_SIZE, 1,
+                                                    uart2_rx_stream_storage, &uart2_rx_stream_struct);
   /* USER CODE END USART2_Init 2 */
 
 }
@@ -123,6 +146,25 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     GPIO_InitStruct.Alternate = GPIO_AF7_USART1;
     HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
+    /* USART1 DMA Init */
+    /* USART1_TX Init */
+    hdma_usart1_tx.Instance = DMA2_Stream7;
+    hdma_usart1_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_usart1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart1_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart1_tx.Init.Mode = DMA_NORMAL;
+    hdma_usart1_tx.Init.Priority = DMA_PRIORITY_MEDIUM;
+    hdma_usart1_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_usart1_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmatx,hdma_usart1_tx);
+
   /* USER CODE BEGIN USART1_MspInit 1 */
     /* USART1 中断配置 */
     /* 注意: 优先级必须 >= configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY (5) */
@@ -150,7 +192,43 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
     GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
     HAL_GPIO_Init(GPIOD, &GPIO_InitStruct);
-    
+
+    /* USART2 DMA Init */
+    /* USART2_RX Init */
+    hdma_usart2_rx.Instance = DMA1_Stream5;
+    hdma_usart2_rx.Init.Channel = DMA_CHANNEL_4;
+    hdma_usart2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_usart2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_usart2_rx.Init.Priority = DMA_PRIORITY_MEDIUM;
+    hdma_usart2_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_usart2_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmarx,hdma_usart2_rx);
+
+    /* USART2_TX Init */
+    hdma_usart2_tx.Instance = DMA1_Stream6;
+    hdma_usart2_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_usart2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart2_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart2_tx.Init.Mode = DMA_NORMAL;
+    hdma_usart2_tx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_usart2_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_usart2_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmatx,hdma_usart2_tx);
 
   /* USER CODE BEGIN USART2_MspInit 1 */
     /* USART2 中断配置 */
@@ -180,6 +258,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     */
     HAL_GPIO_DeInit(GPIOB, GPIO_PIN_6|GPIO_PIN_7);
 
+    /* USART1 DMA DeInit */
+    HAL_DMA_DeInit(uartHandle->hdmatx);
+
   /* USER CODE BEGIN USART1_MspDeInit 1 */
 
   /* USER CODE END USART1_MspDeInit 1 */
@@ -199,6 +280,10 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     */
     HAL_GPIO_DeInit(GPIOD, GPIO_PIN_5|GPIO_PIN_6);
 
+    /* USART2 DMA DeInit */
+    HAL_DMA_DeInit(uartHandle->hdmarx);
+    HAL_DMA_DeInit(uartHandle->hdmatx);
+
   /* USER CODE BEGIN USART2_MspDeInit 1 */
 
   /* USER CODE END USART2_MspDeInit 1 */
@@ -219,8 +304,11 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
  *         send_message("ADC: %d, Voltage: %.2fV\n", adc_value, voltage);
  * 
  * @note   此函数线程安全，可在FreeRTOS多任务环境中使用
+ * @note   格式化后写入 DMA 发送环形缓冲区即返回，不等待发送完成；
+ *         缓冲区满时整条消息被丢弃，可通过 UartTx_GetStats 查看丢弃统计
+ * @note   函数名加括号，避免定义 LOG_DEFERRED 时被同名宏展开
  */
-void send_message(const char *format, ...)
+void (send_message)(const char *format, ...)
 {
     char buffer[UART_TX_BUFFER_SIZE];
     va_list args;
@@ -228,31 +316,246 @@ void send_message(const char *format, ...)
     // 开始可变参数处理
     va_start(args, format);
     
-    // 格式化字符串到缓冲区
-    int len = vsnprintf(buffer, UART_TX_BUFFER_SIZE, format, args);
+    // 格式化字符串到缓冲区 (轻量格式化，不分配内存)
+    int len = Fmt_Vsnprintf(buffer, UART_TX_BUFFER_SIZE, format, args);
     
     // 结束可变参数处理
     va_end(args);
     
     // 确保不超过缓冲区大小
     if (len > 0 && len < UART_TX_BUFFER_SIZE) {
-        // 通过串口2发送数据
-        HAL_UART_Transmit(&huart2, (uint8_t*)buffer, len, HAL_MAX_DELAY);
+        // 写入串口2发送环形缓冲区，由 DMA 后台发送
+        UartTx_Write(&uart2_tx, (uint8_t*)buffer, (uint32_t)len);
     }
 }
 
-
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
+    // DMA 发送完成，续发环形缓冲区中的剩余数据
     if (huart->Instance == USART2) {
-        // 将接收到的字节放入队列
-        // 注意：osMessagePut 可以在 ISR 中调用，但中断优先级必须正确配置
-        // 队列满时会返回错误，不会阻塞
-        osMessagePut(usart_rx_queueHandle, (uint32_t)rx_byte, 0);
-        
-        
-        // 重新启动接收
-        HAL_UART_Receive_IT(&huart2, &rx_byte, 1);
+        UartTx_TxCpltHandler(&uart2_tx);
+    } else if (huart->Instance == USART1) {
+        UartTx_TxCpltHandler(&uart1_tx);
+    }
+}
+
+
+/**
+ * @brief  启动 USART2 DMA 循环接收 (空闲线检测)
+ * @retval None
+ * @note   DMA 半满、全满和串口空闲 (IDLE) 时均会进入 HAL_UARTEx_RxEventCallback，
+ *         每次把新收到的一段数据整体写入接收流缓冲区，接收任务每段只被唤醒一次
+ */
+void USART2_StartReceive(void)
+{
+    uart2_rx_last_pos = 0;
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&huart2, uart2_rx_dma_buf, UART2_RX_DMA_SIZE) != HAL_OK) {
+        uart2_rx_stats.restart_fail++;
+    }
+}
+
+/**
+ * @brief  计算 USART2 在当前 PCLK1 下实际能达到的波特率
+ * @param  baud: 目标波特率
+ * @retval 实际波特率，超出范围或误差大于 2% 时返回 0
+ * @note   16 倍过采样时 BRR = PCLK1 / baud (12位整数 + 4位小数)，
+ *         PCLK1 = 36MHz 时最高 2.25Mbaud
+ */
+uint32_t USART2_CheckBaudRate(uint32_t baud)
+{
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    uint32_t brr;
+    uint32_t actual;
+    uint32_t diff;
+
+    if (baud == 0 || baud > pclk / 16U) {
+        return 0;
+    }
+
+    brr = UART_BRR_SAMPLING16(pclk, baud);
+    if (brr == 0) {
+        return 0;
+    }
+    actual = pclk / brr;
+
+    diff = (actual > baud) ? (actual - baud) : (baud - actual);
+    if (diff * 50U > baud) {
+        return 0;
+    }
+    return actual;
+}
+
+/**
+ * @brief  重写 USART2 BRR (修改时需关闭 UE)，调用者保证此时没有 DMA 发送
+ */
+static void USART2_WriteBRR(uint32_t baud)
+{
+    __HAL_UART_DISABLE(&huart2);
+    huart2.Init.BaudRate = baud;
+    huart2.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK1Freq(), baud);
+    __HAL_UART_ENABLE(&huart2);
+}
+
+/**
+ * @brief  运行时修改 USART2 波特率
+ * @param  baud: 新波特率 (需先经 USART2_CheckBaudRate 检查)
+ * @retval HAL_OK: 已切换，HAL_TIMEOUT: 发送缓冲区未能排空，HAL_ERROR: 波特率不可用
+ * @note   等待发送缓冲区排空后切换，并重新启动 DMA 接收；只能在任务中调用
+ */
+HAL_StatusTypeDef USART2_SetBaudRate(uint32_t baud)
+{
+    uint32_t start = HAL_GetTick();
+
+    if (USART2_CheckBaudRate(baud) == 0) {
+        return HAL_ERROR;
+    }
+
+    // 1. 停止接收 (HAL_DMA_Abort 依赖 HAL_GetTick，不能放在临界区内)
+    HAL_UART_AbortReceive(&huart2);
+
+    for (;;) {
+        // 2. 等待 DMA 发送完且最后一个字节移出 (TC)，临界区内再确认一次，
+        //    保证切换过程中不会有新的 DMA 发送被启动
+        if (UartTx_IsIdle(&uart2_tx) && __HAL_UART_GET_FLAG(&huart2, UART_FLAG_TC)) {
+            taskENTER_CRITICAL();
+            if (UartTx_IsIdle(&uart2_tx)) {
+                break;   // 保持临界区，直到修改完成
+            }
+            taskEXIT_CRITICAL();
+        }
+        if (HAL_GetTick() - start > UART2_DRAIN_TIMEOUT_MS) {
+            USART2_StartReceive();
+            return HAL_TIMEOUT;
+        }
+        osDelay(1);
+    }
+
+    // 3. 重写 BRR
+    USART2_WriteBRR(baud);
+    taskEXIT_CRITICAL();
+
+    // 4. 重新开始接收，切换瞬间收到的残缺数据由命令解析按行丢弃
+    USART2_StartReceive();
+    return HAL_OK;
+}
+
+/**
+ * @brief  不等发送缓冲区排空，强制修改 USART2 波特率
+ * @param  baud: 新波特率 (需先经 USART2_CheckBaudRate 检查)
+ * @retval HAL_OK: 已切换，HAL_ERROR: 波特率不可用
+ * @note   暂停发送后切换，缓冲区中未发的数据切换后以新波特率发出；
+ *         当前一段 DMA 在 UART2_DRAIN_TIMEOUT_MS 内发不完时中止并丢弃该段。只能在任务中调用
+ */
+HAL_StatusTypeDef USART2_ForceBaudRate(uint32_t baud)
+{
+    uint32_t start = HAL_GetTick();
+
+    if (USART2_CheckBaudRate(baud) == 0) {
+        return HAL_ERROR;
+    }
+
+    HAL_UART_AbortReceive(&huart2);
+
+    // 1. 暂停发送，等当前一段 DMA 发完，超时则中止该段
+    while (!UartTx_Pause(&uart2_tx)) {
+        if (HAL_GetTick() - start > UART2_DRAIN_TIMEOUT_MS) {
+            UartTx_Abort(&uart2_tx);
+            break;
+        }
+        osDelay(1);
+    }
+
+    // 2. 等最后一个字节移出，最多一个字符时间
+    start = HAL_GetTick();
+    while (!__HAL_UART_GET_FLAG(&huart2, UART_FLAG_TC) &&
+           HAL_GetTick() - start < UART2_TC_TIMEOUT_MS) {
+        osDelay(1);
+    }
+
+    // 3. 暂停期间没有人能启动 DMA，无需临界区
+    USART2_WriteBRR(baud);
+    UartTx_Resume(&uart2_tx);
+
+    USART2_StartReceive();
+    return HAL_OK;
+}
+
+/**
+ * @brief  获取 USART2 当前波特率
+ * @retval 波特率
+ */
+uint32_t USART2_GetBaudRate(void)
+{
+    return huart2.Init.BaudRate;
+}
+
+/**
+ * @brief  获取 USART2 接收统计
+ * @param  stats: 输出统计信息
+ * @retval None
+ */
+void USART2_GetRxStats(UartRx_Stats_t *stats)
+{
+    if (stats == NULL) return;
+    *stats = uart2_rx_stats;
+}
+
+/**
+ * @brief  把 DMA 缓冲区中的一段数据写入接收流缓冲区 (ISR 中调用)
+ */
+static void USART2_PushRxChunk(const uint8_t *data, uint16_t len, BaseType_t *woken)
+{
+    size_t sent;
+
+    if (len == 0) return;
+
+    uart2_rx_stats.rx_bytes += len;
+    sent = xStreamBufferSendFromISR(usart_rx_streamHandle, data, len, woken);
+    if (sent < len) {
+        // 接收任务来不及处理，多出的字节丢弃
+        uart2_rx_stats.stream_overflow += (uint32_t)(len - sent);
+    }
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (huart->Instance != USART2) return;
+
+    // Size 为 DMA 缓冲区当前写入位置，循环模式下回绕时分两段处理
+    if (Size != uart2_rx_last_pos) {
+        if (Size > uart2_rx_last_pos) {
+            USART2_PushRxChunk(&uart2_rx_dma_buf[uart2_rx_last_pos], Size - uart2_rx_last_pos, &woken);
+        } else {
+            USART2_PushRxChunk(&uart2_rx_dma_buf[uart2_rx_last_pos], UART2_RX_DMA_SIZE - uart2_rx_last_pos, &woken);
+            USART2_PushRxChunk(&uart2_rx_dma_buf[0], Size, &woken);
+        }
+        uart2_rx_last_pos = (Size == UART2_RX_DMA_SIZE) ? 0 : Size;
+        uart2_rx_stats.chunks++;
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    // DMA 发送错误会中止发送且没有完成回调，丢弃该段后续发
+    if (huart->Instance == USART1) {
+        UartTx_ErrorHandler(&uart1_tx);
+        return;
+    }
+    if (huart->Instance != USART2) return;
+    UartTx_ErrorHandler(&uart2_tx);
+
+    uint32_t err = huart->ErrorCode;
+    if (err & HAL_UART_ERROR_ORE) uart2_rx_stats.overrun++;
+    if (err & HAL_UART_ERROR_FE)  uart2_rx_stats.frame_err++;
+    if (err & HAL_UART_ERROR_NE)  uart2_rx_stats.noise_err++;
+
+    // 出错后 HAL 会停止 DMA 接收，重新启动
+    if (huart->RxState == HAL_UART_STATE_READY) {
+        USART2_StartReceive();
     }
 }
 /* USER CODE END 1 */
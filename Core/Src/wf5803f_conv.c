@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file           : wf5803f_conv.c
+  * @brief          : WF5803F fixed-point conversion
+  *                   WF5803F 原始数据定点换算实现
+  ******************************************************************************
+  * @attention
+  *
+  * P × 81 × 2^23 = raw × 量程 × 100 + (量程下限 × 81 − 量程 × 10) × 2^23，
+  * 常数项再加上 81 × 2^22 (半个单位)，向下取整即为四舍五入。
+  * 对正除数 floor(floor(N / 2^23) / 81) = floor(N / (81 × 2^23))，先移位后除法不损失精度。
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "wf5803f_conv.h"
+
+/* Private define ------------------------------------------------------------*/
+/* 编译期计算换算参数 (min、span 单位 Pa) */
+#define WF5803F_CONV_K(span)        ((int32_t)(span) * 100)
+#define WF5803F_CONV_C(min, span) \
+    (((int64_t)(min) * WF5803F_CONV_DIV - (int64_t)(span) * 10) * ((int64_t)1 << WF5803F_CONV_SHIFT) + \
+     ((int64_t)WF5803F_CONV_DIV << (WF5803F_CONV_SHIFT - 1)))
+#define WF5803F_MODEL_ENTRY(name, min, span) \
+    { (name), (min), (span), WF5803F_CONV_K(span), WF5803F_CONV_C(min, span) }
+
+/* Exported variables --------------------------------------------------------*/
+const WF5803F_Model_t wf5803f_models[WF5803F_MODEL_COUNT] = {
+    [WF5803F_MODEL_2BAR] = WF5803F_MODEL_ENTRY("2bar", 30000, 180000),
+    [WF5803F_MODEL_7BAR] = WF5803F_MODEL_ENTRY("7bar", 0, 700000),
+};
+
+/* Function implementations --------------------------------------------------*/
+
+/**
+ * @brief  原始压力换算为 Pa
+ */
+int32_t WF5803F_ConvPressure(const WF5803F_Model_t *model, int32_t raw)
+{
+    int32_t t;
+
+    // 24 位符号扩展
+    raw = (int32_t)((uint32_t)raw << 8) >> 8;
+
+    t = (int32_t)(((int64_t)raw * model->k + model->c) >> WF5803F_CONV_SHIFT);
+
+    // 向下取整的除法 (C 的除法向零取整)
+    return (t >= 0) ? t / WF5803F_CONV_DIV : -((-t + WF5803F_CONV_DIV - 1) / WF5803F_CONV_DIV);
+}
+
+/**
+ * @brief  原始温度换算为 0.01℃
+ */
+int32_t WF5803F_ConvTemperature(int16_t raw)
+{
+    return ((int32_t)raw * 100 + 128) >> 8;
+}
+
+/**
+ * @brief  当前编译选定的型号
+ */
+const WF5803F_Model_t *WF5803F_ConvModel(void)
+{
+    return &wf5803f_models[WF5803F_MODEL];
+}
@@ -0,0 +1,42 @@
+/**
+ * @file    bench_clock.hpp
+ * @brief   主机基准测试工具 (Host/tools/*_bench.cpp) 共用的计时源
+ *
+ * x86 上读 TSC (时钟周期，lfence 串行化)，其他平台用 steady_clock (ns)，单位见 kClockUnit。
+ * 主机与板上 (Cortex-M4F, newlib) 的 CPU、编译选项和库实现都不同，测得的耗时只用于比较
+ * 同一工具内各实现的相对开销；板上的绝对耗时看各命令应答中的 DWT 周期。
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+#if defined(__x86_64__) || defined(__i386__)
+constexpr const char *kClockUnit = "TSC";
+
+/** @brief 当前 TSC 计数，前后 lfence 避免被测代码与 rdtsc 乱序重叠 */
+inline uint64_t now()
+{
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+#else
+constexpr const char *kClockUnit = "ns";
+
+/** @brief 当前 steady_clock 时间 (ns) */
+inline uint64_t now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+}  // namespace bench
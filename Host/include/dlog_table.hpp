@@ -0,0 +1,42 @@
+/**
+ * @file    dlog_table.hpp
+ * @brief   延迟格式化日志还原 (读取固件 ELF 的 .log_fmt 段)
+ *
+ * 固件定义 LOG_DEFERRED 时 send_message 只发送 日志ID + 二进制参数
+ * (TLM_FRAME_TYPE_LOG 帧，编码见 Core/Inc/dlog.h)。
+ * 日志ID 为格式字符串在 .log_fmt 段中的地址，此处按 ID 查回格式字符串并格式化。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tlm {
+
+class DLogTable {
+public:
+    /**
+     * @brief 从固件 ELF 文件加载 .log_fmt 段
+     * @param path ELF 路径 (build/Debug/I2C.elf)
+     * @param err  失败原因
+     */
+    bool loadElf(const std::string &path, std::string &err);
+
+    bool loaded() const { return !section_.empty(); }
+
+    /**
+     * @brief 还原一条日志
+     * @param payload TLM_FRAME_TYPE_LOG 帧负载
+     * @param len     负载长度
+     * @return 格式化后的文本 (未知 ID 时返回占位说明)
+     */
+    std::string format(const uint8_t *payload, size_t len) const;
+
+private:
+    uint32_t base_ = 0;            // .log_fmt 段起始地址
+    std::vector<char> section_;    // .log_fmt 段内容
+};
+
+}  // namespace tlm
@@ -0,0 +1,119 @@
+/**
+ * @file    record_store.hpp
+ * @brief   传感器记录的追加式存储 (NDJSON / 列式二进制) 与旧版 JSON 数组导出
+ *
+ * 《上位机需求文档》中的做法是每收到一条 NTC 数据就重写整个 JSON 数组文件，
+ * 长时间运行时总代价为 O(n²)。这里改为只追加:
+ * - NDJSON: 每条记录一行，崩溃后最多丢失最后一行
+ * - 列式二进制 (.tlmc): 按块写入，每块内各列连续存放，便于直接映射为数组画图
+ * 需要旧格式时用 tlm_export 一次性转换。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tlm {
+
+/** @brief 传感器编号 (与固件 JSON 消息中的 "sensor" 字段对应) */
+enum class SensorId : uint8_t {
+    Unknown = 0,
+    WF5803 = 1,   // v0 = temp (°C), v1 = press (kPa)
+    NTC = 2,      // v0 = temp (°C)
+    PID = 3,      // v0 = output
+};
+
+/** @brief 一条传感器记录 */
+struct Record {
+    double pc_time_sec = 0.0;   // 上位机接收时间 (Unix 秒)
+    SensorId sensor = SensorId::Unknown;
+    float v0 = 0.0f;
+    float v1 = 0.0f;
+};
+
+const char *sensorName(SensorId id);
+SensorId sensorFromName(std::string_view name);
+
+/** @brief 文本行分类结果 */
+enum class LineKind {
+    Text,       // 普通文本
+    Data,       // {"type":"data",...} 传感器数据
+    OtherJson,  // 其他 JSON (命令应答等)
+};
+
+/**
+ * @brief 分类一行文本，传感器数据行同时解析出记录值 (不分配内存)
+ * @param line 不含换行的一行
+ * @param rec  Data 时输出 sensor/v0/v1，pc_time_sec 不修改
+ */
+LineKind classifyLine(std::string_view line, Record &rec);
+
+/** @brief 记录写入接口 */
+class RecordWriter {
+public:
+    virtual ~RecordWriter() = default;
+    virtual bool write(const Record &rec) = 0;
+    /** @brief 把缓冲数据写入文件 (不关闭) */
+    virtual bool flush() = 0;
+};
+
+/** @brief NDJSON 追加写入 */
+class NdjsonWriter : public RecordWriter {
+public:
+    ~NdjsonWriter() override;
+    bool open(const std::string &path, std::string &err);
+    bool write(const Record &rec) override;
+    bool flush() override;
+
+private:
+    std::FILE *file_ = nullptr;
+};
+
+/**
+ * @brief 列式二进制追加写入
+ *
+ * 文件格式 (小端):
+ *   文件头: "TLMC" | u16 版本 | u16 保留
+ *   块:     u32 记录数 n | u32 保留 | f64 pc_time_sec[n] | u8 sensor[n] | 填充到 8 字节 | f32 v0[n] | f32 v1[n]
+ * 各列均按自身大小对齐，整块可直接映射为数组。
+ * 每 kBlockRecords 条或 flush() 时写出一块；文件末尾不完整的块读取时忽略。
+ */
+class ColumnWriter : public RecordWriter {
+public:
+    static constexpr size_t kBlockRecords = 1024;
+
+    ~ColumnWriter() override;
+    bool open(const std::string &path, std::string &err);
+    bool write(const Record &rec) override;
+    bool flush() override;
+
+private:
+    bool writeBlock();
+
+    std::FILE *file_ = nullptr;
+    std::vector<double> time_;
+    std::vector<uint8_t> sensor_;
+    std::vector<float> v0_;
+    std::vector<float> v1_;
+};
+
+/**
+ * @brief 顺序读取 NDJSON 或列式文件中的全部记录 (按文件头自动识别格式)
+ * @param path 文件路径
+ * @param cb   每条记录回调
+ * @param err  失败原因
+ */
+bool readRecords(const std::string &path, const std::function<void(const Record &)> &cb,
+                 std::string &err);
+
+/**
+ * @brief Unix 秒转本地时间 ISO 字符串 (与 Python datetime.isoformat() 相同，精确到微秒)
+ */
+std::string isoTimestamp(double pc_time_sec);
+
+}  // namespace tlm
@@ -0,0 +1,105 @@
+/**
+ * @file    tlm_decoder.hpp
+ * @brief   STM32 串口数据流解码 (二进制遥测帧 + 文本行)
+ *
+ * 串口流中二进制帧以 0x00 分隔 (见 Core/Inc/tlm_frame.h)，其余字节为普通文本。
+ * StreamDecoder 逐字节喂入，解出的采样与文本行通过回调交给调用者。
+ * 支持 TLM_FRAME_VERSION_MIN ~ TLM_FRAME_VERSION 的帧；旧版本的采样记录按该版本的长度校验，
+ * 缺少的字段补 0，Sample::version 记录原版本，stats().frames_old 计数。
+ *
+ * 从帧中间开始接收时，上一帧的结束分隔符会被当成起始分隔符，之后的文本成为候选帧。
+ * 候选帧解析失败 (COBS/CRC)，或收到 '\n' 时开头不可能是合法帧头，就把它按文本重放并退出
+ * 帧状态；解析失败时结束它的 0x00 当作下一帧的起始，下一帧即可正常解出。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "tlm_frame.h"
+
+namespace tlm {
+
+/** @brief 解码后的一条采样记录 */
+struct Sample {
+    uint16_t seq = 0;
+    uint32_t device_ms = 0;   // 设备时间戳 (ms)
+    uint8_t version = TLM_FRAME_VERSION;  // 帧头版本，旧版本中没有的字段为 0
+    TlmSample_t data{};
+};
+
+/** @brief 解码统计 */
+struct DecoderStats {
+    uint64_t frames_ok = 0;
+    uint64_t frames_bad = 0;      // COBS 非法 / CRC 错误 / 长度不符
+    uint64_t frames_unknown = 0;  // 未知帧类型或版本
+    uint64_t frames_old = 0;      // 旧版本 (TLM_FRAME_VERSION_MIN ~ TLM_FRAME_VERSION - 1) 的帧
+    uint64_t seq_gaps = 0;        // 序号不连续 (丢帧) 次数
+    uint64_t text_lines = 0;
+};
+
+class StreamDecoder {
+public:
+    using SampleHandler = std::function<void(const Sample &)>;
+    using TextHandler = std::function<void(const std::string &)>;
+    using FrameHandler = std::function<void(const TlmFrameHeader_t &, const uint8_t *, size_t)>;
+
+    void onSample(SampleHandler h) { sample_handler_ = std::move(h); }
+    void onText(TextHandler h) { text_handler_ = std::move(h); }
+    /** @brief 非采样类型的合法帧 (供后续帧类型扩展使用) */
+    void onFrame(FrameHandler h) { frame_handler_ = std::move(h); }
+
+    /** @brief 批量喂入，文本部分整段扫描 (回放大文件时的主要路径) */
+    void feed(const uint8_t *data, size_t len);
+    void feed(uint8_t byte);
+
+    const DecoderStats &stats() const { return stats_; }
+
+private:
+    bool finishFrame();
+    bool frameHeaderPlausible() const;
+    void replayFrameAsText();
+    void finishText();
+    void appendText(const uint8_t *data, size_t len);
+
+    bool in_frame_ = false;
+    std::vector<uint8_t> frame_;
+    std::string text_;
+    bool have_seq_[256] = {};      // 按帧类型记录
+    uint16_t last_seq_[256] = {};
+    DecoderStats stats_;
+
+    SampleHandler sample_handler_;
+    TextHandler text_handler_;
+    FrameHandler frame_handler_;
+};
+
+/**
+ * @brief 查找第一个 '\n' 或 0x00 (帧分隔符)
+ *
+ * 按 8 字节一组做 SWAR 比较，编译器可进一步向量化；
+ * 文本行和帧分隔符都很稀疏，大部分字节只参与一次整字比较。
+ * @return 位置偏移，未找到时返回 len
+ */
+size_t findLineOrDelimiter(const uint8_t *data, size_t len);
+
+/** @brief 采样记录中的 CPU 周期数换算为微秒 (TLM_CPU_HZ) */
+uint64_t cyclesToUs(uint64_t cycles);
+
+/**
+ * @brief 把一条采样还原为《上位机需求文档》中的三条 JSON 消息
+ * @param version 帧头版本，早于 TLM_SAMPLE_VERSION_CYCLES 时不输出时间字段 (lat_us/t_us/age_us)
+ * @return 以 '\n' 结尾的三行文本；有传感器故障时再加一行 {"type":"fault",...}
+ */
+std::string sampleToJsonLines(const TlmSample_t &s, uint8_t version = TLM_FRAME_VERSION);
+
+/**
+ * @brief 把多通道温控状态还原为固件 JSON 模式下的 ZONE 消息 (通道 2~4 中启用的通道)
+ * @return 每个通道一行，以 '\n' 结尾
+ */
+std::string thermalToJsonLines(const TlmThermal_t &t);
+
+}  // namespace tlm
@@ -0,0 +1,170 @@
+/**
+ * @file    dlog_table.cpp
+ * @brief   延迟格式化日志还原实现
+ */
+#include "dlog_table.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace tlm {
+
+namespace {
+
+// ELF32 小端格式 (arm-none-eabi 输出)
+template <typename T>
+T readLe(const std::vector<char> &buf, size_t off)
+{
+    T v{};
+    std::memcpy(&v, buf.data() + off, sizeof(T));
+    return v;
+}
+
+int32_t readI32(const uint8_t *p)
+{
+    int32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+}  // namespace
+
+bool DLogTable::loadElf(const std::string &path, std::string &err)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        err = "cannot open " + path;
+        return false;
+    }
+    std::vector<char> elf((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    if (elf.size() < 52 || std::memcmp(elf.data(), "\x7f" "ELF", 4) != 0) {
+        err = "not an ELF file";
+        return false;
+    }
+    if (elf[4] != 1 || elf[5] != 1) {
+        err = "only little-endian ELF32 is supported";
+        return false;
+    }
+
+    uint32_t shoff = readLe<uint32_t>(elf, 0x20);
+    uint16_t shentsize = readLe<uint16_t>(elf, 0x2E);
+    uint16_t shnum = readLe<uint16_t>(elf, 0x30);
+    uint16_t shstrndx = readLe<uint16_t>(elf, 0x32);
+    if (shoff == 0 || shentsize < 40 || shstrndx >= shnum ||
+        shoff + static_cast<size_t>(shentsize) * shnum > elf.size()) {
+        err = "bad section header table";
+        return false;
+    }
+
+    auto sh = [&](uint16_t i, size_t field) {
+        return readLe<uint32_t>(elf, shoff + static_cast<size_t>(i) * shentsize + field);
+    };
+    uint32_t strtab_off = sh(shstrndx, 0x10);
+
+    for (uint16_t i = 0; i < shnum; i++) {
+        uint32_t name = sh(i, 0x00);
+        if (strtab_off + name >= elf.size()) {
+            continue;
+        }
+        if (std::strcmp(elf.data() + strtab_off + name, ".log_fmt") != 0) {
+            continue;
+        }
+        uint32_t addr = sh(i, 0x0C);
+        uint32_t off = sh(i, 0x10);
+        uint32_t size = sh(i, 0x14);
+        if (static_cast<size_t>(off) + size > elf.size()) {
+            err = ".log_fmt section out of range";
+            return false;
+        }
+        base_ = addr;
+        section_.assign(elf.begin() + off, elf.begin() + off + size);
+        section_.push_back('\0');
+        return true;
+    }
+
+    err = "no .log_fmt section (firmware not built with LOG_DEFERRED?)";
+    return false;
+}
+
+std::string DLogTable::format(const uint8_t *payload, size_t len) const
+{
+    char tmp[128];
+
+    if (len < 2) {
+        return "<dlog: short frame>";
+    }
+    uint32_t id = static_cast<uint32_t>(payload[0]) | (static_cast<uint32_t>(payload[1]) << 8);
+    if (id < base_ || id - base_ >= section_.size()) {
+        std::snprintf(tmp, sizeof(tmp), "<dlog: unknown id 0x%04X>", id);
+        return tmp;
+    }
+
+    const char *fmt = section_.data() + (id - base_);
+    const uint8_t *arg = payload + 2;
+    const uint8_t *end = payload + len;
+    std::string out;
+
+    while (*fmt != '\0') {
+        if (*fmt != '%') {
+            out.push_back(*fmt++);
+            continue;
+        }
+        if (fmt[1] == '%') {
+            out.push_back('%');
+            fmt += 2;
+            continue;
+        }
+
+        // 拆出转换说明: 标志、宽度、精度保留，长度修饰符去掉
+        std::string spec = "%";
+        fmt++;
+        while (*fmt != '\0' && std::strchr("-+ #0", *fmt) != nullptr) spec.push_back(*fmt++);
+        while (*fmt >= '0' && *fmt <= '9') spec.push_back(*fmt++);
+        if (*fmt == '.') {
+            spec.push_back(*fmt++);
+            while (*fmt >= '0' && *fmt <= '9') spec.push_back(*fmt++);
+        }
+        while (*fmt != '\0' && std::strchr("hlLqjzt", *fmt) != nullptr) fmt++;
+
+        char conv = *fmt;
+        if (conv == '\0') {
+            break;
+        }
+        fmt++;
+        spec.push_back(conv);
+
+        if (conv == 's') {
+            const uint8_t *z = arg;
+            while (z < end && *z != '\0') z++;
+            std::string s(reinterpret_cast<const char *>(arg), static_cast<size_t>(z - arg));
+            arg = (z < end) ? z + 1 : end;
+            std::snprintf(tmp, sizeof(tmp), spec.c_str(), s.c_str());
+        } else if (end - arg < 4) {
+            out += "<?>";
+            continue;
+        } else if (std::strchr("fFeEgGaA", conv) != nullptr) {
+            float v;
+            std::memcpy(&v, arg, 4);
+            arg += 4;
+            std::snprintf(tmp, sizeof(tmp), spec.c_str(), static_cast<double>(v));
+        } else if (std::strchr("uxXo", conv) != nullptr) {
+            std::snprintf(tmp, sizeof(tmp), spec.c_str(), static_cast<uint32_t>(readI32(arg)));
+            arg += 4;
+        } else if (std::strchr("dic", conv) != nullptr) {
+            std::snprintf(tmp, sizeof(tmp), spec.c_str(), readI32(arg));
+            arg += 4;
+        } else {
+            // 不支持的转换 (如 %p)，按十六进制输出
+            std::snprintf(tmp, sizeof(tmp), "0x%08X", static_cast<uint32_t>(readI32(arg)));
+            arg += 4;
+        }
+        out += tmp;
+    }
+
+    return out;
+}
+
+}  // namespace tlm
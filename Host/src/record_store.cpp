@@ -0,0 +1,335 @@
+/**
+ * @file    record_store.cpp
+ * @brief   传感器记录追加式存储实现
+ */
+#include "record_store.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+
+namespace tlm {
+
+namespace {
+
+constexpr char kColumnMagic[4] = {'T', 'L', 'M', 'C'};
+constexpr uint16_t kColumnVersion = 1;
+constexpr uint32_t kColumnBlockMax = 1u << 20;   // 读取时的块大小上限 (防止损坏文件)
+
+/**
+ * @brief 查找 "key": 后面的数值
+ * @param line 一行 JSON
+ * @param key  带引号和冒号的键，如 "\"temp\":"
+ */
+template <typename T>
+bool jsonNumber(std::string_view line, std::string_view key, T &out)
+{
+    size_t pos = line.find(key);
+    if (pos == std::string_view::npos) {
+        return false;
+    }
+    const char *p = line.data() + pos + key.size();
+    const char *end = line.data() + line.size();
+    while (p < end && *p == ' ') {
+        p++;
+    }
+    auto res = std::from_chars(p, end, out);
+    return res.ec == std::errc();
+}
+
+bool jsonString(std::string_view line, std::string_view key, std::string_view &out)
+{
+    size_t pos = line.find(key);
+    if (pos == std::string_view::npos) {
+        return false;
+    }
+    pos += key.size();
+    size_t end = line.find('"', pos);
+    if (end == std::string_view::npos) {
+        return false;
+    }
+    out = line.substr(pos, end - pos);
+    return true;
+}
+
+bool readAll(std::FILE *f, void *dst, size_t len)
+{
+    return len == 0 || std::fread(dst, 1, len, f) == len;
+}
+
+bool readColumnFile(std::FILE *f, const std::function<void(const Record &)> &cb)
+{
+    std::vector<double> time;
+    std::vector<uint8_t> sensor;
+    std::vector<float> v0;
+    std::vector<float> v1;
+
+    for (;;) {
+        uint32_t hdr[2];
+        if (!readAll(f, hdr, sizeof(hdr))) {
+            return true;   // 文件结束
+        }
+        uint32_t n = hdr[0];
+        if (n == 0 || n > kColumnBlockMax) {
+            return false;
+        }
+        size_t pad = (8 - n % 8) % 8;
+        time.resize(n);
+        sensor.resize(n + pad);
+        v0.resize(n);
+        v1.resize(n);
+        if (!readAll(f, time.data(), n * sizeof(double)) ||
+            !readAll(f, sensor.data(), n + pad) ||
+            !readAll(f, v0.data(), n * sizeof(float)) ||
+            !readAll(f, v1.data(), n * sizeof(float))) {
+            return true;   // 末尾不完整的块 (写入时被中断)
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            Record rec;
+            rec.pc_time_sec = time[i];
+            rec.sensor = static_cast<SensorId>(sensor[i]);
+            rec.v0 = v0[i];
+            rec.v1 = v1[i];
+            cb(rec);
+        }
+    }
+}
+
+}  // namespace
+
+const char *sensorName(SensorId id)
+{
+    switch (id) {
+    case SensorId::WF5803: return "WF5803";
+    case SensorId::NTC:    return "NTC";
+    case SensorId::PID:    return "PID";
+    default:               return "unknown";
+    }
+}
+
+SensorId sensorFromName(std::string_view name)
+{
+    if (name == "NTC") return SensorId::NTC;
+    if (name == "WF5803") return SensorId::WF5803;
+    if (name == "PID") return SensorId::PID;
+    return SensorId::Unknown;
+}
+
+LineKind classifyLine(std::string_view line, Record &rec)
+{
+    if (line.size() < 2 || line.front() != '{' || line.back() != '}') {
+        return LineKind::Text;
+    }
+    if (line.find("\"type\":\"data\"") == std::string_view::npos) {
+        return LineKind::OtherJson;
+    }
+
+    std::string_view name;
+    if (!jsonString(line, "\"sensor\":\"", name)) {
+        return LineKind::OtherJson;
+    }
+
+    bool ok = false;
+    rec.sensor = sensorFromName(name);
+    rec.v1 = 0.0f;
+    switch (rec.sensor) {
+    case SensorId::WF5803:
+        ok = jsonNumber(line, "\"temp\":", rec.v0) && jsonNumber(line, "\"press\":", rec.v1);
+        break;
+    case SensorId::NTC:
+        ok = jsonNumber(line, "\"temp\":", rec.v0);
+        break;
+    case SensorId::PID:
+        ok = jsonNumber(line, "\"output\":", rec.v0);
+        break;
+    default:
+        break;
+    }
+    return ok ? LineKind::Data : LineKind::OtherJson;
+}
+
+/* NdjsonWriter --------------------------------------------------------------*/
+
+NdjsonWriter::~NdjsonWriter()
+{
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+bool NdjsonWriter::open(const std::string &path, std::string &err)
+{
+    file_ = std::fopen(path.c_str(), "ab");
+    if (file_ == nullptr) {
+        err = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool NdjsonWriter::write(const Record &rec)
+{
+    // 在固件原始消息前加 pc_time_sec 字段，读回时可复用 classifyLine
+    int n;
+    switch (rec.sensor) {
+    case SensorId::WF5803:
+        n = std::fprintf(file_, "{\"pc_time_sec\":%.6f,\"type\":\"data\",\"sensor\":\"WF5803\",\"temp\":%.2f,\"press\":%.2f}\n",
+                         rec.pc_time_sec, rec.v0, rec.v1);
+        break;
+    case SensorId::NTC:
+        n = std::fprintf(file_, "{\"pc_time_sec\":%.6f,\"type\":\"data\",\"sensor\":\"NTC\",\"temp\":%.2f}\n",
+                         rec.pc_time_sec, rec.v0);
+        break;
+    case SensorId::PID:
+        n = std::fprintf(file_, "{\"pc_time_sec\":%.6f,\"type\":\"data\",\"sensor\":\"PID\",\"output\":%.2f}\n",
+                         rec.pc_time_sec, rec.v0);
+        break;
+    default:
+        return false;
+    }
+    return n > 0;
+}
+
+bool NdjsonWriter::flush()
+{
+    return std::fflush(file_) == 0;
+}
+
+/* ColumnWriter --------------------------------------------------------------*/
+
+ColumnWriter::~ColumnWriter()
+{
+    if (file_ != nullptr) {
+        writeBlock();
+        std::fclose(file_);
+    }
+}
+
+bool ColumnWriter::open(const std::string &path, std::string &err)
+{
+    file_ = std::fopen(path.c_str(), "ab+");
+    if (file_ == nullptr) {
+        err = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    // 新文件写文件头，已有文件校验文件头后继续追加
+    std::fseek(file_, 0, SEEK_END);
+    if (std::ftell(file_) == 0) {
+        uint16_t ver[2] = {kColumnVersion, 0};
+        std::fwrite(kColumnMagic, 1, sizeof(kColumnMagic), file_);
+        std::fwrite(ver, 1, sizeof(ver), file_);
+    } else {
+        char magic[4] = {};
+        std::rewind(file_);
+        if (std::fread(magic, 1, sizeof(magic), file_) != sizeof(magic) ||
+            std::memcmp(magic, kColumnMagic, sizeof(magic)) != 0) {
+            err = path + ": not a column record file";
+            std::fclose(file_);
+            file_ = nullptr;
+            return false;
+        }
+        std::fseek(file_, 0, SEEK_END);
+    }
+
+    time_.reserve(kBlockRecords);
+    sensor_.reserve(kBlockRecords + 8);
+    v0_.reserve(kBlockRecords);
+    v1_.reserve(kBlockRecords);
+    return true;
+}
+
+bool ColumnWriter::write(const Record &rec)
+{
+    time_.push_back(rec.pc_time_sec);
+    sensor_.push_back(static_cast<uint8_t>(rec.sensor));
+    v0_.push_back(rec.v0);
+    v1_.push_back(rec.v1);
+    return time_.size() < kBlockRecords || writeBlock();
+}
+
+bool ColumnWriter::flush()
+{
+    return writeBlock() && std::fflush(file_) == 0;
+}
+
+bool ColumnWriter::writeBlock()
+{
+    uint32_t n = static_cast<uint32_t>(time_.size());
+    if (n == 0) {
+        return true;
+    }
+
+    uint32_t hdr[2] = {n, 0};
+    size_t pad = (8 - n % 8) % 8;
+    sensor_.resize(n + pad, 0);
+
+    bool ok = std::fwrite(hdr, sizeof(hdr), 1, file_) == 1 &&
+              std::fwrite(time_.data(), sizeof(double), n, file_) == n &&
+              std::fwrite(sensor_.data(), 1, n + pad, file_) == n + pad &&
+              std::fwrite(v0_.data(), sizeof(float), n, file_) == n &&
+              std::fwrite(v1_.data(), sizeof(float), n, file_) == n;
+
+    time_.clear();
+    sensor_.clear();
+    v0_.clear();
+    v1_.clear();
+    return ok;
+}
+
+/* 读取 / 导出 ----------------------------------------------------------------*/
+
+bool readRecords(const std::string &path, const std::function<void(const Record &)> &cb,
+                 std::string &err)
+{
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        err = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    char magic[8] = {};
+    size_t got = std::fread(magic, 1, sizeof(magic), f);
+    if (got == sizeof(magic) && std::memcmp(magic, kColumnMagic, sizeof(kColumnMagic)) == 0) {
+        bool ok = readColumnFile(f, cb);
+        std::fclose(f);
+        if (!ok) {
+            err = path + ": corrupt column block";
+        }
+        return ok;
+    }
+    std::fclose(f);
+
+    // NDJSON
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        Record rec;
+        if (classifyLine(line, rec) == LineKind::Data &&
+            jsonNumber(std::string_view(line), "\"pc_time_sec\":", rec.pc_time_sec)) {
+            cb(rec);
+        }
+    }
+    return true;
+}
+
+std::string isoTimestamp(double pc_time_sec)
+{
+    std::time_t sec = static_cast<std::time_t>(pc_time_sec);
+    long usec = static_cast<long>((pc_time_sec - static_cast<double>(sec)) * 1e6 + 0.5);
+    if (usec >= 1000000) {
+        sec++;
+        usec -= 1000000;
+    }
+
+    std::tm tm{};
+    localtime_r(&sec, &tm);
+    char buf[40];
+    size_t n = std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
+    std::snprintf(buf + n, sizeof(buf) - n, ".%06ld", usec);
+    return buf;
+}
+
+}  // namespace tlm
@@ -0,0 +1,283 @@
+/**
+ * @file    tlm_decoder.cpp
+ * @brief   STM32 串口数据流解码实现
+ */
+#include "tlm_decoder.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace tlm {
+
+namespace {
+
+// 已定义的帧类型 (候选帧合理性检查用)
+bool knownFrameType(uint8_t type)
+{
+    return type == TLM_FRAME_TYPE_SAMPLE || type == TLM_FRAME_TYPE_LOG ||
+           type == TLM_FRAME_TYPE_PROBE || type == TLM_FRAME_TYPE_THERMAL;
+}
+
+bool supportedVersion(uint8_t version)
+{
+    return version >= TLM_FRAME_VERSION_MIN && version <= TLM_FRAME_VERSION;
+}
+
+// 各版本的采样记录长度
+size_t sampleSize(uint8_t version)
+{
+    switch (version) {
+    case 1:  return TLM_SAMPLE_SIZE_V1;
+    case 2:  return TLM_SAMPLE_SIZE_V2;
+    default: return sizeof(TlmSample_t);
+    }
+}
+
+}  // namespace
+
+void StreamDecoder::feed(const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+
+    while (i < len) {
+        if (!in_frame_) {
+            // 文本状态: 整段拷贝到下一个换行或分隔符，边界字节交给逐字节状态机
+            size_t n = findLineOrDelimiter(data + i, len - i);
+            appendText(data + i, n);
+            i += n;
+            if (i == len) {
+                break;
+            }
+        }
+        feed(data[i++]);
+    }
+}
+
+void StreamDecoder::feed(uint8_t byte)
+{
+    if (byte == TLM_FRAME_DELIMITER) {
+        if (!in_frame_) {
+            // 帧起始分隔符
+            finishText();
+            in_frame_ = true;
+            frame_.clear();
+        } else if (!frame_.empty()) {
+            // 帧结束分隔符。解析失败时多半是把上一帧的结束分隔符当成了起始 (从帧中间开始接收)，
+            // 候选内容实为文本: 按文本重放，这个 0x00 作为下一帧的起始
+            if (finishFrame()) {
+                in_frame_ = false;
+            } else {
+                replayFrameAsText();
+                finishText();
+            }
+        }
+        // 连续的 0x00 视为同一个分隔符
+        return;
+    }
+
+    if (in_frame_) {
+        frame_.push_back(byte);
+        if (byte == '\n' && !frameHeaderPlausible()) {
+            // 帧内可以有 0x0A，但开头不是合法帧头时这是一行文本
+            replayFrameAsText();
+            in_frame_ = false;
+        } else if (frame_.size() > TLM_COBS_MAX(TLM_FRAME_RAW_MAX)) {
+            // 超长，说明丢失了结束分隔符，回到文本状态
+            stats_.frames_bad++;
+            replayFrameAsText();
+            in_frame_ = false;
+        }
+        return;
+    }
+
+    if (byte == '\n') {
+        finishText();
+    } else if (byte != '\r') {
+        text_.push_back(static_cast<char>(byte));
+    }
+}
+
+bool StreamDecoder::finishFrame()
+{
+    TlmFrameHeader_t header;
+    uint8_t payload[TLM_FRAME_RAW_MAX];
+    int n = TlmFrame_Parse(frame_.data(), frame_.size(), &header, payload);
+
+    if (n < 0) {
+        stats_.frames_bad++;
+        return false;
+    }
+    frame_.clear();
+    if (!supportedVersion(header.version)) {
+        stats_.frames_unknown++;
+        return true;
+    }
+    if (header.type == TLM_FRAME_TYPE_SAMPLE && n != static_cast<int>(sampleSize(header.version))) {
+        // CRC 正确但长度与帧头版本不符: 固件与上位机的格式定义不一致
+        stats_.frames_bad++;
+        return true;
+    }
+    stats_.frames_ok++;
+    if (header.version != TLM_FRAME_VERSION) {
+        stats_.frames_old++;
+    }
+
+    // 序号按帧类型分别递增
+    if (have_seq_[header.type] && static_cast<uint16_t>(last_seq_[header.type] + 1) != header.seq) {
+        stats_.seq_gaps++;
+    }
+    have_seq_[header.type] = true;
+    last_seq_[header.type] = header.seq;
+
+    if (header.type == TLM_FRAME_TYPE_SAMPLE) {
+        if (sample_handler_) {
+            // 旧版本的记录是 TlmSample_t 的前缀，其余字段保持 0
+            Sample s;
+            s.seq = header.seq;
+            s.device_ms = header.timestamp_ms;
+            s.version = header.version;
+            std::memcpy(&s.data, payload, static_cast<size_t>(n));
+            sample_handler_(s);
+        }
+    } else if (frame_handler_) {
+        frame_handler_(header, payload, static_cast<size_t>(n));
+    } else {
+        stats_.frames_unknown++;
+    }
+    return true;
+}
+
+bool StreamDecoder::frameHeaderPlausible() const
+{
+    // COBS 第一个码字 c 之后是帧类型、版本: c = 1 时帧类型为 0，c = 2 时版本为 0，都不合法。
+    // 只检查已收到的字节，帧头没收全的留给 CRC 判断
+    size_t n = frame_.size();
+    uint8_t code = frame_[0];
+    if (n >= 2 && (code < 2 || !knownFrameType(frame_[1]))) {
+        return false;
+    }
+    if (n >= 3 && (code < 3 || !supportedVersion(frame_[2]))) {
+        return false;
+    }
+    return true;
+}
+
+void StreamDecoder::replayFrameAsText()
+{
+    for (uint8_t byte : frame_) {
+        if (byte == '\n') {
+            finishText();
+        } else if (byte != '\r') {
+            text_.push_back(static_cast<char>(byte));
+        }
+    }
+    frame_.clear();
+}
+
+void StreamDecoder::appendText(const uint8_t *data, size_t len)
+{
+    const char *p = reinterpret_cast<const char *>(data);
+    const char *end = p + len;
+
+    // 与逐字节路径一致，丢弃 '\r'
+    while (p < end) {
+        const char *cr = static_cast<const char *>(std::memchr(p, '\r', static_cast<size_t>(end - p)));
+        const char *stop = (cr != nullptr) ? cr : end;
+        text_.append(p, static_cast<size_t>(stop - p));
+        p = (cr != nullptr) ? cr + 1 : end;
+    }
+}
+
+void StreamDecoder::finishText()
+{
+    if (text_.empty()) {
+        return;
+    }
+    stats_.text_lines++;
+    if (text_handler_) {
+        text_handler_(text_);
+    }
+    text_.clear();
+}
+
+size_t findLineOrDelimiter(const uint8_t *data, size_t len)
+{
+    constexpr uint64_t kOnes = 0x0101010101010101ULL;
+    constexpr uint64_t kHigh = 0x8080808080808080ULL;
+    constexpr uint64_t kNewline = kOnes * '\n';
+    size_t i = 0;
+
+    // 含 0x00 的字节: (v - 0x01..) & ~v & 0x80..；'\n' 先异或成 0x00 再判断
+    for (; i + 8 <= len; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, data + i, sizeof(v));
+        uint64_t nl = v ^ kNewline;
+        uint64_t hit = ((v - kOnes) & ~v) | ((nl - kOnes) & ~nl);
+        if ((hit & kHigh) != 0) {
+            break;
+        }
+    }
+    for (; i < len; i++) {
+        if (data[i] == '\n' || data[i] == TLM_FRAME_DELIMITER) {
+            return i;
+        }
+    }
+    return len;
+}
+
+uint64_t cyclesToUs(uint64_t cycles)
+{
+    return cycles / (TLM_CPU_HZ / 1000000U);
+}
+
+std::string sampleToJsonLines(const TlmSample_t &s, uint8_t version)
+{
+    char buf[384];
+    int n;
+
+    if (version < TLM_SAMPLE_VERSION_CYCLES) {
+        // 旧固件没有周期计数字段，与其 JSON 模式输出一致
+        n = std::snprintf(buf, sizeof(buf),
+                          "{\"type\":\"data\",\"sensor\":\"WF5803\",\"temp\":%.2f,\"press\":%.2f}\n"
+                          "{\"type\":\"data\",\"sensor\":\"NTC\",\"temp\":%.2f}\n"
+                          "{\"type\":\"data\",\"sensor\":\"PID\",\"output\":%.2f}\n",
+                          s.wf_temp, s.wf_press, s.ntc_temp, s.pid_output);
+    } else {
+        n = std::snprintf(buf, sizeof(buf),
+                          "{\"type\":\"data\",\"sensor\":\"WF5803\",\"temp\":%.2f,\"press\":%.2f,\"lat_us\":%lu}\n"
+                          "{\"type\":\"data\",\"sensor\":\"NTC\",\"temp\":%.2f,\"t_us\":%lu,\"age_us\":%lu}\n"
+                          "{\"type\":\"data\",\"sensor\":\"PID\",\"output\":%.2f,\"lat_us\":%lu}\n",
+                          s.wf_temp, s.wf_press, static_cast<unsigned long>(cyclesToUs(s.wf_cycles)),
+                          s.ntc_temp, static_cast<unsigned long>(static_cast<uint32_t>(cyclesToUs(s.t_cycles))),
+                          static_cast<unsigned long>(cyclesToUs(s.age_cycles)),
+                          s.pid_output, static_cast<unsigned long>(cyclesToUs(s.ctl_cycles)));
+    }
+    std::string out(buf, n > 0 ? static_cast<size_t>(n) : 0);
+    if (s.fault != 0) {
+        n = std::snprintf(buf, sizeof(buf), "{\"type\":\"fault\",\"mask\":%lu}\n",
+                          static_cast<unsigned long>(s.fault));
+        out.append(buf, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+    return out;
+}
+
+std::string thermalToJsonLines(const TlmThermal_t &t)
+{
+    std::string out;
+    char buf[128];
+
+    for (unsigned i = 1; i < TLM_THERMAL_CHANNELS; i++) {
+        if ((t.mask & (1U << i)) == 0) {
+            continue;
+        }
+        int n = std::snprintf(buf, sizeof(buf),
+                              "{\"type\":\"data\",\"sensor\":\"ZONE\",\"ch\":%u,\"temp\":%.2f,\"sp\":%.2f,\"output\":%.2f}\n",
+                              i + 1, t.ch[i].temp, t.ch[i].setpoint, t.ch[i].output);
+        if (n > 0) {
+            out.append(buf, static_cast<size_t>(n));
+        }
+    }
+    return out;
+}
+
+}  // namespace tlm
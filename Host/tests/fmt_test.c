@@ -0,0 +1,130 @@
+/**
+ * @file    fmt_test.c
+ * @brief   Core/Src/fmt.c 主机测试：Fmt_Snprintf 与 libc snprintf 逐字符比较。
+ *
+ * - %f: 构造的舍入边界值 (k / 2^n，恰为一半的情况) 和随机 float，精度 0 ~ 9
+ * - 宽度、标志、整数/字符串转换和截断
+ * 参数都先转换为 float，再以 double 传给两边，比较的是同一个 float 值的输出。
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fmt.h"
+
+#define FLOAT_MAX_TESTED    1.0e19f     // Fmt 的整数部分为 uint64
+#define RANDOM_CASES        1000000
+
+static unsigned long mismatches;
+static unsigned long cases;
+
+static uint32_t rng_state = 0x12345678U;
+
+static uint32_t rng(void)
+{
+    // xorshift32
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void check_float(const char *format, int prec, float v)
+{
+    char a[64];
+    char b[64];
+    int na = Fmt_Snprintf(a, sizeof(a), format, prec, (double)v);
+    int nb = snprintf(b, sizeof(b), format, prec, (double)v);
+
+    cases++;
+    if (na != nb || strcmp(a, b) != 0) {
+        if (mismatches++ < 20) {
+            fprintf(stderr, "mismatch: \"%s\" prec %d value %.9g: fmt \"%s\" libc \"%s\"\n",
+                    format, prec, (double)v, a, b);
+        }
+    }
+}
+
+static void test_float_ties(void)
+{
+    // k / 2^n 在 n <= prec 时可以精确表示，n = prec + 1 时末位恰为一半
+    for (int n = 1; n <= 12; n++) {
+        for (uint32_t k = 0; k < 4096; k++) {
+            float v = (float)k / (float)(1U << n);
+            for (int prec = 0; prec <= 9; prec++) {
+                check_float("%.*f", prec, v);
+                check_float("%.*f", prec, -v);
+                check_float("%.*f", prec, v + 1000.0f);
+            }
+        }
+    }
+}
+
+static void test_float_random(void)
+{
+    for (int i = 0; i < RANDOM_CASES; i++) {
+        uint32_t bits = rng();
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        if (v != v || v > FLOAT_MAX_TESTED || v < -FLOAT_MAX_TESTED) {
+            continue;
+        }
+        check_float("%.*f", (int)(rng() % 10U), v);
+
+        // 传感器量程附近的值
+        v = (float)((int32_t)rng() % 2000000) / 1024.0f;
+        check_float("%.*f", (int)(rng() % 10U), v);
+    }
+}
+
+static void check_misc(const char *expect_format, const char *got, const char *want)
+{
+    cases++;
+    if (strcmp(got, want) != 0) {
+        mismatches++;
+        fprintf(stderr, "mismatch: \"%s\": fmt \"%s\" libc \"%s\"\n", expect_format, got, want);
+    }
+}
+
+#define CHECK_FORMAT(...)                                           \
+    do {                                                            \
+        char a_[96];                                                \
+        char b_[96];                                                \
+        Fmt_Snprintf(a_, sizeof(a_), __VA_ARGS__);                  \
+        snprintf(b_, sizeof(b_), __VA_ARGS__);                      \
+        check_misc(#__VA_ARGS__, a_, b_);                           \
+    } while (0)
+
+static void test_misc(void)
+{
+    char buf[8];
+    int n;
+
+    CHECK_FORMAT("%d %i %u", -12345, 0, 4000000000U);
+    CHECK_FORMAT("%x %X %o", 0xBEEFU, 0xBEEFU, 0755U);
+    CHECK_FORMAT("%lld %llu", -9000000000000000000LL, 18000000000000000000ULL);
+    CHECK_FORMAT("[%5d] [%-5d] [%05d] [%+d] [% d]", 42, 42, -42, 42, 42);
+    CHECK_FORMAT("[%8.3f] [%-8.2f] [%08.2f] [%+.1f] [% .0f]", 3.14159, -2.5, -2.5, 0.05, 2.5);
+    CHECK_FORMAT("[%s] [%.3s] [%8s] [%-8s] [%c]", "abc", "abcdef", "x", "y", 'z');
+    CHECK_FORMAT("%.2f %.2f %.2f", 1.0 / 0.0, -1.0 / 0.0, 0.0 / 0.0);
+    CHECK_FORMAT("%*d %.*f %%", 6, 7, 3, 1.0625);
+
+    // 截断时返回完整长度，输出以 '\0' 结尾
+    n = Fmt_Snprintf(buf, sizeof(buf), "%s=%d", "temperature", 25);
+    cases++;
+    if (n != 14 || strcmp(buf, "tempera") != 0) {
+        mismatches++;
+        fprintf(stderr, "truncation: n %d buf \"%s\"\n", n, buf);
+    }
+}
+
+int main(void)
+{
+    test_float_ties();
+    test_float_random();
+    test_misc();
+
+    printf("fmt_test: %lu cases, %lu mismatches\n", cases, mismatches);
+    return (mismatches == 0) ? 0 : 1;
+}
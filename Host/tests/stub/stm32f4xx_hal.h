@@ -0,0 +1,49 @@
+/**
+ * @file    stm32f4xx_hal.h
+ * @brief   主机测试用的 HAL 替身：只声明被测固件模块 (uart_tx.c) 用到的类型和函数，
+ *          字段名与 STM32F4 HAL 一致，函数由各测试程序实现。
+ */
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_DMA_ERROR_NONE  0x00000000U
+#define HAL_DMA_ERROR_TE    0x00000001U
+
+typedef struct {
+    volatile uint32_t ErrorCode;
+} DMA_HandleTypeDef;
+
+typedef enum {
+    HAL_UART_STATE_READY = 0x20U,
+    HAL_UART_STATE_BUSY_TX = 0x21U
+} HAL_UART_StateTypeDef;
+
+typedef struct {
+    const uint8_t *pTxBuffPtr;
+    uint16_t TxXferSize;
+    DMA_HandleTypeDef *hdmatx;
+    volatile HAL_UART_StateTypeDef gState;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
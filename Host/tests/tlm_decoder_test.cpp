@@ -0,0 +1,223 @@
+/**
+ * @file    tlm_decoder_test.cpp
+ * @brief   tlm::StreamDecoder 主机测试：文本与二进制帧混合流的解码和重新同步。
+ *
+ * - 同步接收: 文本行和帧交替，逐个还原
+ * - 从帧中间开始接收: 上一帧的结束分隔符被当成起始，之后的文本行遇到 '\n' 即按文本输出，
+ *   下一帧正常解出
+ * - 候选帧 CRC 失败: 按文本重放，结束它的 0x00 作为下一帧的起始
+ * - 负载中含 0x0A 的合法帧不被当成文本
+ * - 旧版本固件的采样记录按帧头版本的长度解出 (缺少的字段为 0)，长度与版本不符或版本过新的
+ *   帧计为错误/未知，不当作采样
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "tlm_decoder.hpp"
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                       \
+        }                                                                       \
+    } while (0)
+
+namespace {
+
+struct Capture {
+    std::vector<std::string> text;
+    std::vector<tlm::Sample> samples;
+};
+
+void attach(tlm::StreamDecoder &decoder, Capture &cap)
+{
+    decoder.onText([&cap](const std::string &line) { cap.text.push_back(line); });
+    decoder.onSample([&cap](const tlm::Sample &s) { cap.samples.push_back(s); });
+}
+
+void appendText(std::vector<uint8_t> &stream, const char *text)
+{
+    stream.insert(stream.end(), text, text + std::strlen(text));
+}
+
+std::vector<uint8_t> sampleFrame(uint16_t seq, float ntc_temp)
+{
+    TlmSample_t s;
+    std::memset(&s, 0, sizeof(s));
+    s.ntc_temp = ntc_temp;
+    uint8_t wire[TLM_FRAME_WIRE_MAX];
+    size_t n = TlmFrame_Build(TLM_FRAME_TYPE_SAMPLE, seq, 1000U + seq, &s, sizeof(s), wire);
+    CHECK(n > 0);
+    return std::vector<uint8_t>(wire, wire + n);
+}
+
+// 帧头版本为 version、负载为 payload 的采样帧 (模拟旧版本固件)
+std::vector<uint8_t> versionedFrame(uint8_t version, uint16_t seq, const void *payload, size_t len)
+{
+    uint8_t raw[TLM_FRAME_RAW_MAX];
+    TlmFrameHeader_t h = { TLM_FRAME_TYPE_SAMPLE, version, seq, 0 };
+    std::memcpy(raw, &h, sizeof(h));
+    std::memcpy(raw + sizeof(h), payload, len);
+    size_t n = sizeof(h) + len;
+    uint16_t crc = TlmFrame_Crc16(0xFFFF, raw, n);
+    raw[n++] = static_cast<uint8_t>(crc & 0xFF);
+    raw[n++] = static_cast<uint8_t>(crc >> 8);
+
+    std::vector<uint8_t> wire(TLM_COBS_MAX(n) + 2);
+    wire[0] = TLM_FRAME_DELIMITER;
+    size_t m = TlmFrame_CobsEncode(raw, n, &wire[1]);
+    wire[1 + m] = TLM_FRAME_DELIMITER;
+    wire.resize(m + 2);
+    return wire;
+}
+
+void appendFrame(std::vector<uint8_t> &stream, const std::vector<uint8_t> &frame)
+{
+    stream.insert(stream.end(), frame.begin(), frame.end());
+}
+
+void testSynced()
+{
+    std::vector<uint8_t> stream;
+    appendText(stream, "hello\r\n");
+    appendFrame(stream, sampleFrame(1, 25.5f));
+    appendText(stream, "world\n");
+    appendFrame(stream, sampleFrame(2, 26.5f));
+
+    for (int bulk = 0; bulk < 2; bulk++) {
+        tlm::StreamDecoder decoder;
+        Capture cap;
+        attach(decoder, cap);
+        if (bulk) {
+            decoder.feed(stream.data(), stream.size());
+        } else {
+            for (uint8_t b : stream) decoder.feed(b);
+        }
+        CHECK(cap.text.size() == 2 && cap.text[0] == "hello" && cap.text[1] == "world");
+        CHECK(cap.samples.size() == 2);
+        CHECK(cap.samples[0].seq == 1 && cap.samples[0].data.ntc_temp == 25.5f);
+        CHECK(cap.samples[1].seq == 2 && cap.samples[1].data.ntc_temp == 26.5f);
+        CHECK(decoder.stats().frames_ok == 2 && decoder.stats().frames_bad == 0);
+    }
+}
+
+void testStartMidFrame()
+{
+    std::vector<uint8_t> first = sampleFrame(7, 30.0f);
+    std::vector<uint8_t> stream(first.begin() + static_cast<long>(first.size() / 2), first.end());
+    appendText(stream, "line one\n");
+    appendFrame(stream, sampleFrame(8, 31.0f));
+    appendText(stream, "tail\n");
+
+    for (int bulk = 0; bulk < 2; bulk++) {
+        tlm::StreamDecoder decoder;
+        Capture cap;
+        attach(decoder, cap);
+        if (bulk) {
+            decoder.feed(stream.data(), stream.size());
+        } else {
+            for (uint8_t b : stream) decoder.feed(b);
+        }
+        // 第一帧的后半段作为一行乱码输出，之后的文本和帧都正常
+        CHECK(cap.text.size() == 3);
+        CHECK(cap.text[1] == "line one" && cap.text[2] == "tail");
+        CHECK(cap.samples.size() == 1 && cap.samples[0].seq == 8);
+    }
+}
+
+void testCrcFailureResync()
+{
+    std::vector<uint8_t> first = sampleFrame(3, 20.0f);
+    std::vector<uint8_t> stream(first.begin() + 3, first.end());
+    appendText(stream, "no newline");
+    appendFrame(stream, sampleFrame(4, 21.0f));
+    appendFrame(stream, sampleFrame(5, 22.0f));
+
+    tlm::StreamDecoder decoder;
+    Capture cap;
+    attach(decoder, cap);
+    decoder.feed(stream.data(), stream.size());
+
+    CHECK(cap.text.size() == 2 && cap.text[1] == "no newline");
+    CHECK(cap.samples.size() == 2 && cap.samples[0].seq == 4 && cap.samples[1].seq == 5);
+    CHECK(decoder.stats().frames_bad == 1);
+}
+
+void testNewlineInsideFrame()
+{
+    TlmSample_t s;
+    std::memset(&s, '\n', sizeof(s));
+    uint8_t wire[TLM_FRAME_WIRE_MAX];
+    size_t n = TlmFrame_Build(TLM_FRAME_TYPE_SAMPLE, 9, 0, &s, sizeof(s), wire);
+    CHECK(n > 0 && std::memchr(wire + 4, '\n', n - 4) != nullptr);
+
+    tlm::StreamDecoder decoder;
+    Capture cap;
+    attach(decoder, cap);
+    for (size_t i = 0; i < n; i++) decoder.feed(wire[i]);
+
+    CHECK(cap.text.empty());
+    CHECK(cap.samples.size() == 1 && std::memcmp(&cap.samples[0].data, &s, sizeof(s)) == 0);
+}
+
+void testOldVersions()
+{
+    TlmSample_t s;
+    std::memset(&s, 0x5A, sizeof(s));
+    s.wf_temp = 21.0f;
+    s.ntc_temp = 23.0f;
+    s.pid_output = 400.0f;
+
+    std::vector<uint8_t> stream;
+    appendFrame(stream, versionedFrame(1, 1, &s, TLM_SAMPLE_SIZE_V1));
+    appendFrame(stream, versionedFrame(1, 2, &s, sizeof(s)));           // 长度与版本不符
+    appendFrame(stream, versionedFrame(2, 3, &s, TLM_SAMPLE_SIZE_V2));
+    appendFrame(stream, versionedFrame(2, 4, &s, TLM_SAMPLE_SIZE_V1));  // 长度与版本不符
+    appendFrame(stream, versionedFrame(TLM_FRAME_VERSION + 1, 5, &s, sizeof(s)));
+    appendFrame(stream, versionedFrame(TLM_FRAME_VERSION, 6, &s, sizeof(s)));
+
+    tlm::StreamDecoder decoder;
+    Capture cap;
+    std::vector<uint8_t> versions;
+    attach(decoder, cap);
+    decoder.onSample([&](const tlm::Sample &x) {
+        cap.samples.push_back(x);
+        versions.push_back(x.version);
+    });
+    for (uint8_t b : stream) decoder.feed(b);
+
+    CHECK(cap.text.empty());
+    CHECK(cap.samples.size() == 3);
+    CHECK(versions[0] == 1 && cap.samples[0].seq == 1);
+    CHECK(std::memcmp(&cap.samples[0].data, &s, TLM_SAMPLE_SIZE_V1) == 0);
+    CHECK(cap.samples[0].data.fault == 0 && cap.samples[0].data.t_cycles == 0);
+    CHECK(versions[1] == 2 && cap.samples[1].seq == 3);
+    CHECK(std::memcmp(&cap.samples[1].data, &s, TLM_SAMPLE_SIZE_V2) == 0);
+    CHECK(cap.samples[1].data.fault == s.fault && cap.samples[1].data.t_cycles == 0);
+    CHECK(versions[2] == TLM_FRAME_VERSION && std::memcmp(&cap.samples[2].data, &s, sizeof(s)) == 0);
+    CHECK(decoder.stats().frames_ok == 3 && decoder.stats().frames_old == 2);
+    CHECK(decoder.stats().frames_bad == 2 && decoder.stats().frames_unknown == 1);
+
+    // 旧版本的 JSON 不含时间字段
+    std::string old_json = tlm::sampleToJsonLines(cap.samples[1].data, versions[1]);
+    std::string new_json = tlm::sampleToJsonLines(cap.samples[2].data, versions[2]);
+    CHECK(old_json.find("\"fault\"") != std::string::npos && old_json.find("_us") == std::string::npos);
+    CHECK(new_json.find("\"t_us\"") != std::string::npos);
+}
+
+}  // namespace
+
+int main()
+{
+    testSynced();
+    testStartMidFrame();
+    testCrcFailureResync();
+    testNewlineInsideFrame();
+    testOldVersions();
+    std::printf("tlm_decoder_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file    uart_tx_test.c
+ * @brief   Core/Src/uart_tx.c 主机测试：HAL 替身 (tests/stub/stm32f4xx_hal.h) 模拟 DMA 发送，
+ *          "DMA" 由测试代码或单独线程完成。
+ *
+ * - DMA 停止不动时生产者照常返回，缓冲区满后整条丢弃并计数 (写入从不等待 DMA)
+ * - 跨越缓冲区末尾的数据分段发送，输出与写入顺序一致
+ * - DMA 发送错误丢弃当前一段并续发，接收错误 (发送 DMA 无错误) 不影响发送
+ * - 暂停后不再启动 DMA，中止的一段计入丢弃，恢复后续发暂停期间写入的数据
+ * - 多个生产者线程与 DMA 完成线程并发: 每条消息完整、同一生产者内有序，
+ *   发送 + 丢弃 = 写入
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "uart_tx.h"
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                            \
+        }                                                                       \
+    } while (0)
+
+#define MT_PRODUCERS    4
+#define MT_MESSAGES     20000
+#define MT_MSG_LEN      12          // "P<id>:<seq>\n"，seq 为 8 位十进制
+#define OUT_SIZE        (MT_PRODUCERS * MT_MESSAGES * MT_MSG_LEN)
+
+static UART_HandleTypeDef huart;
+static DMA_HandleTypeDef hdma_tx;
+static atomic_int dma_pending;      // 已启动、尚未完成的 DMA 传输
+static uint8_t out[OUT_SIZE];       // 已由 "DMA" 发出的数据
+static size_t out_len;
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *h, const uint8_t *pData, uint16_t Size)
+{
+    if (h->gState != HAL_UART_STATE_READY) return HAL_BUSY;
+    h->pTxBuffPtr = pData;
+    h->TxXferSize = Size;
+    h->hdmatx->ErrorCode = HAL_DMA_ERROR_NONE;
+    h->gState = HAL_UART_STATE_BUSY_TX;
+    atomic_store(&dma_pending, 1);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *h)
+{
+    atomic_store(&dma_pending, 0);
+    h->gState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+/* 完成当前 DMA 传输 (相当于发送完成中断)，返回 0 表示没有进行中的传输 */
+static int dma_complete(UartTx_t *tx)
+{
+    if (!atomic_load(&dma_pending)) return 0;
+    CHECK(out_len + huart.TxXferSize <= sizeof(out));
+    memcpy(&out[out_len], huart.pTxBuffPtr, huart.TxXferSize);
+    out_len += huart.TxXferSize;
+    atomic_store(&dma_pending, 0);
+    huart.gState = HAL_UART_STATE_READY;
+    UartTx_TxCpltHandler(tx);
+    return 1;
+}
+
+/* 当前 DMA 传输出错 (HAL 中止发送后调用错误回调) */
+static void dma_fail(UartTx_t *tx)
+{
+    CHECK(atomic_load(&dma_pending));
+    atomic_store(&dma_pending, 0);
+    hdma_tx.ErrorCode = HAL_DMA_ERROR_TE;
+    huart.gState = HAL_UART_STATE_READY;
+    UartTx_ErrorHandler(tx);
+}
+
+static void drain(UartTx_t *tx)
+{
+    while (dma_complete(tx)) {
+    }
+}
+
+static void setup(UartTx_t *tx, uint8_t *buf, uint32_t size)
+{
+    memset(&huart, 0, sizeof(huart));
+    memset(&hdma_tx, 0, sizeof(hdma_tx));
+    huart.hdmatx = &hdma_tx;
+    huart.gState = HAL_UART_STATE_READY;
+    atomic_store(&dma_pending, 0);
+    out_len = 0;
+    UartTx_Init(tx, &huart, buf, size);
+}
+
+static void test_stalled_dma(void)
+{
+    static uint8_t buf[64];
+    UartTx_t tx;
+    UartTx_Stats_t st;
+    uint8_t msg[10];
+    uint32_t accepted = 0;
+
+    setup(&tx, buf, sizeof(buf));
+    for (int i = 0; i < 20; i++) {
+        memset(msg, 'a' + i, sizeof(msg));
+        if (UartTx_Write(&tx, msg, sizeof(msg)) == sizeof(msg)) {
+            accepted++;
+        }
+    }
+    UartTx_GetStats(&tx, &st);
+    CHECK(accepted == 6);                   // 64 字节放得下 6 条，DMA 未完成时不释放空间
+    CHECK(st.overflow_count == 14);
+    CHECK(st.dropped_bytes == 14 * sizeof(msg));
+    CHECK(st.high_water == 60);
+    CHECK(!UartTx_IsIdle(&tx));
+
+    drain(&tx);
+    CHECK(out_len == 60);
+    for (size_t i = 0; i < out_len; i++) {
+        CHECK(out[i] == 'a' + i / 10);
+    }
+    CHECK(UartTx_IsIdle(&tx));
+    UartTx_GetStats(&tx, &st);
+    CHECK(st.sent_bytes == 60);
+}
+
+static void test_wrap_order(void)
+{
+    static uint8_t buf[64];
+    static uint8_t expect[4096];
+    UartTx_t tx;
+    uint8_t msg[24];
+    size_t n = 0;
+
+    setup(&tx, buf, sizeof(buf));
+    for (int i = 0; i < 150; i++) {
+        uint32_t len = 1 + (uint32_t)(i * 7) % sizeof(msg);
+        for (uint32_t k = 0; k < len; k++) {
+            msg[k] = (uint8_t)(i + k);
+        }
+        if (UartTx_Write(&tx, msg, len) == len) {
+            memcpy(&expect[n], msg, len);
+            n += len;
+        }
+        if (i % 3 == 2) {
+            dma_complete(&tx);
+        }
+    }
+    drain(&tx);
+    CHECK(out_len == n);
+    CHECK(memcmp(out, expect, n) == 0);
+    CHECK(UartTx_IsIdle(&tx));
+}
+
+static void test_dma_error(void)
+{
+    static uint8_t buf[64];
+    UartTx_t tx;
+    UartTx_Stats_t st;
+
+    setup(&tx, buf, sizeof(buf));
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"AAAAAAAAAA", 10) == 10);
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"BBBBBBBBBB", 10) == 10);
+    CHECK(atomic_load(&dma_pending) && huart.TxXferSize == 10);
+
+    // 接收错误: 发送 DMA 无错误，发送继续
+    UartTx_ErrorHandler(&tx);
+    UartTx_GetStats(&tx, &st);
+    CHECK(st.error_count == 0);
+    CHECK(atomic_load(&dma_pending) && huart.pTxBuffPtr == &buf[0]);
+
+    // 发送 DMA 错误: 丢弃 A，立即续发 B
+    dma_fail(&tx);
+    UartTx_GetStats(&tx, &st);
+    CHECK(st.error_count == 1);
+    CHECK(st.dropped_bytes == 10);
+    CHECK(atomic_load(&dma_pending) && huart.pTxBuffPtr == &buf[10]);
+
+    drain(&tx);
+    CHECK(out_len == 10 && memcmp(out, "BBBBBBBBBB", 10) == 0);
+    CHECK(UartTx_IsIdle(&tx));
+
+    // 错误后缓冲区继续可用
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"CC", 2) == 2);
+    drain(&tx);
+    CHECK(out_len == 12 && memcmp(&out[10], "CC", 2) == 0);
+}
+
+static void test_pause(void)
+{
+    static uint8_t buf[64];
+    UartTx_t tx;
+    UartTx_Stats_t st;
+
+    setup(&tx, buf, sizeof(buf));
+
+    // 有一段正在发送时不能立即暂停，发完后不再续发
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"AAAA", 4) == 4);
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"BBBB", 4) == 4);
+    CHECK(UartTx_Pause(&tx) == 0);
+    CHECK(dma_complete(&tx));
+    CHECK(!atomic_load(&dma_pending));
+    CHECK(UartTx_Pause(&tx) == 1);
+
+    // 暂停期间写入只进缓冲区
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"CCCC", 4) == 4);
+    CHECK(!atomic_load(&dma_pending));
+
+    UartTx_Resume(&tx);
+    drain(&tx);
+    CHECK(out_len == 12 && memcmp(out, "AAAABBBBCCCC", 12) == 0);
+
+    // 一段发不完: 中止并丢弃，恢复后续发后面的数据
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"DDDD", 4) == 4);
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"EEEE", 4) == 4);
+    CHECK(UartTx_Pause(&tx) == 0);
+    UartTx_Abort(&tx);
+    CHECK(!atomic_load(&dma_pending));
+    CHECK(UartTx_Write(&tx, (const uint8_t *)"FFFF", 4) == 4);
+    CHECK(!atomic_load(&dma_pending));
+
+    UartTx_Resume(&tx);
+    drain(&tx);
+    CHECK(out_len == 20 && memcmp(&out[12], "EEEEFFFF", 8) == 0);
+    CHECK(UartTx_IsIdle(&tx));
+    UartTx_GetStats(&tx, &st);
+    CHECK(st.dropped_bytes == 4);
+    CHECK(st.sent_bytes == 20);
+}
+
+static UartTx_t mt_tx;
+static atomic_int mt_running;
+static uint32_t mt_dropped[MT_PRODUCERS];
+
+static void *mt_producer(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    char msg[MT_MSG_LEN + 1];
+
+    for (int seq = 0; seq < MT_MESSAGES; seq++) {
+        snprintf(msg, sizeof(msg), "P%d:%08d\n", id, seq);
+        if (UartTx_Write(&mt_tx, (const uint8_t *)msg, MT_MSG_LEN) == 0) {
+            mt_dropped[id]++;
+            sched_yield();                  // 让出 CPU 给 "DMA" 线程，否则几乎全部丢弃
+        }
+    }
+    atomic_fetch_sub(&mt_running, 1);
+    return NULL;
+}
+
+static void *mt_dma(void *arg)
+{
+    (void)arg;
+    while (atomic_load(&mt_running) > 0 || !UartTx_IsIdle(&mt_tx)) {
+        dma_complete(&mt_tx);
+    }
+    return NULL;
+}
+
+static void test_concurrent_producers(void)
+{
+    static uint8_t buf[4096];
+    pthread_t producer[MT_PRODUCERS];
+    pthread_t dma;
+    int next[MT_PRODUCERS] = {0};
+    uint32_t delivered = 0;
+    uint32_t dropped = 0;
+    UartTx_Stats_t st;
+
+    setup(&mt_tx, buf, sizeof(buf));
+    atomic_store(&mt_running, MT_PRODUCERS);
+    CHECK(pthread_create(&dma, NULL, mt_dma, NULL) == 0);
+    for (int i = 0; i < MT_PRODUCERS; i++) {
+        CHECK(pthread_create(&producer[i], NULL, mt_producer, (void *)(intptr_t)i) == 0);
+    }
+    for (int i = 0; i < MT_PRODUCERS; i++) {
+        pthread_join(producer[i], NULL);
+        dropped += mt_dropped[i];
+    }
+    pthread_join(dma, NULL);
+
+    CHECK(out_len % MT_MSG_LEN == 0);
+    for (size_t off = 0; off < out_len; off += MT_MSG_LEN) {
+        const char *m = (const char *)&out[off];
+        int id;
+        int seq;
+        CHECK(m[0] == 'P' && m[2] == ':' && m[MT_MSG_LEN - 1] == '\n');
+        id = m[1] - '0';
+        CHECK(id >= 0 && id < MT_PRODUCERS);
+        seq = atoi(&m[3]);
+        CHECK(seq >= next[id]);             // 同一生产者内有序 (丢弃的消息留下空缺)
+        next[id] = seq + 1;
+        delivered++;
+    }
+    CHECK(delivered + dropped == MT_PRODUCERS * MT_MESSAGES);
+
+    UartTx_GetStats(&mt_tx, &st);
+    CHECK(st.sent_bytes == out_len);
+    CHECK(st.overflow_count == dropped);
+    CHECK(st.dropped_bytes == dropped * MT_MSG_LEN);
+    printf("concurrent: %u delivered, %u dropped, high water %u/%u\n",
+           (unsigned)delivered, (unsigned)dropped, (unsigned)st.high_water, (unsigned)sizeof(buf));
+}
+
+int main(void)
+{
+    test_stalled_dma();
+    test_wrap_order();
+    test_dma_error();
+    test_pause();
+    test_concurrent_producers();
+    printf("uart_tx_test: OK\n");
+    return 0;
+}
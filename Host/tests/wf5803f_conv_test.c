@@ -0,0 +1,86 @@
+/**
+ * @file    wf5803f_conv_test.c
+ * @brief   Core/Src/wf5803f_conv.c 主机测试：定点换算与精确值四舍五入逐位比较。
+ *
+ * - 压力: 每个型号遍历全部 2^24 个原始值，参考值按
+ *   P = 量程 / 0.81 × (raw / 2^23 − 0.1) + 量程下限 通分后用 128 位整数精确计算，
+ *   floor(x + 0.5) 四舍五入；另抽查高 8 位非零的输入 (应被忽略)
+ * - 温度: 全部 2^16 个原始值，参考值 floor(raw × 100 / 256 + 0.5)
+ */
+#include <stdint.h>
+#include <stdio.h>
+
+#include "wf5803f_conv.h"
+
+#define RAW_MIN     (-(1L << 23))
+#define RAW_MAX     ((1L << 23) - 1)
+
+static unsigned long failures;
+
+/* 向下取整的 128 位除法 (d > 0) */
+static __int128 floor_div(__int128 n, __int128 d)
+{
+    __int128 q = n / d;
+    return (n % d != 0 && n < 0) ? q - 1 : q;
+}
+
+static int32_t ref_pressure(const WF5803F_Model_t *model, int32_t raw)
+{
+    // P × 81 × 2^23 = raw × 量程 × 100 − 量程 × 10 × 2^23 + 下限 × 81 × 2^23
+    __int128 den = (__int128)WF5803F_CONV_DIV << WF5803F_CONV_SHIFT;
+    __int128 num = (__int128)raw * model->p_span_pa * 100 -
+                   ((__int128)model->p_span_pa * 10 << WF5803F_CONV_SHIFT) +
+                   (__int128)model->p_min_pa * den;
+    return (int32_t)floor_div(2 * num + den, 2 * den);
+}
+
+static void test_pressure(const WF5803F_Model_t *model)
+{
+    unsigned long bad = 0;
+
+    for (long raw = RAW_MIN; raw <= RAW_MAX; raw++) {
+        int32_t want = ref_pressure(model, (int32_t)raw);
+        int32_t got = WF5803F_ConvPressure(model, (int32_t)raw);
+        if (got != want && bad++ < 10) {
+            fprintf(stderr, "%s: raw %ld: got %ld want %ld\n", model->name, raw, (long)got, (long)want);
+        }
+        // 寄存器读出的 24 位值不做符号扩展传入，高 8 位应被忽略
+        if ((raw & 0xFFFL) == 0) {
+            uint32_t u = (uint32_t)raw & 0xFFFFFFU;
+            if (WF5803F_ConvPressure(model, (int32_t)u) != want ||
+                WF5803F_ConvPressure(model, (int32_t)(u | 0x5A000000U)) != want) {
+                if (bad++ < 10) {
+                    fprintf(stderr, "%s: raw 0x%06lX: high byte not ignored\n", model->name, (unsigned long)u);
+                }
+            }
+        }
+    }
+    printf("pressure %s: %ld ~ %ld Pa, %lu mismatches\n", model->name,
+           (long)WF5803F_ConvPressure(model, (int32_t)RAW_MIN),
+           (long)WF5803F_ConvPressure(model, (int32_t)RAW_MAX), bad);
+    failures += bad;
+}
+
+static void test_temperature(void)
+{
+    unsigned long bad = 0;
+
+    for (long raw = INT16_MIN; raw <= INT16_MAX; raw++) {
+        int32_t want = (int32_t)floor_div((__int128)raw * 100 * 2 + 256, 512);
+        int32_t got = WF5803F_ConvTemperature((int16_t)raw);
+        if (got != want && bad++ < 10) {
+            fprintf(stderr, "temperature: raw %ld: got %ld want %ld\n", raw, (long)got, (long)want);
+        }
+    }
+    printf("temperature: %lu mismatches\n", bad);
+    failures += bad;
+}
+
+int main(void)
+{
+    for (int m = 0; m < WF5803F_MODEL_COUNT; m++) {
+        test_pressure(&wf5803f_models[m]);
+    }
+    test_temperature();
+    return (failures == 0) ? 0 : 1;
+}
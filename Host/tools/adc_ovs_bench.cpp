@@ -0,0 +1,142 @@
+/**
+ * @file    adc_ovs_bench.cpp
+ * @brief   ADC 过采样基准测试：固件 DMA 中断中的累加 AdcScan_OvsAccumulate (Core/Src/adc_scan_ovs.c)
+ *          每次调用 (半个缓冲区)、每个输入采样和每个抽取输出的耗时。
+ *
+ * 用法: adc_ovs_bench [--outputs N] [--repeat N]
+ *
+ * 每轮产生 --outputs 个抽取输出 (每个 ADC_SCAN_OVS_N / (ADC_SCAN_DEPTH / 2) 次调用)，
+ * 重复 --repeat 轮取最小值，计时单位见 bench_clock.hpp。
+ * 输出同时核对抽取结果与逐通道求和再移位的参考值一致。
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_clock.hpp"
+#include "adc_scan_ovs.h"
+
+namespace {
+
+constexpr uint32_t kHalfScans = ADC_SCAN_DEPTH / 2U;                // 每次调用的扫描数
+constexpr uint32_t kHalfLen = kHalfScans * ADC_SCAN_CHANNELS;       // 每次调用的采样数
+constexpr uint32_t kCallsPerOutput = ADC_SCAN_OVS_N / kHalfScans;
+
+volatile uint32_t sink;
+
+// 12 位随机采样 (xorshift32)，按 [扫描][通道] 交织，与 DMA 缓冲区布局相同
+std::vector<uint16_t> makeInput(uint32_t outputs)
+{
+    std::vector<uint16_t> v(static_cast<size_t>(outputs) * kCallsPerOutput * kHalfLen);
+    uint32_t x = 0x12345678U;
+    for (uint16_t &s : v) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        s = static_cast<uint16_t>(x & 0x0FFFU);
+    }
+    return v;
+}
+
+double timeRun(const std::vector<uint16_t> &input, uint32_t calls)
+{
+    AdcScan_Ovs_t ovs;
+    volatile uint32_t out[ADC_SCAN_CHANNELS];
+    uint32_t n = 0;
+
+    AdcScan_OvsReset(&ovs);
+    uint64_t start = bench::now();
+    for (uint32_t i = 0; i < calls; i++) {
+        n += static_cast<uint32_t>(AdcScan_OvsAccumulate(&ovs, &input[static_cast<size_t>(i) * kHalfLen], out));
+    }
+    uint64_t cycles = bench::now() - start;
+    sink = n + out[0];
+    return static_cast<double>(cycles);
+}
+
+// 与参考值 (每个抽取周期逐通道求和后右移) 比较，返回不一致的输出个数
+uint32_t verify(const std::vector<uint16_t> &input, uint32_t outputs)
+{
+    AdcScan_Ovs_t ovs;
+    volatile uint32_t out[ADC_SCAN_CHANNELS];
+    uint32_t bad = 0;
+
+    AdcScan_OvsReset(&ovs);
+    for (uint32_t k = 0; k < outputs; k++) {
+        uint32_t ready = 0;
+        for (uint32_t c = 0; c < kCallsPerOutput; c++) {
+            size_t call = static_cast<size_t>(k) * kCallsPerOutput + c;
+            ready += static_cast<uint32_t>(AdcScan_OvsAccumulate(&ovs, &input[call * kHalfLen], out));
+        }
+        if (ready != 1) {
+            bad++;
+            continue;
+        }
+        for (uint32_t ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+            uint32_t sum = 0;
+            for (uint32_t s = 0; s < ADC_SCAN_OVS_N; s++) {
+                sum += input[static_cast<size_t>(k) * ADC_SCAN_OVS_N * ADC_SCAN_CHANNELS +
+                             static_cast<size_t>(s) * ADC_SCAN_CHANNELS + ch];
+            }
+            if (out[ch] != (sum >> ADC_SCAN_OVS_BITS)) {
+                bad++;
+                break;
+            }
+        }
+    }
+    return bad;
+}
+
+void usage()
+{
+    std::fprintf(stderr, "usage: adc_ovs_bench [--outputs N] [--repeat N]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long outputs = 2000;
+    unsigned long repeat = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char *opt = argv[i];
+        const char *val = argv[++i];
+        if (std::strcmp(opt, "--outputs") == 0) {
+            outputs = std::strtoul(val, nullptr, 10);
+        } else if (std::strcmp(opt, "--repeat") == 0) {
+            repeat = std::strtoul(val, nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (outputs == 0 || repeat == 0) {
+        usage();
+        return 2;
+    }
+
+    std::vector<uint16_t> input = makeInput(static_cast<uint32_t>(outputs));
+    uint32_t calls = static_cast<uint32_t>(outputs) * kCallsPerOutput;
+    double best = 0.0;
+    for (unsigned long r = 0; r < repeat; r++) {
+        double t = timeRun(input, calls);
+        if (r == 0 || t < best) best = t;
+    }
+
+    std::printf("channels %u  half buffer %u scans  decimation %u  outputs %lu  repeat %lu\n",
+                static_cast<unsigned>(ADC_SCAN_CHANNELS), static_cast<unsigned>(kHalfScans),
+                static_cast<unsigned>(ADC_SCAN_OVS_N), outputs, repeat);
+    std::printf("per call (%s)      %10.1f\n", bench::kClockUnit, best / calls);
+    std::printf("per input (%s)     %10.2f\n", bench::kClockUnit, best / (static_cast<double>(calls) * kHalfLen));
+    std::printf("per output (%s)    %10.1f   (all channels, %u calls)\n", bench::kClockUnit,
+                best / static_cast<double>(outputs), static_cast<unsigned>(kCallsPerOutput));
+    std::printf("mismatch          %10u\n", static_cast<unsigned>(verify(input, static_cast<uint32_t>(outputs))));
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file    filter_bench.cpp
+ * @brief   滤波级基准测试：固件的 SensorFilter_Process (Core/Src/sensor_filter.c，中值预滤波 +
+ *          arm_biquad_cascade_df2T_f32) 在各预设和中值窗口下每个采样的耗时。
+ *
+ * 用法: filter_bench [--samples N] [--repeat N]
+ *
+ * 每个组合处理 --samples 个带噪声和尖峰的温度采样取平均，重复 --repeat 轮取最小值。
+ * 固件内部的 cycles_last/cycles_max 计时在主机上换成空函数 (SENSOR_FILTER_CLOCK)，不计入结果。
+ * 同时输出恒定输入下的稳态误差 (各预设直流增益为 1，应接近 0)。
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_clock.hpp"
+#include "sensor_filter.h"
+
+// sensor_filter.c 的内部计时源 (见 Host/CMakeLists.txt 的 SENSOR_FILTER_CLOCK)
+extern "C" uint32_t filter_bench_null_clock(void)
+{
+    return 0;
+}
+
+namespace {
+
+constexpr uint8_t kMedians[] = { 1, 3, 5 };
+constexpr uint32_t kSettleSamples = 2000;
+
+volatile float sink;
+
+// 25°C 附近的温度采样: 均匀噪声 ±0.05°C，每 37 个采样一个 +3°C 尖峰 (xorshift32)
+std::vector<float> makeInput(uint32_t samples)
+{
+    std::vector<float> v(samples);
+    uint32_t x = 0x12345678U;
+    for (uint32_t i = 0; i < samples; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        v[i] = 25.0f + (static_cast<float>(x & 0xFFFFU) / 65535.0f - 0.5f) * 0.1f + ((i % 37U) == 0 ? 3.0f : 0.0f);
+    }
+    return v;
+}
+
+double timeRun(SensorFilter_Preset_t preset, uint8_t median, const std::vector<float> &input)
+{
+    SensorFilter_t filter;
+    float total = 0.0f;
+
+    SensorFilter_Init(&filter, preset, median);
+    uint64_t start = bench::now();
+    for (float x : input) {
+        total += SensorFilter_Process(&filter, x, 1);
+    }
+    uint64_t cycles = bench::now() - start;
+    sink = total;
+    return static_cast<double>(cycles) / static_cast<double>(input.size());
+}
+
+// 从 0 阶跃到 30°C 后保持，稳定后的输出与输入之差
+double settleError(SensorFilter_Preset_t preset, uint8_t median)
+{
+    SensorFilter_t filter;
+    float y = 0.0f;
+
+    SensorFilter_Init(&filter, preset, median);
+    SensorFilter_Process(&filter, 0.0f, 1);
+    for (uint32_t i = 0; i < kSettleSamples; i++) {
+        y = SensorFilter_Process(&filter, 30.0f, 1);
+    }
+    return std::fabs(static_cast<double>(y) - 30.0);
+}
+
+void usage()
+{
+    std::fprintf(stderr, "usage: filter_bench [--samples N] [--repeat N]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long samples = 100000;
+    unsigned long repeat = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char *opt = argv[i];
+        const char *val = argv[++i];
+        if (std::strcmp(opt, "--samples") == 0) {
+            samples = std::strtoul(val, nullptr, 10);
+        } else if (std::strcmp(opt, "--repeat") == 0) {
+            repeat = std::strtoul(val, nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (samples == 0 || repeat == 0) {
+        usage();
+        return 2;
+    }
+
+    std::vector<float> input = makeInput(static_cast<uint32_t>(samples));
+    std::printf("samples %lu  repeat %lu\n", samples, repeat);
+    std::printf("preset  median  stages  per sample(%s)  dc err\n", bench::kClockUnit);
+    for (int p = 0; p < SENSOR_FILTER_PRESETS; p++) {
+        SensorFilter_Preset_t preset = static_cast<SensorFilter_Preset_t>(p);
+        const SensorFilter_Design_t *design = SensorFilter_GetDesign(preset);
+        for (uint8_t median : kMedians) {
+            double best = 0.0;
+            for (unsigned long r = 0; r < repeat; r++) {
+                double t = timeRun(preset, median, input);
+                if (r == 0 || t < best) best = t;
+            }
+            std::printf("%-6s  %6u  %6u  %15.1f  %.1e\n", design->name, static_cast<unsigned>(median),
+                        static_cast<unsigned>(design->stages), best, settleError(preset, median));
+        }
+    }
+    return 0;
+}
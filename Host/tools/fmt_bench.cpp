@@ -0,0 +1,145 @@
+/**
+ * @file    fmt_bench.cpp
+ * @brief   格式化基准测试：固件的 Fmt_Vsnprintf (Core/Src/fmt.c) 与 libc vsnprintf
+ *          对同一组格式字符串 (固件实际发送的消息) 每次调用的耗时。
+ *
+ * 用法: fmt_bench [--iter N] [--repeat N]
+ *
+ * 每个用例运行 --iter 次取平均，重复 --repeat 轮取最小值。输出同时核对两边结果逐字符一致。
+ * libc 的 %f 按双精度转换；板上 newlib 的双精度全靠软件运算，这一项在板上最贵。
+ */
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench_clock.hpp"
+#include "fmt.h"
+
+namespace {
+
+using Formatter = int (*)(char *, size_t, const char *, va_list);
+
+struct Case {
+    const char *name;
+    const char *format;
+};
+
+// 与固件消息一致的格式 (command.c / telemetry.c / V_detect.c)
+constexpr Case kCases[] = {
+    { "ntc_json", "{\"type\":\"data\",\"sensor\":\"NTC\",\"temp\":%.2f,\"t_us\":%lu,\"age_us\":%lu}\n" },
+    { "wf_json",  "{\"type\":\"data\",\"sensor\":\"WF5803\",\"temp\":%.2f,\"press\":%.2f,\"lat_us\":%lu}\n" },
+    { "pid_json", "{\"type\":\"data\",\"sensor\":\"PID\",\"output\":%.2f,\"lat_us\":%lu}\n" },
+    { "float6",   "%f" },
+    { "int",      "%d" },
+    { "reply",    "{\"type\":\"reply\",\"cmd\":\"%s\",\"ok\":%d}\n" },
+};
+constexpr size_t kCaseCount = sizeof(kCases) / sizeof(kCases[0]);
+
+volatile int sink;
+
+int callFormatter(Formatter f, char *buf, size_t size, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int n = f(buf, size, format, args);
+    va_end(args);
+    return n;
+}
+
+// 每个用例的参数随迭代变化，避免结果被缓存或常量折叠
+int runCase(size_t c, Formatter f, char *buf, size_t size, uint32_t i)
+{
+    float t = 20.0f + static_cast<float>(i % 4096U) * (1.0f / 64.0f);
+    unsigned long us = 1000UL + i;
+
+    switch (c) {
+    case 0:  return callFormatter(f, buf, size, kCases[c].format, static_cast<double>(t), us, us / 7UL);
+    case 1:  return callFormatter(f, buf, size, kCases[c].format, static_cast<double>(t),
+                                  static_cast<double>(t * 5.0f), us);
+    case 2:  return callFormatter(f, buf, size, kCases[c].format, static_cast<double>(t * 10.0f), us);
+    case 3:  return callFormatter(f, buf, size, kCases[c].format, static_cast<double>(t));
+    case 4:  return callFormatter(f, buf, size, kCases[c].format, static_cast<int>(i) - 5000);
+    default: return callFormatter(f, buf, size, kCases[c].format, "stats", static_cast<int>(i & 1U));
+    }
+}
+
+double timeCase(size_t c, Formatter f, uint32_t iter)
+{
+    char buf[160];
+    int total = 0;
+    uint64_t start = bench::now();
+    for (uint32_t i = 0; i < iter; i++) {
+        total += runCase(c, f, buf, sizeof(buf), i);
+    }
+    uint64_t cycles = bench::now() - start;
+    sink = total;
+    return static_cast<double>(cycles) / static_cast<double>(iter);
+}
+
+// 逐字符核对两边输出，返回不一致的次数
+uint32_t verifyCase(size_t c, uint32_t iter)
+{
+    char a[160];
+    char b[160];
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < iter; i++) {
+        int na = runCase(c, Fmt_Vsnprintf, a, sizeof(a), i);
+        int nb = runCase(c, vsnprintf, b, sizeof(b), i);
+        if (na != nb || std::strcmp(a, b) != 0) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+void usage()
+{
+    std::fprintf(stderr, "usage: fmt_bench [--iter N] [--repeat N]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long iter = 20000;
+    unsigned long repeat = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char *opt = argv[i];
+        const char *val = argv[++i];
+        if (std::strcmp(opt, "--iter") == 0) {
+            iter = std::strtoul(val, nullptr, 10);
+        } else if (std::strcmp(opt, "--repeat") == 0) {
+            repeat = std::strtoul(val, nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (iter == 0 || repeat == 0) {
+        usage();
+        return 2;
+    }
+
+    std::printf("iter %lu  repeat %lu\n", iter, repeat);
+    std::printf("case      fmt(%s)  libc(%s)  libc/fmt  mismatch\n", bench::kClockUnit, bench::kClockUnit);
+    for (size_t c = 0; c < kCaseCount; c++) {
+        double best_fmt = 0.0;
+        double best_libc = 0.0;
+        for (unsigned long r = 0; r < repeat; r++) {
+            double t_fmt = timeCase(c, Fmt_Vsnprintf, static_cast<uint32_t>(iter));
+            double t_libc = timeCase(c, vsnprintf, static_cast<uint32_t>(iter));
+            if (r == 0 || t_fmt < best_fmt) best_fmt = t_fmt;
+            if (r == 0 || t_libc < best_libc) best_libc = t_libc;
+        }
+        std::printf("%-8s  %9.1f  %10.1f  %8.2f  %8u\n", kCases[c].name, best_fmt, best_libc,
+                    best_libc / best_fmt, static_cast<unsigned>(verifyCase(c, static_cast<uint32_t>(iter))));
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file    ntc_bench.cpp
+ * @brief   NTC 换算基准测试：固件的查表插值 compute_ntc_temperature_ovs 与公式版本
+ *          compute_ntc_temperature_exact (Core/Src/ntc_conv.c) 每次调用的耗时。
+ *
+ * 用法: ntc_bench [--repeat N]
+ *
+ * 每轮遍历全部过采样 ADC 码 (0 ~ NTC_TABLE_CODE_MAX)，重复 --repeat 轮取最小值。
+ * 同时输出 -40 ~ 125 °C 内两者的最大差值 (查找表相对双精度公式的误差由 ntc_table_gen --check 校验)。
+ * 公式版本的开销主要在 logf，板上为 newlib 软件实现。
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench_clock.hpp"
+#include "ntc_conv.h"
+
+namespace {
+
+constexpr double kCheckMin = -40.0;
+constexpr double kCheckMax = 125.0;
+constexpr uint32_t kCodes = NTC_TABLE_CODE_MAX + 1U;
+
+volatile float sink;
+
+float exactFromCode(uint32_t code)
+{
+    return compute_ntc_temperature_exact(static_cast<float>(code) / static_cast<float>(NTC_TABLE_CODE_MAX));
+}
+
+template <typename Conv>
+double timeAll(Conv conv)
+{
+    float total = 0.0f;
+    uint64_t start = bench::now();
+    for (uint32_t code = 0; code < kCodes; code++) {
+        total += conv(code);
+    }
+    uint64_t cycles = bench::now() - start;
+    sink = total;
+    return static_cast<double>(cycles) / kCodes;
+}
+
+void usage()
+{
+    std::fprintf(stderr, "usage: ntc_bench [--repeat N]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long repeat = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char *opt = argv[i];
+        const char *val = argv[++i];
+        if (std::strcmp(opt, "--repeat") == 0) {
+            repeat = std::strtoul(val, nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (repeat == 0) {
+        usage();
+        return 2;
+    }
+
+    double best_table = 0.0;
+    double best_exact = 0.0;
+    for (unsigned long r = 0; r < repeat; r++) {
+        double t_table = timeAll(compute_ntc_temperature_ovs);
+        double t_exact = timeAll(exactFromCode);
+        if (r == 0 || t_table < best_table) best_table = t_table;
+        if (r == 0 || t_exact < best_exact) best_exact = t_exact;
+    }
+
+    double worst = 0.0;
+    uint32_t worst_code = 0;
+    for (uint32_t code = 1; code < NTC_TABLE_CODE_MAX; code++) {
+        double exact = exactFromCode(code);
+        if (exact < kCheckMin || exact > kCheckMax) {
+            continue;
+        }
+        double err = std::fabs(compute_ntc_temperature_ovs(code) - exact);
+        if (err > worst) {
+            worst = err;
+            worst_code = code;
+        }
+    }
+
+    std::printf("codes %u  repeat %lu\n", static_cast<unsigned>(kCodes), repeat);
+    std::printf("table(%s)  exact(%s)  exact/table  max diff (-40~125 C)\n", bench::kClockUnit, bench::kClockUnit);
+    std::printf("%10.1f  %10.1f  %11.2f  %.4f C at code %u\n", best_table, best_exact,
+                best_exact / best_table, worst, static_cast<unsigned>(worst_code));
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file    ntc_table_gen.cpp
+ * @brief   NTC 温度查找表生成工具：按 Core/Inc/ntc_param.h 的参数生成 Core/Src/ntc_table.c。
+ *
+ * 用法: ntc_table_gen [--check] [输出文件, 缺省为标准输出]
+ *
+ * 表点 i 对应 ADC 码 i << (16 - NTC_TABLE_BITS)，表值为该码的温度 (1/256 °C，限幅到
+ * NTC_TABLE_T_MIN ~ NTC_TABLE_T_MAX)。--check 按固件的插值算法 (arm_linear_interp_q15)
+ * 遍历全部 ADC 码，与 Beta / Steinhart-Hart 公式的双精度结果比较，
+ * -40 ~ 125 °C 内最大误差超过 0.01 °C 时返回 1，不写输出文件。
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "ntc_param.h"
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+namespace {
+
+constexpr double kCheckMin = -40.0;
+constexpr double kCheckMax = 125.0;
+constexpr double kCheckLimit = 0.01;
+constexpr int kCodeShift = 16 - NTC_TABLE_BITS;
+
+// ADC 码对应的温度 (°C)，与 NTC.c 中的浮点公式一致
+double reference(uint32_t code)
+{
+    double ratio = static_cast<double>(code) / NTC_TABLE_CODE_MAX;
+    if (ratio <= 0.0) {
+        return HUGE_VAL;
+    }
+    if (ratio >= 1.0) {
+        return -HUGE_VAL;
+    }
+    double r = static_cast<double>(NTC_R_SERIES) * ratio / (1.0 - ratio);
+#if NTC_USE_STEINHART
+    double l = std::log(r);
+    double inv = NTC_SH_A + NTC_SH_B * l + NTC_SH_C * l * l * l;
+#else
+    double inv = 1.0 / static_cast<double>(NTC_T0) +
+                 std::log(r / static_cast<double>(NTC_R0)) / static_cast<double>(NTC_BETA);
+#endif
+    return 1.0 / inv - 273.15;
+}
+
+std::vector<int16_t> build()
+{
+    std::vector<int16_t> table(NTC_TABLE_SIZE);
+    for (uint32_t i = 0; i < NTC_TABLE_SIZE; i++) {
+        double t = reference(i << kCodeShift);
+        if (t < NTC_TABLE_T_MIN) t = NTC_TABLE_T_MIN;
+        if (t > NTC_TABLE_T_MAX) t = NTC_TABLE_T_MAX;
+        table[i] = static_cast<int16_t>(std::lround(t * NTC_TABLE_SCALE));
+    }
+    return table;
+}
+
+// 与 arm_linear_interp_q15 相同的定点插值 (输入 12.20 格式)
+double lookup(const std::vector<int16_t> &table, uint32_t code)
+{
+    int32_t x = static_cast<int32_t>(code << (20 - kCodeShift));
+    int32_t index = x >> 20;
+    if (index >= static_cast<int32_t>(NTC_TABLE_SIZE - 1)) {
+        return static_cast<double>(table[NTC_TABLE_SIZE - 1]) / NTC_TABLE_SCALE;
+    }
+    int64_t fract = x & 0x000FFFFF;
+    int64_t y = static_cast<int64_t>(table[index]) * (0xFFFFF - fract) +
+                static_cast<int64_t>(table[index + 1]) * fract;
+    return static_cast<double>(static_cast<int16_t>(y >> 20)) / NTC_TABLE_SCALE;
+}
+
+bool check(const std::vector<int16_t> &table)
+{
+    double worst = 0.0;
+    uint32_t worst_code = 0;
+
+    for (uint32_t code = 0; code <= NTC_TABLE_CODE_MAX; code++) {
+        double t = reference(code);
+        if (t < kCheckMin || t > kCheckMax) {
+            continue;
+        }
+        double err = std::fabs(lookup(table, code) - t);
+        if (err > worst) {
+            worst = err;
+            worst_code = code;
+        }
+    }
+    std::fprintf(stderr, "max error %.4f C at code %u (%.2f C), limit %.2f C\n",
+                 worst, worst_code, reference(worst_code), kCheckLimit);
+    return worst <= kCheckLimit;
+}
+
+void write(FILE *out, const std::vector<int16_t> &table)
+{
+    std::fprintf(out,
+        "/**\n"
+        "  ******************************************************************************\n"
+        "  * @file           : ntc_table.c\n"
+        "  * @brief          : NTC 温度查找表 (由 Host/tools/ntc_table_gen 生成，勿手工修改)\n"
+        "  ******************************************************************************\n"
+        "  */\n"
+        "\n"
+        "#include \"ntc_param.h\"\n"
+        "\n"
+        "// 生成时的参数，ntc_param.h 修改后需要重新生成\n"
+        "_Static_assert(NTC_BETA == %s && NTC_R0 == %s && NTC_T0 == %s &&\n"
+        "               NTC_R_SERIES == %s && NTC_USE_STEINHART == %s &&\n"
+        "               NTC_SH_A == %s && NTC_SH_B == %s && NTC_SH_C == %s &&\n"
+        "               NTC_TABLE_BITS == %s && NTC_TABLE_CODE_MAX == %s && NTC_TABLE_SCALE == %s &&\n"
+        "               NTC_TABLE_T_MIN == %s && NTC_TABLE_T_MAX == %s,\n"
+        "               \"ntc_param.h changed, regenerate ntc_table.c with Host/tools/ntc_table_gen\");\n"
+        "\n"
+        "const int16_t ntc_table[NTC_TABLE_SIZE] = {\n",
+        STR(NTC_BETA), STR(NTC_R0), STR(NTC_T0), STR(NTC_R_SERIES), STR(NTC_USE_STEINHART),
+        STR(NTC_SH_A), STR(NTC_SH_B), STR(NTC_SH_C),
+        STR(NTC_TABLE_BITS), STR(NTC_TABLE_CODE_MAX), STR(NTC_TABLE_SCALE),
+        STR(NTC_TABLE_T_MIN), STR(NTC_TABLE_T_MAX));
+
+    for (size_t i = 0; i < table.size(); i++) {
+        std::fprintf(out, "%s%6d,%s", (i % 10 == 0) ? "    " : " ", table[i],
+                     (i % 10 == 9 || i + 1 == table.size()) ? "\n" : "");
+    }
+    std::fprintf(out, "};\n");
+}
+
+void usage()
+{
+    std::fprintf(stderr, "usage: ntc_table_gen [--check] [output.c]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool do_check = false;
+    const char *out_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--check") == 0) {
+            do_check = true;
+        } else if (argv[i][0] != '-' && out_path == nullptr) {
+            out_path = argv[i];
+        } else {
+            // 未知选项 (含 --help) 不能当作输出文件名
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<int16_t> table = build();
+    if (do_check && !check(table)) {
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if (out_path != nullptr) {
+        out = std::fopen(out_path, "w");
+        if (out == nullptr) {
+            std::perror(out_path);
+            return 1;
+        }
+    }
+    write(out, table);
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
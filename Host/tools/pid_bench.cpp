@@ -0,0 +1,176 @@
+/**
+ * @file    pid_bench.cpp
+ * @brief   PID 后端基准测试：固件的 PID_Compute (Core/Src/pid_ctrl.c) 全部后端以相同增益
+ *          同时闭环控制一阶热对象，比较位置式浮点和 CMSIS-DSP 增量式 f32/q31/q15
+ *          每次计算的耗时和控制轨迹。
+ *
+ * 用法: pid_bench [--kp G] [--ki G] [--kd G] [--sp °C] [--db °C] [--steps N] [--repeat N]
+ *
+ * 缺省参数与固件 temp_pid_ctrl.h 一致 (Kp 130, Ki 0, Kd 0, 目标 30°C, 死区 0.2°C,
+ * 输出 0 ~ 1000, 积分 ±500)。对象: dT/dt = (环境温度 + 满功率温升 × u / 输出上限 - T) / τ，
+ * 环境 25°C、满功率温升 40°C、τ = 60s，采样间隔 0.5s (与固件缺省控制周期相同)。
+ * --repeat 重复整个测试，耗时取各次平均值的最小值 (减小调度和缓存的影响)。
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench_clock.hpp"
+#include "pid_ctrl.h"
+
+namespace {
+
+constexpr float kDtS = 0.5f;             // 采样间隔 (s)
+constexpr float kAmbient = 25.0f;        // 对象初始/环境温度 (°C)
+constexpr float kGain = 40.0f;           // 满功率稳态温升 (°C)
+constexpr float kTauS = 60.0f;           // 对象时间常数 (s)
+constexpr uint32_t kClockCal = 16;       // 计时开销标定次数
+
+/** @brief 每个后端一项的结果 */
+struct BenchResult {
+    uint64_t cycles_total;      // PID_Compute 累计耗时 (时钟计数)
+    uint64_t cycles_max;        // 单次最大耗时
+    float dev_max;              // 对象温度与 pos 后端轨迹的最大偏差 (°C)
+    float temp_final;           // 结束时的对象温度 (°C)
+};
+
+// 全部后端以 tmpl 的增益、限幅、死区和目标温度同时闭环，work 为 PID_BACKENDS 个控制器
+void runBench(const PID_Controller_t &tmpl, PID_Controller_t *work, uint32_t steps, BenchResult *result)
+{
+    float temp[PID_BACKENDS];
+
+    // 计时本身的开销 (连续两次读数之差的最小值)，从每次测量中扣除
+    uint64_t overhead = UINT64_MAX;
+    for (uint32_t n = 0; n < kClockCal; n++) {
+        uint64_t start = bench::now();
+        uint64_t cycles = bench::now() - start;
+        if (cycles < overhead) {
+            overhead = cycles;
+        }
+    }
+
+    for (uint32_t b = 0; b < PID_BACKENDS; b++) {
+        work[b] = tmpl;
+        work[b].backend = static_cast<PID_Backend_t>(b);
+        work[b].backend_request = static_cast<uint8_t>(b);
+        PID_Reset(&work[b]);
+        temp[b] = kAmbient;
+        result[b] = BenchResult{};
+    }
+
+    for (uint32_t n = 0; n < steps; n++) {
+        for (uint32_t b = 0; b < PID_BACKENDS; b++) {
+            uint64_t start = bench::now();
+            float u = PID_Compute(&work[b], temp[b], kDtS);
+            uint64_t cycles = bench::now() - start;
+            cycles = (cycles > overhead) ? (cycles - overhead) : 0;
+
+            result[b].cycles_total += cycles;
+            if (cycles > result[b].cycles_max) {
+                result[b].cycles_max = cycles;
+            }
+
+            // 一阶对象，前向欧拉 (dt << tau)
+            temp[b] += kDtS / kTauS * (kAmbient + kGain * u / tmpl.output_limit_max - temp[b]);
+            float dev = std::fabs(temp[b] - temp[PID_BACKEND_POS]);
+            if (dev > result[b].dev_max) {
+                result[b].dev_max = dev;
+            }
+        }
+    }
+
+    for (uint32_t b = 0; b < PID_BACKENDS; b++) {
+        result[b].temp_final = temp[b];
+    }
+}
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "usage: pid_bench [--kp G] [--ki G] [--kd G] [--sp degC] [--db degC]"
+                 " [--steps N] [--repeat N]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    PID_Controller_t tmpl;
+    std::memset(&tmpl, 0, sizeof(tmpl));
+    tmpl.Kp = 130.0f;
+    tmpl.Ki = 0.0f;
+    tmpl.Kd = 0.0f;
+    tmpl.setpoint = 30.0f;
+    tmpl.deadband = 0.2f;
+    tmpl.output_limit_min = 0.0f;
+    tmpl.output_limit_max = 1000.0f;
+    tmpl.integral_limit_min = -500.0f;
+    tmpl.integral_limit_max = 500.0f;
+    tmpl.sample_time_ms = 500;
+
+    unsigned long steps = 400;
+    unsigned long repeat = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char *opt = argv[i];
+        const char *val = argv[++i];
+        if (std::strcmp(opt, "--kp") == 0) {
+            tmpl.Kp = std::strtof(val, nullptr);
+        } else if (std::strcmp(opt, "--ki") == 0) {
+            tmpl.Ki = std::strtof(val, nullptr);
+        } else if (std::strcmp(opt, "--kd") == 0) {
+            tmpl.Kd = std::strtof(val, nullptr);
+        } else if (std::strcmp(opt, "--sp") == 0) {
+            tmpl.setpoint = std::strtof(val, nullptr);
+        } else if (std::strcmp(opt, "--db") == 0) {
+            tmpl.deadband = std::strtof(val, nullptr);
+        } else if (std::strcmp(opt, "--steps") == 0) {
+            steps = std::strtoul(val, nullptr, 10);
+        } else if (std::strcmp(opt, "--repeat") == 0) {
+            repeat = std::strtoul(val, nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (steps == 0 || repeat == 0) {
+        usage();
+        return 2;
+    }
+
+    PID_Controller_t work[PID_BACKENDS];
+    BenchResult result[PID_BACKENDS];
+    double best[PID_BACKENDS];
+    uint64_t worst[PID_BACKENDS] = {};
+
+    for (unsigned long r = 0; r < repeat; r++) {
+        runBench(tmpl, work, static_cast<uint32_t>(steps), result);
+        for (uint32_t b = 0; b < PID_BACKENDS; b++) {
+            double avg = static_cast<double>(result[b].cycles_total) / static_cast<double>(steps);
+            if (r == 0 || avg < best[b]) {
+                best[b] = avg;
+            }
+            if (result[b].cycles_max > worst[b]) {
+                worst[b] = result[b].cycles_max;
+            }
+        }
+    }
+
+    std::printf("Kp %g  Ki %g  Kd %g  setpoint %.2f  deadband %.2f  steps %lu  repeat %lu\n",
+                tmpl.Kp, tmpl.Ki, tmpl.Kd, tmpl.setpoint, tmpl.deadband, steps, repeat);
+    std::printf("backend  avg(%s)  max(%s)  final(degC)  dev_max(degC)  err_fs(degC)\n",
+                bench::kClockUnit, bench::kClockUnit);
+    for (uint32_t b = 0; b < PID_BACKENDS; b++) {
+        std::printf("%-7s  %8.1f  %8llu  %11.4f  %13.5f  %12.3f\n",
+                    PID_BackendName(static_cast<PID_Backend_t>(b)), best[b],
+                    static_cast<unsigned long long>(worst[b]), result[b].temp_final, result[b].dev_max,
+                    (b >= PID_BACKEND_Q31) ? work[b].dsp_err_fs : 0.0f);
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file    tlm_decode.cpp
+ * @brief   命令行解码工具：读取串口原始数据流 (文件/串口设备/标准输入)，
+ *          把二进制遥测帧还原为 JSON 行，文本消息原样输出。
+ *
+ * 用法: tlm_decode [--elf 固件ELF] [输入文件或串口设备, 缺省为标准输入]
+ *       指定 --elf 时同时还原延迟格式化日志 (LOG_DEFERRED 固件)
+ *
+ * 结束时在标准错误输出解码统计，以及按设备时间戳 (t_cycles) 统计的采样间隔抖动、
+ * 控制延迟 (数据年龄 + 读取到 PWM 更新) 和 WF5803F I2C 延迟的最小/最大值。
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "dlog_table.hpp"
+#include "tlm_decoder.hpp"
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    const char *in_path = nullptr;
+    tlm::DLogTable dlog;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--elf") == 0 && i + 1 < argc) {
+            std::string err;
+            if (!dlog.loadElf(argv[++i], err)) {
+                std::fprintf(stderr, "%s: %s\n", argv[i], err.c_str());
+                return 1;
+            }
+        } else {
+            in_path = argv[i];
+        }
+    }
+    if (in_path != nullptr) {
+        in = std::fopen(in_path, "rb");
+        if (in == nullptr) {
+            std::perror(in_path);
+            return 1;
+        }
+    }
+
+    // 时间统计 (µs)
+    struct Range {
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        void add(uint64_t v) { min = std::min(min, v); max = std::max(max, v); }
+        bool empty() const { return min > max; }
+    };
+    Range interval, latency, wf_latency;
+    uint64_t last_t = 0;
+
+    tlm::StreamDecoder decoder;
+    decoder.onSample([&](const tlm::Sample &s) {
+        std::fputs(tlm::sampleToJsonLines(s.data, s.version).c_str(), stdout);
+        if (s.version < TLM_SAMPLE_VERSION_CYCLES) {
+            return;                         // 旧固件没有周期计数字段
+        }
+        if (last_t != 0 && s.data.t_cycles > last_t) {
+            interval.add(tlm::cyclesToUs(s.data.t_cycles - last_t));
+        }
+        last_t = s.data.t_cycles;
+        if (s.data.ctl_cycles != 0) {
+            latency.add(tlm::cyclesToUs(static_cast<uint64_t>(s.data.age_cycles) + s.data.ctl_cycles));
+        }
+        if (s.data.wf_cycles != 0) {
+            wf_latency.add(tlm::cyclesToUs(s.data.wf_cycles));
+        }
+    });
+    decoder.onText([](const std::string &line) {
+        std::fputs(line.c_str(), stdout);
+        std::fputc('\n', stdout);
+    });
+    decoder.onFrame([&dlog](const TlmFrameHeader_t &h, const uint8_t *payload, size_t len) {
+        if (h.type == TLM_FRAME_TYPE_THERMAL && len == sizeof(TlmThermal_t)) {
+            TlmThermal_t t;
+            std::memcpy(&t, payload, sizeof(t));
+            std::fputs(tlm::thermalToJsonLines(t).c_str(), stdout);
+        } else if (h.type == TLM_FRAME_TYPE_LOG) {
+            if (dlog.loaded()) {
+                // 格式字符串自带换行
+                std::fputs(dlog.format(payload, len).c_str(), stdout);
+            } else {
+                std::fprintf(stdout, "<dlog frame, pass --elf to decode>\n");
+            }
+        }
+    });
+
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), in)) > 0) {
+        decoder.feed(buf, n);
+    }
+
+    const tlm::DecoderStats &st = decoder.stats();
+    std::fprintf(stderr, "frames ok=%llu bad=%llu unknown=%llu old=%llu seq_gaps=%llu text=%llu\n",
+                 (unsigned long long)st.frames_ok, (unsigned long long)st.frames_bad,
+                 (unsigned long long)st.frames_unknown, (unsigned long long)st.frames_old,
+                 (unsigned long long)st.seq_gaps, (unsigned long long)st.text_lines);
+    if (st.frames_old != 0) {
+        std::fprintf(stderr, "note: %llu frames from older firmware (version < %d), missing fields decoded as 0\n",
+                     (unsigned long long)st.frames_old, TLM_FRAME_VERSION);
+    }
+    const std::pair<const char *, const Range *> ranges[] = {
+        { "interval", &interval }, { "latency", &latency }, { "wf_latency", &wf_latency },
+    };
+    for (const auto &r : ranges) {
+        if (!r.second->empty()) {
+            std::fprintf(stderr, "%s_us min=%llu max=%llu\n", r.first,
+                         (unsigned long long)r.second->min, (unsigned long long)r.second->max);
+        }
+    }
+
+    if (in != stdin) {
+        std::fclose(in);
+    }
+    return 0;
+}
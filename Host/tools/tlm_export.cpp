@@ -0,0 +1,83 @@
+/**
+ * @file    tlm_export.cpp
+ * @brief   导出工具：把 tlm_ingest 的 NDJSON / 列式文件转换为《上位机需求文档》中的
+ *          旧版 JSON 数组格式 (ntc_temp_YYYYMMDD_HHMMSS.json)。
+ *
+ * 用法: tlm_export [--sensor NTC|WF5803|PID] 输入文件 [输出文件, 缺省为标准输出]
+ *
+ * 每条记录输出 pc_timestamp / pc_time_sec / temperature 三个字段
+ * (PID 为 output，WF5803 额外输出 pressure)，缩进与 Python json.dump(indent=2) 一致。
+ */
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "record_store.hpp"
+
+int main(int argc, char **argv)
+{
+    tlm::SensorId sensor = tlm::SensorId::NTC;
+    const char *in_path = nullptr;
+    const char *out_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--sensor") == 0 && i + 1 < argc) {
+            sensor = tlm::sensorFromName(argv[++i]);
+            if (sensor == tlm::SensorId::Unknown) {
+                std::fprintf(stderr, "unknown sensor %s\n", argv[i]);
+                return 1;
+            }
+        } else if (in_path == nullptr) {
+            in_path = argv[i];
+        } else {
+            out_path = argv[i];
+        }
+    }
+    if (in_path == nullptr) {
+        std::fprintf(stderr, "usage: %s [--sensor NTC|WF5803|PID] input [output.json]\n", argv[0]);
+        return 1;
+    }
+
+    std::FILE *out = stdout;
+    if (out_path != nullptr) {
+        out = std::fopen(out_path, "wb");
+        if (out == nullptr) {
+            std::perror(out_path);
+            return 1;
+        }
+    }
+
+    uint64_t count = 0;
+    std::string err;
+    std::fputs("[", out);
+    bool ok = tlm::readRecords(in_path, [&](const tlm::Record &rec) {
+        if (rec.sensor != sensor) {
+            return;
+        }
+        std::fprintf(out, "%s\n  {\n    \"pc_timestamp\": \"%s\",\n    \"pc_time_sec\": %.6f,\n",
+                     count == 0 ? "" : ",", tlm::isoTimestamp(rec.pc_time_sec).c_str(), rec.pc_time_sec);
+        switch (sensor) {
+        case tlm::SensorId::WF5803:
+            std::fprintf(out, "    \"temperature\": %.2f,\n    \"pressure\": %.2f\n  }", rec.v0, rec.v1);
+            break;
+        case tlm::SensorId::PID:
+            std::fprintf(out, "    \"output\": %.2f\n  }", rec.v0);
+            break;
+        default:
+            std::fprintf(out, "    \"temperature\": %.2f\n  }", rec.v0);
+            break;
+        }
+        count++;
+    }, err);
+    std::fputs(count == 0 ? "]\n" : "\n]\n", out);
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    if (!ok) {
+        std::fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "%llu records\n", (unsigned long long)count);
+    return 0;
+}
@@ -0,0 +1,387 @@
+/**
+ * @file    tlm_ingest.cpp
+ * @brief   采集工具：读取串口数据流 (串口设备/伪终端/回放文件/标准输入)，
+ *          传感器数据追加写入 NDJSON 或列式二进制文件，文本消息打印到控制台。
+ *
+ * 用法: tlm_ingest [--baud 波特率] [--negotiate 新波特率] [--format ndjson|col]
+ *                  [--out 输出文件] [--elf 固件ELF] [--quiet] [输入, 缺省为标准输入]
+ *
+ * - 同时支持 JSON 文本模式和二进制帧模式 (mode json / mode bin)
+ * - 每条记录 O(1) 追加，每秒 flush 一次；Ctrl+C 退出时写出剩余数据
+ * - 缺省输出 ./temp_data/tlm_YYYYMMDD_HHMMSS.ndjson (或 .tlmc)
+ * - 旧版 ntc_temp_*.json 数组文件用 tlm_export 转换得到
+ * - --negotiate 先以 --baud 与设备协商更高波特率 (流程见 Core/Inc/baud_neg.h)，
+ *   失败时保持原波特率继续采集
+ */
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "dlog_table.hpp"
+#include "record_store.hpp"
+#include "tlm_decoder.hpp"
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int)
+{
+    g_stop = 1;
+}
+
+double nowSec()
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double>>(system_clock::now().time_since_epoch()).count();
+}
+
+speed_t baudToSpeed(long baud)
+{
+    switch (baud) {
+    case 9600:    return B9600;
+    case 19200:   return B19200;
+    case 38400:   return B38400;
+    case 57600:   return B57600;
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+    case 460800:  return B460800;
+    case 921600:  return B921600;
+    case 1000000: return B1000000;
+    case 2000000: return B2000000;
+    default:      return 0;
+    }
+}
+
+/** @brief 串口设备设为原始模式 (8N1，无流控) */
+bool setupSerial(int fd, long baud)
+{
+    termios tio{};
+    speed_t speed = baudToSpeed(baud);
+    if (speed == 0) {
+        std::fprintf(stderr, "unsupported baud rate %ld\n", baud);
+        return false;
+    }
+    if (tcgetattr(fd, &tio) != 0) {
+        std::perror("tcgetattr");
+        return false;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        std::perror("tcsetattr");
+        return false;
+    }
+    return true;
+}
+
+/** @brief 读取数据交给解码器，直到 done() 为真或超时 */
+bool pumpUntil(int fd, tlm::StreamDecoder &decoder, int timeout_ms, const std::function<bool()> &done)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    uint8_t buf[256];
+
+    while (!done()) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) {
+            return false;
+        }
+        pollfd pfd{fd, POLLIN, 0};
+        if (::poll(&pfd, 1, static_cast<int>(left)) <= 0) {
+            continue;
+        }
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            decoder.feed(buf, static_cast<size_t>(n));
+        }
+    }
+    return true;
+}
+
+bool writeLine(int fd, const std::string &line)
+{
+    return ::write(fd, line.data(), line.size()) == static_cast<ssize_t>(line.size());
+}
+
+/**
+ * @brief 与设备协商新波特率
+ *
+ * 1. 以原波特率发送 "baud <新波特率>"，等待 ok 应答
+ * 2. 本地切换到新波特率，等待校验正确的探测帧
+ * 3. 发送 "baud ok"，等待确认应答
+ * 任一步失败都恢复原波特率；设备在超时 (1s，BAUDNEG_CONFIRM_TIMEOUT_MS) 后也会自行恢复。
+ */
+bool negotiateBaud(int fd, long from, long to)
+{
+    static const uint8_t kPattern[] = TLM_PROBE_PATTERN;
+    std::string ack;
+    bool probed = false;
+
+    auto makeDecoder = [&]() {
+        auto d = std::make_unique<tlm::StreamDecoder>();
+        d->onText([&](const std::string &line) {
+            if (line.find("\"cmd\":\"baud\"") != std::string::npos) {
+                ack = line;
+            }
+        });
+        d->onFrame([&](const TlmFrameHeader_t &h, const uint8_t *payload, size_t len) {
+            TlmProbe_t probe;
+            if (h.type == TLM_FRAME_TYPE_PROBE && len == sizeof(probe)) {
+                std::memcpy(&probe, payload, sizeof(probe));
+                probed = (probe.baud == static_cast<uint32_t>(to) &&
+                          std::memcmp(probe.pattern, kPattern, sizeof(kPattern)) == 0);
+            }
+        });
+        return d;
+    };
+    auto fail = [&](const char *why) {
+        std::fprintf(stderr, "baud negotiation failed: %s %s\n", why, ack.c_str());
+        setupSerial(fd, from);
+        return false;
+    };
+
+    // 1. 请求
+    auto decoder = makeDecoder();
+    tcflush(fd, TCIFLUSH);
+    if (!writeLine(fd, "\nbaud " + std::to_string(to) + "\n")) {
+        return fail("write");
+    }
+    if (!pumpUntil(fd, *decoder, 1000, [&] { return !ack.empty(); })) {
+        return fail("no ack");
+    }
+    if (ack.find("\"status\":\"ok\"") == std::string::npos) {
+        return fail("rejected");
+    }
+
+    // 2. 切换本地波特率，等待探测帧 (切换瞬间的残缺数据丢弃)
+    tcdrain(fd);
+    if (!setupSerial(fd, to)) {
+        return fail("local baud");
+    }
+    tcflush(fd, TCIFLUSH);
+    decoder = makeDecoder();
+    if (!pumpUntil(fd, *decoder, 1000, [&] { return probed; })) {
+        return fail("no probe");
+    }
+
+    // 3. 确认
+    ack.clear();
+    if (!writeLine(fd, "\nbaud ok\n") ||
+        !pumpUntil(fd, *decoder, 500, [&] { return ack.find("\"confirmed\":1") != std::string::npos; })) {
+        return fail("no confirm");
+    }
+
+    std::fprintf(stderr, "baud rate %ld confirmed\n", to);
+    return true;
+}
+
+std::string defaultOutPath(bool columnar)
+{
+    char name[64];
+    std::time_t t = std::time(nullptr);
+    std::tm tm{};
+    localtime_r(&t, &tm);
+    std::strftime(name, sizeof(name), "tlm_%Y%m%d_%H%M%S", &tm);
+    mkdir("temp_data", 0755);
+    return std::string("temp_data/") + name + (columnar ? ".tlmc" : ".ndjson");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    const char *in_path = nullptr;
+    std::string out_path;
+    long baud = 115200;
+    long negotiate = 0;
+    bool columnar = false;
+    bool quiet = false;
+    tlm::DLogTable dlog;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+            baud = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--negotiate") == 0 && i + 1 < argc) {
+            negotiate = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            columnar = (std::strcmp(argv[++i], "col") == 0);
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (std::strcmp(argv[i], "--elf") == 0 && i + 1 < argc) {
+            std::string err;
+            if (!dlog.loadElf(argv[++i], err)) {
+                std::fprintf(stderr, "%s: %s\n", argv[i], err.c_str());
+                return 1;
+            }
+        } else {
+            in_path = argv[i];
+        }
+    }
+
+    // 1. 打开输入，串口设备设为原始模式 (协商时需要写命令)
+    int fd = STDIN_FILENO;
+    if (in_path != nullptr) {
+        fd = ::open(in_path, (negotiate != 0 ? O_RDWR : O_RDONLY) | O_NOCTTY);
+        if (fd < 0) {
+            std::perror(in_path);
+            return 1;
+        }
+    }
+    if (isatty(fd)) {
+        if (!setupSerial(fd, baud)) {
+            return 1;
+        }
+        if (negotiate != 0 && negotiateBaud(fd, baud, negotiate)) {
+            baud = negotiate;
+        }
+    } else if (negotiate != 0) {
+        std::fprintf(stderr, "--negotiate needs a serial device, ignored\n");
+    }
+
+    // 2. 打开输出
+    if (out_path.empty()) {
+        out_path = defaultOutPath(columnar);
+    }
+    std::unique_ptr<tlm::RecordWriter> writer;
+    std::string err;
+    if (columnar) {
+        auto w = std::make_unique<tlm::ColumnWriter>();
+        if (!w->open(out_path, err)) {
+            std::fprintf(stderr, "%s\n", err.c_str());
+            return 1;
+        }
+        writer = std::move(w);
+    } else {
+        auto w = std::make_unique<tlm::NdjsonWriter>();
+        if (!w->open(out_path, err)) {
+            std::fprintf(stderr, "%s\n", err.c_str());
+            return 1;
+        }
+        writer = std::move(w);
+    }
+    std::fprintf(stderr, "writing %s\n", out_path.c_str());
+
+    // 3. 解码回调: 文本行分类，数据行写入文件
+    double now = nowSec();
+    uint64_t lines = 0;
+    uint64_t records = 0;
+    uint64_t write_errors = 0;
+
+    auto store = [&](const tlm::Record &rec) {
+        records++;
+        if (!writer->write(rec)) {
+            write_errors++;
+        }
+    };
+    auto handleLine = [&](std::string_view line) {
+        tlm::Record rec;
+        lines++;
+        if (tlm::classifyLine(line, rec) == tlm::LineKind::Data) {
+            rec.pc_time_sec = now;
+            store(rec);
+        } else if (!quiet) {
+            std::fwrite(line.data(), 1, line.size(), stdout);
+            std::fputc('\n', stdout);
+        }
+    };
+
+    tlm::StreamDecoder decoder;
+    decoder.onText([&](const std::string &line) { handleLine(line); });
+    decoder.onSample([&](const tlm::Sample &s) {
+        tlm::Record rec;
+        rec.pc_time_sec = now;
+        rec.sensor = tlm::SensorId::WF5803;
+        rec.v0 = s.data.wf_temp;
+        rec.v1 = s.data.wf_press;
+        store(rec);
+        rec.sensor = tlm::SensorId::NTC;
+        rec.v0 = s.data.ntc_temp;
+        rec.v1 = 0.0f;
+        store(rec);
+        rec.sensor = tlm::SensorId::PID;
+        rec.v0 = s.data.pid_output;
+        store(rec);
+    });
+    decoder.onFrame([&](const TlmFrameHeader_t &h, const uint8_t *payload, size_t len) {
+        if (h.type != TLM_FRAME_TYPE_LOG || !dlog.loaded()) {
+            return;
+        }
+        // LOG_DEFERRED 固件的 JSON 数据行也以日志帧发送，还原后按行处理
+        std::string text = dlog.format(payload, len);
+        std::string_view rest(text);
+        while (!rest.empty()) {
+            size_t nl = rest.find('\n');
+            handleLine(rest.substr(0, nl));
+            rest = (nl == std::string_view::npos) ? std::string_view() : rest.substr(nl + 1);
+        }
+    });
+
+    // 4. 主循环，Ctrl+C 退出 (不设 SA_RESTART，read() 被信号打断后返回)
+    struct sigaction sa {};
+    sa.sa_handler = onSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    static uint8_t buf[1 << 16];
+    double start = nowSec();
+    double last_flush = start;
+    while (!g_stop) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::perror("read");
+            break;
+        }
+        if (n == 0) {
+            break;   // 文件结束
+        }
+        now = nowSec();   // 同一次 read() 的数据使用同一接收时间
+        decoder.feed(buf, static_cast<size_t>(n));
+        if (now - last_flush >= 1.0) {
+            writer->flush();
+            if (!quiet) {
+                std::fflush(stdout);
+            }
+            last_flush = now;
+        }
+    }
+
+    writer->flush();
+    double elapsed = nowSec() - start;
+    const tlm::DecoderStats &st = decoder.stats();
+    std::fprintf(stderr, "lines=%llu records=%llu frames ok=%llu bad=%llu old=%llu seq_gaps=%llu write_errors=%llu "
+                 "%.3fs (%.0f lines/s)\n",
+                 (unsigned long long)lines, (unsigned long long)records,
+                 (unsigned long long)st.frames_ok, (unsigned long long)st.frames_bad,
+                 (unsigned long long)st.frames_old, (unsigned long long)st.seq_gaps, (unsigned long long)write_errors,
+                 elapsed, elapsed > 0.0 ? static_cast<double>(lines) / elapsed : 0.0);
+
+    if (fd != STDIN_FILENO) {
+        ::close(fd);
+    }
+    return write_errors == 0 ? 0 : 1;
+}